@@ -10,13 +10,45 @@
 #define CHECKSUM_SIZE 4
 #define VERSION_BYTE_MAINNET 0x00
 #define VERSION_BYTE_TESTNET 0x6F
+#define P2SH_VERSION_BYTE_MAINNET 0x05
+#define P2SH_VERSION_BYTE_TESTNET 0xC4
+#define HASH160_BATCH_SIZE 64
+#define TAPROOT_TWEAK_TAG "TapTweak"
+#define BASE58_POW5 656356768ULL
+#define BASE58_MAX_PAYLOAD 128
+#define BASE58_MAX_LIMBS ((BASE58_MAX_PAYLOAD + 3) / 4)
+#define BASE58_MAX_ENCODED 176
+#define BASE58_ENCODED_SIZE(n) (((n) * 138) / 100 + 1)
+#define ADDRESS_PAYLOAD_SIZE 25
+#define ADDRESS_BASE58_MIN_LENGTH 25
+#define ADDRESS_BASE58_MAX_LENGTH 35
+#define ADDRESS_VALIDATE_BATCH 64
+#define ADDRESS_NETWORK_ANY -1
+#define MULTISIG_MAX_KEYS 15
+#define MULTISIG_SCRIPT_SIZE(n) (3 + (n) * (1 + COMPRESSED_PUBLIC_KEY_SIZE))
+#define MULTISIG_SCRIPT_MAX MULTISIG_SCRIPT_SIZE(MULTISIG_MAX_KEYS)
+#define OP_1 0x51
+#define OP_CHECKMULTISIG 0xAE
 
 typedef enum {
     ADDRESS_TYPE_P2PKH,
     ADDRESS_TYPE_P2SH,
-    ADDRESS_TYPE_P2WPKH
+    ADDRESS_TYPE_P2WPKH,
+    ADDRESS_TYPE_P2TR,
+    ADDRESS_TYPE_P2WSH
 } address_type_t;
 
+typedef enum {
+    ADDRESS_VALID,
+    ADDRESS_INVALID_LENGTH,
+    ADDRESS_INVALID_CHARACTER,
+    ADDRESS_INVALID_ENCODING,
+    ADDRESS_INVALID_CHECKSUM,
+    ADDRESS_INVALID_VERSION,
+    ADDRESS_INVALID_PROGRAM,
+    ADDRESS_INVALID_NETWORK
+} address_status_t;
+
 typedef struct {
     uint8_t version;
     uint8_t payload[20];
@@ -24,12 +56,28 @@ typedef struct {
 } address_data_t;
 
 int base58_encode(const uint8_t *data, size_t data_len, char *output, size_t output_size);
+int base58_encode_batch(const uint8_t *data, size_t data_len, size_t count, char *output, size_t output_stride);
 int base58_decode(const char *input, uint8_t *output, size_t output_size);
+int base58check_encode(const uint8_t *payload, size_t payload_len, char *output, size_t output_size);
+int base58check_decode(const char *input, uint8_t *payload, size_t payload_size);
 int calculate_checksum(const uint8_t *data, size_t data_len, uint8_t *checksum);
 int verify_checksum(const uint8_t *data, size_t data_len, const uint8_t *checksum);
 int create_p2pkh_address(const public_key_t *public_key, bitcoin_address_t *address);
+int create_p2pkh_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count, int testnet);
 int create_p2sh_address(const public_key_t *public_key, bitcoin_address_t *address);
+int create_p2sh_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count, int testnet);
+int create_p2wpkh_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count);
+int create_p2tr_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count);
+int multisig_script(const uint8_t *public_keys, size_t keys, size_t threshold, uint8_t *script, size_t script_size);
+int create_multisig_addresses(const uint8_t *public_keys, size_t keys, size_t threshold, bitcoin_address_t *addresses,
+                              size_t count, address_type_t type, int testnet);
+int create_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count, address_type_t type, int testnet);
+int encode_address(const bitcoin_address_t *address, address_type_t type, int testnet, char *output, size_t output_size);
+int encode_addresses(const bitcoin_address_t *addresses, size_t count, address_type_t type, int testnet, char *output, size_t output_stride);
 int validate_bitcoin_address(const char *address);
+int address_validate_batch(const char *const *addresses, size_t count, int network, address_status_t *statuses);
+const char *address_status_string(address_status_t status);
+int address_decode(const char *address, address_type_t *type, int *testnet, uint8_t *program, size_t *program_len);
 int address_to_bytes(const char *address, address_data_t *data);
 
 #endif 
\ No newline at end of file
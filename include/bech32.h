@@ -0,0 +1,37 @@
+#ifndef BECH32_H
+#define BECH32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BECH32_CHARSET "qpzry9x8gf2tvdw0s3jn54khce6mua7l"
+#define BECH32_MAX_LENGTH 90
+#define BECH32_CHECKSUM_LENGTH 6
+#define BECH32_CONST 1
+#define BECH32M_CONST 0x2bc830a3
+#define SEGWIT_HRP_MAINNET "bc"
+#define SEGWIT_HRP_TESTNET "tb"
+#define SEGWIT_MAX_PROGRAM 40
+#define SEGWIT_MAX_HRP 84
+
+typedef enum {
+    SEGWIT_VALID,
+    SEGWIT_INVALID_LENGTH,
+    SEGWIT_INVALID_FORMAT,
+    SEGWIT_INVALID_CHARACTER,
+    SEGWIT_INVALID_CHECKSUM,
+    SEGWIT_INVALID_VERSION,
+    SEGWIT_INVALID_PADDING,
+    SEGWIT_INVALID_PROGRAM
+} segwit_status_t;
+
+int segwit_address_encode(const char *hrp, int witness_version, const uint8_t *program, size_t program_len,
+                          char *output, size_t output_size);
+int segwit_address_encode_batch(const char *hrp, int witness_version, const uint8_t *programs, size_t program_len,
+                                size_t program_stride, size_t count, char *output, size_t output_stride);
+segwit_status_t segwit_address_check(const char *address, char *hrp, size_t hrp_size, int *witness_version,
+                                     uint8_t *program, size_t *program_len);
+int segwit_address_decode(const char *address, char *hrp, size_t hrp_size, int *witness_version,
+                          uint8_t *program, size_t *program_len);
+
+#endif
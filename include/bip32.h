@@ -0,0 +1,43 @@
+#ifndef BIP32_H
+#define BIP32_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto.h"
+
+#define BIP32_CHAIN_CODE_SIZE 32
+#define BIP32_SERIALIZED_SIZE 78
+#define BIP32_XKEY_STRING_SIZE 112
+#define BIP32_HARDENED 0x80000000U
+#define BIP32_MAX_PATH_DEPTH 255
+#define BIP32_MAX_PATH_STRING 2048
+#define BIP32_BATCH_SIZE 256
+#define BIP32_SEED_KEY "Bitcoin seed"
+#define BIP32_VERSION_XPRV 0x0488ADE4U
+#define BIP32_VERSION_XPUB 0x0488B21EU
+#define BIP32_VERSION_TPRV 0x04358394U
+#define BIP32_VERSION_TPUB 0x043587CFU
+
+typedef struct {
+    uint8_t chain_code[BIP32_CHAIN_CODE_SIZE];
+    private_key_t private_key;
+    uint8_t public_key[COMPRESSED_PUBLIC_KEY_SIZE];
+    uint8_t parent_fingerprint[4];
+    uint32_t child_number;
+    uint8_t depth;
+    int has_private;
+    int testnet;
+} bip32_node_t;
+
+int bip32_from_seed(const uint8_t *seed, size_t seed_len, int testnet, bip32_node_t *node);
+int bip32_parse(const char *xkey, bip32_node_t *node);
+int bip32_serialize(const bip32_node_t *node, int private, char *output, size_t output_size);
+int bip32_neuter(const bip32_node_t *node, bip32_node_t *public_node);
+int bip32_derive_child(const bip32_node_t *parent, uint32_t index, bip32_node_t *child);
+int bip32_derive_children(const bip32_node_t *parent, uint32_t start, size_t count, bip32_node_t *children);
+int bip32_parse_path(const char *path, uint32_t *indices, size_t max_indices, size_t *count);
+int bip32_format_path(const uint32_t *indices, size_t count, char *output, size_t output_size);
+int bip32_derive_path(const bip32_node_t *root, const uint32_t *indices, size_t count, bip32_node_t *node);
+void bip32_node_wipe(bip32_node_t *node);
+
+#endif
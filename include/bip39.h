@@ -0,0 +1,27 @@
+#ifndef BIP39_H
+#define BIP39_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BIP39_WORD_COUNT 2048
+#define BIP39_MIN_WORDS 12
+#define BIP39_MAX_WORDS 24
+#define BIP39_DEFAULT_WORDS 12
+#define BIP39_MAX_WORD_LENGTH 8
+#define BIP39_MIN_ENTROPY 16
+#define BIP39_MAX_ENTROPY 32
+#define BIP39_MNEMONIC_SIZE (BIP39_MAX_WORDS * (BIP39_MAX_WORD_LENGTH + 1))
+#define BIP39_SEED_SIZE 64
+#define BIP39_PBKDF2_ROUNDS 2048
+#define BIP39_SALT_PREFIX "mnemonic"
+
+int bip39_generate_mnemonic(size_t words, char *mnemonic, size_t mnemonic_size);
+int bip39_mnemonic_from_entropy(const uint8_t *entropy, size_t entropy_length, char *mnemonic, size_t mnemonic_size);
+int bip39_mnemonic_to_entropy(const char *mnemonic, uint8_t *entropy, size_t *entropy_length);
+int bip39_validate_mnemonic(const char *mnemonic);
+int bip39_normalize_mnemonic(const char *mnemonic, char *output, size_t output_size);
+int bip39_mnemonic_to_seed(const char *mnemonic, const char *passphrase, uint8_t *seed);
+int bip39_mnemonic_to_seed_batch(const char *const *mnemonics, const char *passphrase, size_t count, uint8_t *seeds);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdbool.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_X86 1
+#endif
+#if defined(__x86_64__)
+#define CPU_X86_64 1
+#endif
+
+typedef enum {
+    CPU_FEATURE_SSE41,
+    CPU_FEATURE_SSSE3,
+    CPU_FEATURE_AVX2,
+    CPU_FEATURE_AVX512F,
+    CPU_FEATURE_AVX512BW,
+    CPU_FEATURE_SHA,
+    CPU_FEATURE_BMI2,
+    CPU_FEATURE_ADX,
+    CPU_FEATURE_COUNT
+} cpu_feature_t;
+
+bool cpu_has(cpu_feature_t feature);
+const char *cpu_feature_name(cpu_feature_t feature);
+
+#endif
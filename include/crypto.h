@@ -8,7 +8,11 @@
 #define PUBLIC_KEY_SIZE 65
 #define COMPRESSED_PUBLIC_KEY_SIZE 33
 #define ADDRESS_SIZE 34
-#define WIF_SIZE 52
+#define WIF_SIZE 53
+#define WIF_PAYLOAD_SIZE 33
+#define WIF_PAYLOAD_COMPRESSED_SIZE 34
+#define WIF_VERSION_MAINNET 0x80
+#define WIF_VERSION_TESTNET 0xEF
 
 typedef struct {
     uint8_t data[PRIVATE_KEY_SIZE];
@@ -24,13 +28,19 @@ typedef struct {
     size_t length;
 } bitcoin_address_t;
 
+int crypto_configure(unsigned int table_bits, const char *table_path);
 int crypto_init(void);
 void crypto_cleanup(void);
 int generate_secure_private_key(private_key_t *key);
+int generate_secure_private_keys(private_key_t *keys, size_t count);
 int validate_private_key(const private_key_t *key);
 int derive_public_key(const private_key_t *private_key, public_key_t *public_key);
 int derive_compressed_public_key(const private_key_t *private_key, public_key_t *public_key);
+int derive_public_keys_batch(const private_key_t *private_keys, public_key_t *public_keys, size_t count, int compressed);
+int public_key_tweak_mul(const public_key_t *public_key, const uint8_t *tweak, public_key_t *result);
 int generate_bitcoin_address(const public_key_t *public_key, bitcoin_address_t *address);
+int encode_wif(const private_key_t *key, int compressed, int testnet, char *wif, size_t wif_size);
+int wif_decode(const char *wif, private_key_t *key, int *compressed, int *testnet);
 int private_key_to_wif(const private_key_t *key, char *wif, size_t wif_size);
 int wif_to_private_key(const char *wif, private_key_t *key);
 void secure_zero_memory(void *ptr, size_t size);
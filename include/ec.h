@@ -0,0 +1,49 @@
+#ifndef EC_H
+#define EC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define EC_SCALAR_SIZE 32
+#define EC_DEFAULT_TABLE_BITS 6
+#define EC_MIN_TABLE_BITS 2
+#define EC_MAX_TABLE_BITS 8
+#define EC_BATCH_SIZE 256
+
+typedef enum {
+    EC_FIELD_AUTO,
+    EC_FIELD_10X26,
+    EC_FIELD_5X52,
+    EC_FIELD_MULX,
+    EC_FIELD_COUNT
+} ec_field_t;
+
+typedef struct {
+    uint64_t x[4];
+    uint64_t y[4];
+} ec_storage_t;
+
+typedef struct {
+    uint64_t x[4];
+    uint64_t y[4];
+    int infinity;
+} ec_point_t;
+
+int ec_field_select(ec_field_t field);
+ec_field_t ec_field_active(void);
+const char *ec_field_name(ec_field_t field);
+int ec_field_supported(ec_field_t field);
+int ec_context_init(unsigned int table_bits, const char *table_path);
+void ec_context_cleanup(void);
+unsigned int ec_table_bits(void);
+int ec_mult_gen(ec_point_t *result, const uint8_t *scalar);
+int ec_mult_gen_batch(ec_point_t *results, const uint8_t *scalars, size_t count);
+int ec_field_inv_batch(uint64_t *limbs, size_t count);
+int ec_point_tweak_add_batch(ec_point_t *points, const uint8_t *tweaks, size_t count);
+int ec_mult(ec_point_t *result, const ec_point_t *point, const uint8_t *scalar);
+int ec_mult_multi(ec_point_t *result, const ec_point_t *points, const uint8_t *scalars, size_t count,
+                  const uint8_t *gen_scalar);
+int ec_point_parse(ec_point_t *point, const uint8_t *input, size_t input_len);
+int ec_point_serialize(const ec_point_t *point, uint8_t *output, size_t *output_len, int compressed);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef EC_BACKEND_H
+#define EC_BACKEND_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ec.h"
+
+#define EC_WNAF_WINDOW 5
+#define EC_GEN_WNAF_WINDOW 8
+#define EC_WNAF_BITS 130
+#define EC_WNAF_ENTRIES(w) (1U << ((w) - 2))
+#define EC_STRAUSS_POINTS 16
+#define EC_PIPPENGER_POINTS 128
+#define EC_PIPPENGER_MAX_WINDOW 12
+
+typedef struct {
+    const ec_storage_t *entries;
+    const ec_storage_t *odd;
+    unsigned int bits;
+    unsigned int windows;
+} ec_gen_table_t;
+
+typedef struct {
+    int (*build_gen_table)(ec_storage_t *table, unsigned int bits, unsigned int windows);
+    int (*build_odd_table)(ec_storage_t *table, unsigned int entries);
+    int (*mult_gen_batch)(const ec_gen_table_t *table, ec_point_t *results, const uint8_t *scalars, size_t count);
+    int (*tweak_add_batch)(const ec_gen_table_t *table, ec_point_t *points, const uint8_t *tweaks, size_t count);
+    int (*mult_multi)(const ec_gen_table_t *table, ec_point_t *result, const ec_point_t *points,
+                      const uint8_t *scalars, size_t count, const uint8_t *gen_scalar);
+    int (*field_inv_batch)(uint64_t *limbs, size_t count);
+    int (*point_parse)(ec_point_t *point, const uint8_t *input, size_t input_len);
+} ec_backend_t;
+
+extern const ec_backend_t ec_backend_10x26;
+extern const ec_backend_t ec_backend_5x52;
+extern const ec_backend_t ec_backend_mulx;
+
+#endif
@@ -0,0 +1,951 @@
+#ifndef EC_IMPL_H
+#define EC_IMPL_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "ec_backend.h"
+#include "scalar.h"
+
+typedef struct {
+    fe_t x;
+    fe_t y;
+    int infinity;
+} ge_t;
+
+typedef struct {
+    fe_t x;
+    fe_t y;
+    fe_t z;
+    int infinity;
+} gej_t;
+
+
+static const uint64_t generator_x[4] = {
+    0x59F2815B16F81798ULL, 0x029BFCDB2DCE28D9ULL, 0x55A06295CE870B07ULL, 0x79BE667EF9DCBBACULL
+};
+
+static const uint64_t generator_y[4] = {
+    0x9C47D08FFB10D4B8ULL, 0xFD17B448A6855419ULL, 0x5DA4FBFC0E1108A8ULL, 0x483ADA7726A3C465ULL
+};
+
+static const uint64_t nums_x[4] = {
+    0x47BFEE9ACE803AC0ULL, 0x078A5A0F28EC96D5ULL, 0xB78B4B6035E97A5EULL, 0x50929B74C1A04954ULL
+};
+
+static const uint64_t beta_limbs[4] = {
+    0xC1396C28719501EEULL, 0x9CF0497512F58995ULL, 0x6E64479EAC3434E9ULL, 0x7AE96A2B657C0710ULL
+};
+
+static void fe_sqr_n(fe_t *r, const fe_t *a, int n) {
+    fe_sqr(r, a);
+    while (--n > 0) {
+        fe_sqr(r, r);
+    }
+}
+
+static void fe_pow_chain(fe_t *x2, fe_t *x3, fe_t *x22, fe_t *x223, const fe_t *a) {
+    fe_t x6, x9, x11, x44, x88, x176, x220;
+
+    fe_sqr(x2, a);
+    fe_mul(x2, x2, a);
+    fe_sqr(x3, x2);
+    fe_mul(x3, x3, a);
+    fe_sqr_n(&x6, x3, 3);
+    fe_mul(&x6, &x6, x3);
+    fe_sqr_n(&x9, &x6, 3);
+    fe_mul(&x9, &x9, x3);
+    fe_sqr_n(&x11, &x9, 2);
+    fe_mul(&x11, &x11, x2);
+    fe_sqr_n(x22, &x11, 11);
+    fe_mul(x22, x22, &x11);
+    fe_sqr_n(&x44, x22, 22);
+    fe_mul(&x44, &x44, x22);
+    fe_sqr_n(&x88, &x44, 44);
+    fe_mul(&x88, &x88, &x44);
+    fe_sqr_n(&x176, &x88, 88);
+    fe_mul(&x176, &x176, &x88);
+    fe_sqr_n(&x220, &x176, 44);
+    fe_mul(&x220, &x220, &x44);
+    fe_sqr_n(x223, &x220, 3);
+    fe_mul(x223, x223, x3);
+}
+
+static void fe_inv(fe_t *r, const fe_t *a) {
+    fe_t x2, x3, x22, x223, t;
+
+    fe_pow_chain(&x2, &x3, &x22, &x223, a);
+    fe_sqr_n(&t, &x223, 23);
+    fe_mul(&t, &t, &x22);
+    fe_sqr_n(&t, &t, 5);
+    fe_mul(&t, &t, a);
+    fe_sqr_n(&t, &t, 3);
+    fe_mul(&t, &t, &x2);
+    fe_sqr_n(&t, &t, 2);
+    fe_mul(r, &t, a);
+}
+
+static int fe_sqrt(fe_t *r, const fe_t *a) {
+    fe_t x2, x3, x22, x223, t, check;
+
+    fe_pow_chain(&x2, &x3, &x22, &x223, a);
+    fe_sqr_n(&t, &x223, 23);
+    fe_mul(&t, &t, &x22);
+    fe_sqr_n(&t, &t, 6);
+    fe_mul(&t, &t, &x2);
+    fe_sqr_n(&t, &t, 2);
+
+    fe_sqr(&check, &t);
+    fe_negate(&check, &check, 1);
+    fe_add(&check, a);
+    *r = t;
+    return fe_normalizes_to_zero(&check) ? 0 : -1;
+}
+
+static void ge_set_xy(ge_t *r, const fe_t *x, const fe_t *y) {
+    r->x = *x;
+    r->y = *y;
+    r->infinity = 0;
+}
+
+static int ge_set_xo(ge_t *r, const fe_t *x, int odd) {
+    fe_t x3, c;
+
+    fe_sqr(&x3, x);
+    fe_mul(&x3, &x3, x);
+    fe_set_int(&c, 7);
+    fe_add(&x3, &c);
+    r->x = *x;
+    if (fe_sqrt(&r->y, &x3) != 0) {
+        return -1;
+    }
+    fe_normalize(&r->x);
+    fe_normalize(&r->y);
+    if (fe_is_odd(&r->y) != odd) {
+        fe_negate(&r->y, &r->y, 1);
+        fe_normalize(&r->y);
+    }
+    r->infinity = 0;
+    return 0;
+}
+
+static void ge_to_storage(ec_storage_t *r, const ge_t *a) {
+    fe_get_limbs(r->x, &a->x);
+    fe_get_limbs(r->y, &a->y);
+}
+
+static void ge_from_storage(ge_t *r, const ec_storage_t *a) {
+    fe_set_limbs(&r->x, a->x);
+    fe_set_limbs(&r->y, a->y);
+    r->infinity = 0;
+}
+
+static void gej_set_ge(gej_t *r, const ge_t *a) {
+    r->x = a->x;
+    r->y = a->y;
+    fe_set_int(&r->z, 1);
+    r->infinity = a->infinity;
+}
+
+static void gej_neg(gej_t *r, const gej_t *a) {
+    r->x = a->x;
+    r->z = a->z;
+    r->infinity = a->infinity;
+    fe_negate(&r->y, &a->y, 1);
+    fe_normalize_weak(&r->y);
+}
+
+static void ge_set_gej(ge_t *r, const gej_t *a) {
+    fe_t zi, zi2, zi3;
+
+    if (a->infinity) {
+        r->infinity = 1;
+        return;
+    }
+    fe_inv(&zi, &a->z);
+    fe_sqr(&zi2, &zi);
+    fe_mul(&zi3, &zi2, &zi);
+    fe_mul(&r->x, &a->x, &zi2);
+    fe_mul(&r->y, &a->y, &zi3);
+    fe_normalize(&r->x);
+    fe_normalize(&r->y);
+    r->infinity = 0;
+}
+
+static void ge_set_all_gej(ge_t *r, const gej_t *a, size_t n) {
+    fe_t prefix[EC_BATCH_SIZE];
+    fe_t running, inv, zi, zi2, zi3;
+
+    fe_set_int(&running, 1);
+    for (size_t i = 0; i < n; i++) {
+        prefix[i] = running;
+        if (!a[i].infinity) {
+            fe_mul(&running, &running, &a[i].z);
+        }
+    }
+
+    fe_inv(&inv, &running);
+
+    for (size_t i = n; i-- > 0;) {
+        if (a[i].infinity) {
+            r[i].infinity = 1;
+            continue;
+        }
+        fe_mul(&zi, &prefix[i], &inv);
+        fe_mul(&inv, &inv, &a[i].z);
+        fe_sqr(&zi2, &zi);
+        fe_mul(&zi3, &zi2, &zi);
+        fe_mul(&r[i].x, &a[i].x, &zi2);
+        fe_mul(&r[i].y, &a[i].y, &zi3);
+        fe_normalize(&r[i].x);
+        fe_normalize(&r[i].y);
+        r[i].infinity = 0;
+    }
+}
+
+static void gej_double(gej_t *r, const gej_t *a) {
+    fe_t a2, b, c, d, e, f, t;
+
+    if (a->infinity) {
+        r->infinity = 1;
+        return;
+    }
+    fe_mul(&r->z, &a->y, &a->z);
+    fe_mul_int(&r->z, 2);
+    fe_normalize_weak(&r->z);
+
+    fe_sqr(&a2, &a->x);
+    fe_sqr(&b, &a->y);
+    fe_sqr(&c, &b);
+
+    d = a->x;
+    fe_add(&d, &b);
+    fe_sqr(&d, &d);
+    fe_negate(&t, &a2, 1);
+    fe_add(&d, &t);
+    fe_negate(&t, &c, 1);
+    fe_add(&d, &t);
+    fe_normalize_weak(&d);
+    fe_mul_int(&d, 2);
+
+    e = a2;
+    fe_mul_int(&e, 3);
+    fe_sqr(&f, &e);
+
+    fe_negate(&t, &d, 2);
+    fe_mul_int(&t, 2);
+    r->x = f;
+    fe_add(&r->x, &t);
+    fe_normalize_weak(&r->x);
+
+    fe_negate(&t, &r->x, 1);
+    fe_add(&t, &d);
+    fe_mul(&r->y, &e, &t);
+    fe_negate(&t, &c, 1);
+    fe_mul_int(&t, 8);
+    fe_add(&r->y, &t);
+    fe_normalize_weak(&r->y);
+
+    r->infinity = 0;
+}
+
+static void gej_add_ge(gej_t *r, const gej_t *a, const ge_t *b) {
+    fe_t z12, u2, s2, h, rr, hh, hhh, v, t;
+
+    if (b->infinity) {
+        *r = *a;
+        return;
+    }
+    if (a->infinity) {
+        gej_set_ge(r, b);
+        return;
+    }
+
+    fe_sqr(&z12, &a->z);
+    fe_mul(&u2, &b->x, &z12);
+    fe_mul(&s2, &b->y, &z12);
+    fe_mul(&s2, &s2, &a->z);
+
+    fe_negate(&h, &a->x, 1);
+    fe_add(&h, &u2);
+    fe_negate(&rr, &a->y, 1);
+    fe_add(&rr, &s2);
+
+    if (fe_normalizes_to_zero(&h)) {
+        if (fe_normalizes_to_zero(&rr)) {
+            gej_double(r, a);
+        } else {
+            r->infinity = 1;
+        }
+        return;
+    }
+
+    fe_sqr(&hh, &h);
+    fe_mul(&hhh, &h, &hh);
+    fe_mul(&v, &a->x, &hh);
+    fe_mul(&r->z, &a->z, &h);
+
+    fe_sqr(&r->x, &rr);
+    fe_negate(&t, &hhh, 1);
+    fe_add(&r->x, &t);
+    fe_negate(&t, &v, 1);
+    fe_mul_int(&t, 2);
+    fe_add(&r->x, &t);
+    fe_normalize_weak(&r->x);
+
+    fe_negate(&t, &r->x, 1);
+    fe_add(&t, &v);
+    fe_mul(&v, &rr, &t);
+    fe_mul(&t, &a->y, &hhh);
+    fe_negate(&t, &t, 1);
+    fe_add(&v, &t);
+    fe_normalize_weak(&v);
+    r->y = v;
+
+    r->infinity = 0;
+}
+
+static void gej_add_var(gej_t *r, const gej_t *a, const gej_t *b) {
+    fe_t z12, z22, u1, u2, s1, s2, h, rr, hh, hhh, v, t;
+
+    if (b->infinity) {
+        *r = *a;
+        return;
+    }
+    if (a->infinity) {
+        *r = *b;
+        return;
+    }
+
+    fe_sqr(&z12, &a->z);
+    fe_sqr(&z22, &b->z);
+    fe_mul(&u1, &a->x, &z22);
+    fe_mul(&u2, &b->x, &z12);
+    fe_mul(&s1, &a->y, &z22);
+    fe_mul(&s1, &s1, &b->z);
+    fe_mul(&s2, &b->y, &z12);
+    fe_mul(&s2, &s2, &a->z);
+
+    fe_negate(&h, &u1, 1);
+    fe_add(&h, &u2);
+    fe_negate(&rr, &s1, 1);
+    fe_add(&rr, &s2);
+
+    if (fe_normalizes_to_zero(&h)) {
+        if (fe_normalizes_to_zero(&rr)) {
+            gej_double(r, a);
+        } else {
+            r->infinity = 1;
+        }
+        return;
+    }
+
+    fe_sqr(&hh, &h);
+    fe_mul(&hhh, &h, &hh);
+    fe_mul(&v, &u1, &hh);
+    fe_mul(&r->z, &a->z, &b->z);
+    fe_mul(&r->z, &r->z, &h);
+
+    fe_sqr(&r->x, &rr);
+    fe_negate(&t, &hhh, 1);
+    fe_add(&r->x, &t);
+    fe_negate(&t, &v, 1);
+    fe_mul_int(&t, 2);
+    fe_add(&r->x, &t);
+    fe_normalize_weak(&r->x);
+
+    fe_negate(&t, &r->x, 1);
+    fe_add(&t, &v);
+    fe_mul(&v, &rr, &t);
+    fe_mul(&t, &s1, &hhh);
+    fe_negate(&t, &t, 1);
+    fe_add(&v, &t);
+    fe_normalize_weak(&v);
+    r->y = v;
+
+    r->infinity = 0;
+}
+
+static void gej_add(gej_t *r, const gej_t *a, const gej_t *b) {
+    ge_t bb;
+
+    if (b->infinity) {
+        *r = *a;
+        return;
+    }
+    ge_set_gej(&bb, b);
+    gej_add_ge(r, a, &bb);
+}
+
+static unsigned int scalar_window(const uint64_t *limbs, unsigned int offset, unsigned int bits) {
+    unsigned int limb = offset >> 6;
+    unsigned int shift = offset & 63;
+    uint64_t v;
+
+    if (limb >= 4) return 0;
+    v = limbs[limb] >> shift;
+    if (shift + bits > 64 && limb + 1 < 4) {
+        v |= limbs[limb + 1] << (64 - shift);
+    }
+    return (unsigned int)(v & ((1ULL << bits) - 1));
+}
+
+static void table_lookup(ge_t *r, const ec_storage_t *row, unsigned int entries, unsigned int index) {
+    ec_storage_t s;
+
+    memset(&s, 0, sizeof(s));
+    for (unsigned int i = 0; i < entries; i++) {
+        uint64_t mask = (uint64_t)0 - (uint64_t)(i == index);
+        for (int k = 0; k < 4; k++) {
+            s.x[k] |= row[i].x[k] & mask;
+            s.y[k] |= row[i].y[k] & mask;
+        }
+    }
+    ge_from_storage(r, &s);
+}
+
+static void scalar_to_limbs(uint64_t *limbs, const uint8_t *scalar) {
+    for (int i = 0; i < 4; i++) {
+        const uint8_t *p = scalar + (3 - i) * 8;
+        limbs[i] = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) |
+                   ((uint64_t)p[3] << 32) | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+                   ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+    }
+}
+
+static void ecmult_gen_jacobian(const ec_gen_table_t *table, gej_t *r, const uint8_t *scalar) {
+    uint64_t limbs[4];
+    unsigned int entries = 1U << table->bits;
+    ge_t add;
+
+    scalar_to_limbs(limbs, scalar);
+    table_lookup(&add, table->entries, entries, scalar_window(limbs, 0, table->bits));
+    gej_set_ge(r, &add);
+    for (unsigned int j = 1; j < table->windows; j++) {
+        unsigned int digit = scalar_window(limbs, j * table->bits, table->bits);
+        table_lookup(&add, table->entries + (size_t)j * entries, entries, digit);
+        gej_add_ge(r, r, &add);
+    }
+    memset(limbs, 0, sizeof(limbs));
+    memset(&add, 0, sizeof(add));
+}
+
+static int build_gen_table(ec_storage_t *table, unsigned int bits, unsigned int windows) {
+    unsigned int entries = 1U << bits;
+    fe_t gx, gy, hx;
+    ge_t base, nums;
+    gej_t basej, numsj, offset, offset_sum;
+    gej_t points[1U << EC_MAX_TABLE_BITS];
+    ge_t row[1U << EC_MAX_TABLE_BITS];
+
+    fe_set_limbs(&gx, generator_x);
+    fe_set_limbs(&gy, generator_y);
+    ge_set_xy(&base, &gx, &gy);
+    fe_set_limbs(&hx, nums_x);
+    if (ge_set_xo(&nums, &hx, 0) != 0) {
+        return -1;
+    }
+    gej_set_ge(&numsj, &nums);
+    offset_sum.infinity = 1;
+
+    for (unsigned int j = 0; j < windows; j++) {
+        if (j + 1 < windows) {
+            offset = numsj;
+            gej_add(&offset_sum, &offset_sum, &offset);
+            gej_double(&numsj, &numsj);
+        } else {
+            gej_neg(&offset, &offset_sum);
+        }
+
+        points[0] = offset;
+        for (unsigned int i = 1; i < entries; i++) {
+            gej_add_ge(&points[i], &points[i - 1], &base);
+        }
+        ge_set_all_gej(row, points, entries);
+        for (unsigned int i = 0; i < entries; i++) {
+            if (row[i].infinity) {
+                return -1;
+            }
+            ge_to_storage(&table[(size_t)j * entries + i], &row[i]);
+        }
+
+        gej_set_ge(&basej, &base);
+        for (unsigned int b = 0; b < bits; b++) {
+            gej_double(&basej, &basej);
+        }
+        ge_set_gej(&base, &basej);
+    }
+
+    return 0;
+}
+
+static int mult_gen_batch(const ec_gen_table_t *table, ec_point_t *results, const uint8_t *scalars, size_t count) {
+    gej_t rj[EC_BATCH_SIZE];
+    ge_t r[EC_BATCH_SIZE];
+
+    for (size_t base = 0; base < count; base += EC_BATCH_SIZE) {
+        size_t n = count - base < EC_BATCH_SIZE ? count - base : EC_BATCH_SIZE;
+
+        for (size_t i = 0; i < n; i++) {
+            ecmult_gen_jacobian(table, &rj[i], scalars + (base + i) * EC_SCALAR_SIZE);
+        }
+        ge_set_all_gej(r, rj, n);
+
+        for (size_t i = 0; i < n; i++) {
+            ec_point_t *out = &results[base + i];
+            out->infinity = r[i].infinity;
+            if (!r[i].infinity) {
+                fe_get_limbs(out->x, &r[i].x);
+                fe_get_limbs(out->y, &r[i].y);
+            }
+        }
+    }
+
+    memset(rj, 0, sizeof(rj));
+    return 0;
+}
+
+static int field_inv_batch(uint64_t *limbs, size_t count) {
+    fe_t values[EC_BATCH_SIZE];
+    fe_t prefix[EC_BATCH_SIZE];
+    fe_t running, inv, t;
+
+    for (size_t base = 0; base < count; base += EC_BATCH_SIZE) {
+        size_t n = count - base < EC_BATCH_SIZE ? count - base : EC_BATCH_SIZE;
+        uint64_t *chunk = limbs + base * 4;
+
+        fe_set_int(&running, 1);
+        for (size_t i = 0; i < n; i++) {
+            fe_set_limbs(&values[i], chunk + i * 4);
+            if (fe_normalizes_to_zero(&values[i])) return -1;
+            prefix[i] = running;
+            fe_mul(&running, &running, &values[i]);
+        }
+
+        fe_inv(&inv, &running);
+
+        for (size_t i = n; i-- > 0;) {
+            fe_mul(&t, &prefix[i], &inv);
+            fe_mul(&inv, &inv, &values[i]);
+            fe_normalize(&t);
+            fe_get_limbs(chunk + i * 4, &t);
+        }
+    }
+
+    return 0;
+}
+
+static int tweak_add_batch(const ec_gen_table_t *table, ec_point_t *points, const uint8_t *tweaks, size_t count) {
+    gej_t rj[EC_BATCH_SIZE];
+    ge_t r[EC_BATCH_SIZE];
+    int result = 0;
+
+    for (size_t base = 0; base < count; base += EC_BATCH_SIZE) {
+        size_t n = count - base < EC_BATCH_SIZE ? count - base : EC_BATCH_SIZE;
+
+        for (size_t i = 0; i < n; i++) {
+            const ec_point_t *p = &points[base + i];
+            ge_t pg;
+
+            ecmult_gen_jacobian(table, &rj[i], tweaks + (base + i) * EC_SCALAR_SIZE);
+            if (p->infinity) continue;
+            fe_set_limbs(&pg.x, p->x);
+            fe_set_limbs(&pg.y, p->y);
+            pg.infinity = 0;
+            gej_add_ge(&rj[i], &rj[i], &pg);
+        }
+        ge_set_all_gej(r, rj, n);
+
+        for (size_t i = 0; i < n; i++) {
+            ec_point_t *out = &points[base + i];
+            out->infinity = r[i].infinity;
+            if (r[i].infinity) {
+                result = -1;
+                continue;
+            }
+            fe_get_limbs(out->x, &r[i].x);
+            fe_get_limbs(out->y, &r[i].y);
+        }
+    }
+
+    memset(rj, 0, sizeof(rj));
+    return result;
+}
+
+static int bytes_to_field_limbs(uint64_t *limbs, const uint8_t *in) {
+    for (int i = 0; i < 4; i++) {
+        const uint8_t *p = in + (3 - i) * 8;
+        limbs[i] = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) |
+                   ((uint64_t)p[3] << 32) | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+                   ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+    }
+    if (limbs[3] == ~0ULL && limbs[2] == ~0ULL && limbs[1] == ~0ULL && limbs[0] >= 0xFFFFFFFEFFFFFC2FULL) {
+        return -1;
+    }
+    return 0;
+}
+
+static int point_parse(ec_point_t *point, const uint8_t *input, size_t input_len) {
+    uint64_t limbs[4];
+    fe_t x, y, lhs, rhs, c;
+    ge_t r;
+
+    if (input_len == 32 || (input_len == 33 && (input[0] == 0x02 || input[0] == 0x03))) {
+        const uint8_t *xb = input_len == 33 ? input + 1 : input;
+        if (bytes_to_field_limbs(limbs, xb) != 0) return -1;
+        fe_set_limbs(&x, limbs);
+        if (ge_set_xo(&r, &x, input_len == 33 && input[0] == 0x03) != 0) return -1;
+    } else if (input_len == 65 && input[0] == 0x04) {
+        if (bytes_to_field_limbs(limbs, input + 1) != 0) return -1;
+        fe_set_limbs(&x, limbs);
+        if (bytes_to_field_limbs(limbs, input + 33) != 0) return -1;
+        fe_set_limbs(&y, limbs);
+        fe_sqr(&lhs, &y);
+        fe_sqr(&rhs, &x);
+        fe_mul(&rhs, &rhs, &x);
+        fe_set_int(&c, 7);
+        fe_add(&rhs, &c);
+        fe_negate(&lhs, &lhs, 1);
+        fe_add(&lhs, &rhs);
+        if (!fe_normalizes_to_zero(&lhs)) return -1;
+        ge_set_xy(&r, &x, &y);
+    } else {
+        return -1;
+    }
+
+    fe_get_limbs(point->x, &r.x);
+    fe_get_limbs(point->y, &r.y);
+    point->infinity = 0;
+    return 0;
+}
+
+static void ge_mul_lambda(ge_t *r, const ge_t *a, const fe_t *beta) {
+    r->y = a->y;
+    r->infinity = a->infinity;
+    fe_mul(&r->x, &a->x, beta);
+    fe_normalize(&r->x);
+}
+
+static void wnaf_entry(ge_t *r, const ge_t *table, int digit) {
+    *r = table[((digit < 0 ? -digit : digit) - 1) / 2];
+    if (digit < 0) {
+        fe_negate(&r->y, &r->y, 1);
+        fe_normalize_weak(&r->y);
+    }
+}
+
+static void wnaf_gen_entry(ge_t *r, const ec_storage_t *table, int digit) {
+    ge_from_storage(r, &table[((digit < 0 ? -digit : digit) - 1) / 2]);
+    if (digit < 0) {
+        fe_negate(&r->y, &r->y, 1);
+        fe_normalize_weak(&r->y);
+    }
+}
+
+static int scalar_wnaf(int *wnaf, const scalar_t *s, unsigned int w) {
+    scalar_t t = *s;
+    int sign = 1;
+    int carry = 0;
+    int last = -1;
+    unsigned int bit = 0;
+
+    if (scalar_is_high(&t)) {
+        scalar_negate(&t, &t);
+        sign = -1;
+    }
+
+    memset(wnaf, 0, sizeof(int) * EC_WNAF_BITS);
+    while (bit < EC_WNAF_BITS) {
+        if ((int)scalar_window(t.d, bit, 1) == carry) {
+            bit++;
+            continue;
+        }
+        unsigned int now = w < EC_WNAF_BITS - bit ? w : EC_WNAF_BITS - bit;
+        int word = (int)scalar_window(t.d, bit, now) + carry;
+        carry = (word >> (w - 1)) & 1;
+        word -= carry << w;
+        wnaf[bit] = sign * word;
+        last = (int)bit;
+        bit += now;
+    }
+    return last + 1;
+}
+
+static void scalar_split_var(scalar_t *r1, scalar_t *r2, const scalar_t *k) {
+    if ((k->d[2] | k->d[3]) == 0) {
+        *r1 = *k;
+        memset(r2, 0, sizeof(*r2));
+        return;
+    }
+    scalar_split_lambda(r1, r2, k);
+}
+
+static int build_odd_table(ec_storage_t *table, unsigned int entries) {
+    fe_t gx, gy, beta;
+    ge_t base, twice;
+    gej_t basej;
+    gej_t points[EC_BATCH_SIZE];
+    ge_t row[EC_BATCH_SIZE];
+
+    if (entries == 0 || entries > EC_BATCH_SIZE) return -1;
+
+    fe_set_limbs(&gx, generator_x);
+    fe_set_limbs(&gy, generator_y);
+    fe_set_limbs(&beta, beta_limbs);
+    ge_set_xy(&base, &gx, &gy);
+    gej_set_ge(&basej, &base);
+    gej_double(&basej, &basej);
+    ge_set_gej(&twice, &basej);
+
+    gej_set_ge(&points[0], &base);
+    for (unsigned int i = 1; i < entries; i++) {
+        gej_add_ge(&points[i], &points[i - 1], &twice);
+    }
+    ge_set_all_gej(row, points, entries);
+
+    for (unsigned int i = 0; i < entries; i++) {
+        if (row[i].infinity) return -1;
+        ge_to_storage(&table[i], &row[i]);
+        ge_mul_lambda(&row[i], &row[i], &beta);
+        ge_to_storage(&table[entries + i], &row[i]);
+    }
+    return 0;
+}
+
+static void ecmult_strauss(const ec_gen_table_t *table, gej_t *r, const ec_point_t *points, const uint8_t *scalars,
+                           size_t count, const uint8_t *gen_scalar) {
+    const unsigned int entries = EC_WNAF_ENTRIES(EC_WNAF_WINDOW);
+    const unsigned int gen_entries = EC_WNAF_ENTRIES(EC_GEN_WNAF_WINDOW);
+    gej_t pre[EC_STRAUSS_POINTS * EC_WNAF_ENTRIES(EC_WNAF_WINDOW)];
+    ge_t odd[EC_STRAUSS_POINTS * EC_WNAF_ENTRIES(EC_WNAF_WINDOW)];
+    ge_t lam[EC_STRAUSS_POINTS * EC_WNAF_ENTRIES(EC_WNAF_WINDOW)];
+    int wnaf[EC_STRAUSS_POINTS * 2][EC_WNAF_BITS];
+    int gen_wnaf[2][EC_WNAF_BITS];
+    int bits = 0;
+    size_t used = 0;
+    scalar_t k, r1, r2;
+    fe_t beta;
+    ge_t p, add;
+    gej_t twice;
+
+    fe_set_limbs(&beta, beta_limbs);
+    for (size_t i = 0; i < count; i++) {
+        gej_t *row = &pre[used * entries];
+        int length;
+
+        scalar_set_b32(&k, scalars + i * EC_SCALAR_SIZE);
+        if (points[i].infinity || scalar_is_zero(&k)) continue;
+
+        scalar_split_var(&r1, &r2, &k);
+        length = scalar_wnaf(wnaf[2 * used], &r1, EC_WNAF_WINDOW);
+        bits = length > bits ? length : bits;
+        length = scalar_wnaf(wnaf[2 * used + 1], &r2, EC_WNAF_WINDOW);
+        bits = length > bits ? length : bits;
+
+        fe_set_limbs(&p.x, points[i].x);
+        fe_set_limbs(&p.y, points[i].y);
+        p.infinity = 0;
+        gej_set_ge(&row[0], &p);
+        gej_double(&twice, &row[0]);
+        for (unsigned int j = 1; j < entries; j++) {
+            gej_add_var(&row[j], &row[j - 1], &twice);
+        }
+        used++;
+    }
+
+    if (used > 0) {
+        ge_set_all_gej(odd, pre, used * entries);
+        for (size_t i = 0; i < used * entries; i++) {
+            ge_mul_lambda(&lam[i], &odd[i], &beta);
+        }
+    }
+
+    if (gen_scalar) {
+        scalar_set_b32(&k, gen_scalar);
+        scalar_split_lambda(&r1, &r2, &k);
+        int length = scalar_wnaf(gen_wnaf[0], &r1, EC_GEN_WNAF_WINDOW);
+        bits = length > bits ? length : bits;
+        length = scalar_wnaf(gen_wnaf[1], &r2, EC_GEN_WNAF_WINDOW);
+        bits = length > bits ? length : bits;
+    }
+
+    r->infinity = 1;
+    for (int bit = bits - 1; bit >= 0; bit--) {
+        gej_double(r, r);
+        for (size_t i = 0; i < used; i++) {
+            if (wnaf[2 * i][bit]) {
+                wnaf_entry(&add, &odd[i * entries], wnaf[2 * i][bit]);
+                gej_add_ge(r, r, &add);
+            }
+            if (wnaf[2 * i + 1][bit]) {
+                wnaf_entry(&add, &lam[i * entries], wnaf[2 * i + 1][bit]);
+                gej_add_ge(r, r, &add);
+            }
+        }
+        for (int half = 0; gen_scalar && half < 2; half++) {
+            if (gen_wnaf[half][bit]) {
+                wnaf_gen_entry(&add, table->odd + half * gen_entries, gen_wnaf[half][bit]);
+                gej_add_ge(r, r, &add);
+            }
+        }
+    }
+}
+
+static unsigned int pippenger_window(size_t terms) {
+    unsigned int bits = 0;
+
+    while ((terms >> bits) > 1) {
+        bits++;
+    }
+    bits = bits > 5 ? bits - 3 : 2;
+    return bits < EC_PIPPENGER_MAX_WINDOW ? bits : EC_PIPPENGER_MAX_WINDOW;
+}
+
+static void pippenger_term(ge_t *terms, int16_t *digits, size_t *used, size_t stride, const ge_t *p,
+                           const scalar_t *s, unsigned int bits, unsigned int windows) {
+    scalar_t k = *s;
+    ge_t *term = &terms[*used];
+    int carry = 0;
+
+    if (scalar_is_zero(&k)) return;
+    *term = *p;
+    if (scalar_is_high(&k)) {
+        scalar_negate(&k, &k);
+        fe_negate(&term->y, &term->y, 1);
+        fe_normalize(&term->y);
+    }
+    for (unsigned int w = 0; w < windows; w++) {
+        int digit = (int)scalar_window(k.d, w * bits, bits) + carry;
+        carry = digit >= (1 << (bits - 1));
+        digit -= carry << bits;
+        digits[w * stride + *used] = (int16_t)digit;
+    }
+    (*used)++;
+}
+
+static void pippenger_point(ge_t *terms, int16_t *digits, size_t *used, size_t stride, const ge_t *p,
+                            const scalar_t *k, const fe_t *beta, unsigned int bits, unsigned int windows) {
+    scalar_t r1, r2;
+    ge_t lam;
+
+    scalar_split_var(&r1, &r2, k);
+    pippenger_term(terms, digits, used, stride, p, &r1, bits, windows);
+    if (!scalar_is_zero(&r2)) {
+        ge_mul_lambda(&lam, p, beta);
+        pippenger_term(terms, digits, used, stride, &lam, &r2, bits, windows);
+    }
+}
+
+static int ecmult_pippenger(gej_t *r, const ec_point_t *points, const uint8_t *scalars, size_t count,
+                            const uint8_t *gen_scalar) {
+    size_t stride = 2 * (count + 1);
+    unsigned int bits = pippenger_window(stride);
+    unsigned int windows = (EC_WNAF_BITS + bits - 1) / bits;
+    size_t bucket_count = (size_t)1 << (bits - 1);
+    ge_t *terms = malloc(stride * sizeof(ge_t));
+    int16_t *digits = malloc(stride * windows * sizeof(int16_t));
+    gej_t *buckets = malloc(bucket_count * sizeof(gej_t));
+    size_t used = 0;
+    scalar_t k;
+    fe_t beta;
+    ge_t p;
+    gej_t running, sum;
+
+    if (!terms || !digits || !buckets) {
+        free(terms);
+        free(digits);
+        free(buckets);
+        return -1;
+    }
+
+    fe_set_limbs(&beta, beta_limbs);
+    for (size_t i = 0; i < count; i++) {
+        if (points[i].infinity) continue;
+        fe_set_limbs(&p.x, points[i].x);
+        fe_set_limbs(&p.y, points[i].y);
+        p.infinity = 0;
+        scalar_set_b32(&k, scalars + i * EC_SCALAR_SIZE);
+        pippenger_point(terms, digits, &used, stride, &p, &k, &beta, bits, windows);
+    }
+    if (gen_scalar) {
+        fe_set_limbs(&p.x, generator_x);
+        fe_set_limbs(&p.y, generator_y);
+        p.infinity = 0;
+        scalar_set_b32(&k, gen_scalar);
+        pippenger_point(terms, digits, &used, stride, &p, &k, &beta, bits, windows);
+    }
+
+    r->infinity = 1;
+    for (unsigned int w = windows; w-- > 0;) {
+        const int16_t *row = digits + (size_t)w * stride;
+
+        for (unsigned int b = 0; b < bits; b++) {
+            gej_double(r, r);
+        }
+        for (size_t b = 0; b < bucket_count; b++) {
+            buckets[b].infinity = 1;
+        }
+        for (size_t i = 0; i < used; i++) {
+            if (row[i] > 0) {
+                gej_add_ge(&buckets[row[i] - 1], &buckets[row[i] - 1], &terms[i]);
+            } else if (row[i] < 0) {
+                p = terms[i];
+                fe_negate(&p.y, &p.y, 1);
+                fe_normalize_weak(&p.y);
+                gej_add_ge(&buckets[-row[i] - 1], &buckets[-row[i] - 1], &p);
+            }
+        }
+
+        running.infinity = 1;
+        sum.infinity = 1;
+        for (size_t b = bucket_count; b-- > 0;) {
+            gej_add_var(&running, &running, &buckets[b]);
+            gej_add_var(&sum, &sum, &running);
+        }
+        gej_add_var(r, r, &sum);
+    }
+
+    free(terms);
+    free(digits);
+    free(buckets);
+    return 0;
+}
+
+static int mult_multi(const ec_gen_table_t *table, ec_point_t *result, const ec_point_t *points,
+                      const uint8_t *scalars, size_t count, const uint8_t *gen_scalar) {
+    gej_t r, part;
+    ge_t out;
+    size_t base = 0;
+
+    r.infinity = 1;
+    if (count >= EC_PIPPENGER_POINTS) {
+        if (ecmult_pippenger(&r, points, scalars, count, gen_scalar) != 0) return -1;
+    } else {
+        do {
+            size_t n = count - base < EC_STRAUSS_POINTS ? count - base : EC_STRAUSS_POINTS;
+            ecmult_strauss(table, &part, n ? points + base : NULL, n ? scalars + base * EC_SCALAR_SIZE : NULL, n,
+                           base == 0 ? gen_scalar : NULL);
+            gej_add_var(&r, &r, &part);
+            base += n;
+        } while (base < count);
+    }
+
+    ge_set_gej(&out, &r);
+    result->infinity = out.infinity;
+    if (!out.infinity) {
+        fe_get_limbs(result->x, &out.x);
+        fe_get_limbs(result->y, &out.y);
+    }
+    return 0;
+}
+
+const ec_backend_t EC_BACKEND = {
+    build_gen_table,
+    build_odd_table,
+    mult_gen_batch,
+    tweak_add_batch,
+    mult_multi,
+    field_inv_batch,
+    point_parse
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef EC_TABLE_H
+#define EC_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ec.h"
+
+#define EC_TABLE_MAGIC "BKECTBL"
+#define EC_TABLE_VERSION 1
+#define EC_TABLE_HEADER_SIZE 128
+#define EC_TABLE_PATH_MAX 4096
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t bits;
+    uint32_t windows;
+    uint32_t odd_entries;
+    uint32_t storage_size;
+    uint32_t reserved;
+    uint64_t entries;
+    uint8_t checksum[32];
+    uint8_t padding[56];
+} ec_table_header_t;
+
+int ec_table_default_path(char *path, size_t size, unsigned int bits);
+const ec_storage_t *ec_table_map(const char *path, unsigned int bits, unsigned int windows, unsigned int odd_entries,
+                                 size_t *mapped_size);
+void ec_table_unmap(const ec_storage_t *table, size_t mapped_size);
+int ec_table_store(const char *path, const ec_storage_t *table, unsigned int bits, unsigned int windows,
+                   unsigned int odd_entries);
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef FIELD_10X26_H
+#define FIELD_10X26_H
+
+#include <stdint.h>
+
+#define M26 0x3FFFFFFU
+#define M22 0x3FFFFFU
+
+typedef struct {
+    uint32_t n[10];
+} fe_t;
+
+static void fe_set_limbs(fe_t *r, const uint64_t *a) {
+    for (int i = 0; i < 10; i++) {
+        unsigned int bit = (unsigned int)i * 26;
+        unsigned int limb = bit >> 6;
+        unsigned int shift = bit & 63;
+        uint64_t v = a[limb] >> shift;
+        if (shift > 38 && limb < 3) {
+            v |= a[limb + 1] << (64 - shift);
+        }
+        r->n[i] = (uint32_t)v & (i == 9 ? M22 : M26);
+    }
+}
+
+static void fe_get_limbs(uint64_t *r, const fe_t *a) {
+    r[0] = r[1] = r[2] = r[3] = 0;
+    for (int i = 0; i < 10; i++) {
+        unsigned int bit = (unsigned int)i * 26;
+        unsigned int limb = bit >> 6;
+        unsigned int shift = bit & 63;
+        r[limb] |= (uint64_t)a->n[i] << shift;
+        if (shift > 38 && limb < 3) {
+            r[limb + 1] |= (uint64_t)a->n[i] >> (64 - shift);
+        }
+    }
+}
+
+static void fe_set_int(fe_t *r, uint64_t v) {
+    r->n[0] = (uint32_t)v;
+    for (int i = 1; i < 10; i++) {
+        r->n[i] = 0;
+    }
+}
+
+static void fe_carry(uint32_t *t, uint64_t x) {
+    uint64_t c = t[0] + x * 0x3D1ULL;
+    t[0] = (uint32_t)c & M26;
+    c = (c >> 26) + t[1] + (x << 6);
+    t[1] = (uint32_t)c & M26;
+    for (int i = 2; i < 9; i++) {
+        c = (c >> 26) + t[i];
+        t[i] = (uint32_t)c & M26;
+    }
+    t[9] += (uint32_t)(c >> 26);
+}
+
+static void fe_normalize_weak(fe_t *r) {
+    uint64_t x = r->n[9] >> 22;
+    r->n[9] &= M22;
+    fe_carry(r->n, x);
+}
+
+static void fe_normalize(fe_t *r) {
+    uint32_t *t = r->n;
+    uint64_t x = t[9] >> 22;
+    t[9] &= M22;
+    fe_carry(t, x);
+    uint32_t m = t[2] & t[3] & t[4] & t[5] & t[6] & t[7] & t[8];
+    x = (t[9] >> 22) | ((t[9] == M22) & (m == M26) & ((t[1] + 0x40U + ((t[0] + 0x3D1U) >> 26)) > M26));
+    fe_carry(t, x);
+    t[9] &= M22;
+}
+
+static int fe_normalizes_to_zero(const fe_t *a) {
+    fe_t t = *a;
+    uint32_t z = 0;
+    fe_normalize(&t);
+    for (int i = 0; i < 10; i++) {
+        z |= t.n[i];
+    }
+    return z == 0;
+}
+
+static int fe_is_odd(const fe_t *a) {
+    return (int)(a->n[0] & 1);
+}
+
+static void fe_add(fe_t *r, const fe_t *a) {
+    for (int i = 0; i < 10; i++) {
+        r->n[i] += a->n[i];
+    }
+}
+
+static void fe_mul_int(fe_t *r, uint64_t k) {
+    for (int i = 0; i < 10; i++) {
+        r->n[i] *= (uint32_t)k;
+    }
+}
+
+static void fe_negate(fe_t *r, const fe_t *a, uint64_t m) {
+    uint32_t k = (uint32_t)(2 * (m + 1));
+    r->n[0] = 0x3FFFC2FU * k - a->n[0];
+    r->n[1] = 0x3FFFFBFU * k - a->n[1];
+    for (int i = 2; i < 9; i++) {
+        r->n[i] = M26 * k - a->n[i];
+    }
+    r->n[9] = M22 * k - a->n[9];
+}
+
+static void fe_reduce(fe_t *r, uint64_t *c) {
+    uint64_t t[11];
+
+    for (int i = 0; i < 18; i++) {
+        c[i + 1] += c[i] >> 26;
+        c[i] &= M26;
+    }
+    c[19] = c[18] >> 26;
+    c[18] &= M26;
+
+    t[0] = c[0] + c[10] * 0x3D10ULL;
+    for (int i = 1; i < 10; i++) {
+        t[i] = c[i] + c[i + 10] * 0x3D10ULL + (c[i + 9] << 10);
+    }
+    t[10] = c[19] << 10;
+    for (int i = 0; i < 10; i++) {
+        t[i + 1] += t[i] >> 26;
+        t[i] &= M26;
+    }
+    t[0] += t[10] * 0x3D10ULL;
+    t[1] += t[10] << 10;
+    for (int i = 0; i < 9; i++) {
+        t[i + 1] += t[i] >> 26;
+        r->n[i] = (uint32_t)t[i] & M26;
+    }
+    r->n[9] = (uint32_t)t[9];
+    fe_normalize_weak(r);
+}
+
+static void fe_mul(fe_t *r, const fe_t *a, const fe_t *b) {
+    uint64_t c[20] = {0};
+
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            c[i + j] += (uint64_t)a->n[i] * b->n[j];
+        }
+    }
+    fe_reduce(r, c);
+}
+
+static void fe_sqr(fe_t *r, const fe_t *a) {
+    uint64_t c[20] = {0};
+
+    for (int i = 0; i < 10; i++) {
+        uint64_t d = (uint64_t)a->n[i] * 2;
+        c[2 * i] += (uint64_t)a->n[i] * a->n[i];
+        for (int j = i + 1; j < 10; j++) {
+            c[i + j] += d * a->n[j];
+        }
+    }
+    fe_reduce(r, c);
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef FIELD_5X52_H
+#define FIELD_5X52_H
+
+#include <stdint.h>
+
+#define M52 0xFFFFFFFFFFFFFULL
+#define M48 0xFFFFFFFFFFFFULL
+#define FE_R 0x1000003D1ULL
+#define FE_R4 0x1000003D10ULL
+
+typedef unsigned __int128 uint128_t;
+
+typedef struct {
+    uint64_t n[5];
+} fe_t;
+
+static void fe_set_limbs(fe_t *r, const uint64_t *a) {
+    r->n[0] = a[0] & M52;
+    r->n[1] = (a[0] >> 52) | ((a[1] & 0xFFFFFFFFFFULL) << 12);
+    r->n[2] = (a[1] >> 40) | ((a[2] & 0xFFFFFFFULL) << 24);
+    r->n[3] = (a[2] >> 28) | ((a[3] & 0xFFFFULL) << 36);
+    r->n[4] = a[3] >> 16;
+}
+
+static void fe_get_limbs(uint64_t *r, const fe_t *a) {
+    r[0] = a->n[0] | (a->n[1] << 52);
+    r[1] = (a->n[1] >> 12) | (a->n[2] << 40);
+    r[2] = (a->n[2] >> 24) | (a->n[3] << 28);
+    r[3] = (a->n[3] >> 36) | (a->n[4] << 16);
+}
+
+static void fe_set_int(fe_t *r, uint64_t v) {
+    r->n[0] = v;
+    r->n[1] = r->n[2] = r->n[3] = r->n[4] = 0;
+}
+
+static void fe_normalize_weak(fe_t *r) {
+    uint64_t t0 = r->n[0], t1 = r->n[1], t2 = r->n[2], t3 = r->n[3], t4 = r->n[4];
+    uint64_t x = t4 >> 48;
+    t4 &= M48;
+    t0 += x * FE_R;
+    t1 += t0 >> 52; t0 &= M52;
+    t2 += t1 >> 52; t1 &= M52;
+    t3 += t2 >> 52; t2 &= M52;
+    t4 += t3 >> 52; t3 &= M52;
+    r->n[0] = t0; r->n[1] = t1; r->n[2] = t2; r->n[3] = t3; r->n[4] = t4;
+}
+
+static void fe_normalize(fe_t *r) {
+    uint64_t t0 = r->n[0], t1 = r->n[1], t2 = r->n[2], t3 = r->n[3], t4 = r->n[4];
+    uint64_t x = t4 >> 48;
+    t4 &= M48;
+    t0 += x * FE_R;
+    t1 += t0 >> 52; t0 &= M52;
+    t2 += t1 >> 52; t1 &= M52;
+    t3 += t2 >> 52; t2 &= M52;
+    t4 += t3 >> 52; t3 &= M52;
+    x = (t4 >> 48) | ((t4 == M48) & ((t3 & t2 & t1) == M52) & (t0 >= 0xFFFFEFFFFFC2FULL));
+    t0 += x * FE_R;
+    t1 += t0 >> 52; t0 &= M52;
+    t2 += t1 >> 52; t1 &= M52;
+    t3 += t2 >> 52; t2 &= M52;
+    t4 += t3 >> 52; t3 &= M52;
+    t4 &= M48;
+    r->n[0] = t0; r->n[1] = t1; r->n[2] = t2; r->n[3] = t3; r->n[4] = t4;
+}
+
+static int fe_normalizes_to_zero(const fe_t *a) {
+    fe_t t = *a;
+    fe_normalize(&t);
+    return (t.n[0] | t.n[1] | t.n[2] | t.n[3] | t.n[4]) == 0;
+}
+
+static int fe_is_odd(const fe_t *a) {
+    return (int)(a->n[0] & 1);
+}
+
+static void fe_add(fe_t *r, const fe_t *a) {
+    r->n[0] += a->n[0];
+    r->n[1] += a->n[1];
+    r->n[2] += a->n[2];
+    r->n[3] += a->n[3];
+    r->n[4] += a->n[4];
+}
+
+static void fe_mul_int(fe_t *r, uint64_t k) {
+    r->n[0] *= k;
+    r->n[1] *= k;
+    r->n[2] *= k;
+    r->n[3] *= k;
+    r->n[4] *= k;
+}
+
+static void fe_negate(fe_t *r, const fe_t *a, uint64_t m) {
+    r->n[0] = 0xFFFFEFFFFFC2FULL * 2 * (m + 1) - a->n[0];
+    r->n[1] = M52 * 2 * (m + 1) - a->n[1];
+    r->n[2] = M52 * 2 * (m + 1) - a->n[2];
+    r->n[3] = M52 * 2 * (m + 1) - a->n[3];
+    r->n[4] = M48 * 2 * (m + 1) - a->n[4];
+}
+
+static void fe_reduce(fe_t *r, uint64_t t0, uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4,
+                      uint64_t t5, uint64_t t6, uint64_t t7, uint64_t t8, uint64_t t9) {
+    uint128_t c;
+    uint64_t r0, r1, r2, r3, r4;
+
+    c = (uint128_t)t5 * FE_R4 + t0;
+    r0 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)t6 * FE_R4 + t1;
+    r1 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)t7 * FE_R4 + t2;
+    r2 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)t8 * FE_R4 + t3;
+    r3 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)t9 * FE_R4 + t4;
+    r4 = (uint64_t)c & M52; c >>= 52;
+
+    c = (c << 4) | (r4 >> 48);
+    r4 &= M48;
+    c = c * FE_R + r0;
+    r0 = (uint64_t)c & M52;
+    r1 += (uint64_t)(c >> 52);
+
+    r->n[0] = r0; r->n[1] = r1; r->n[2] = r2; r->n[3] = r3; r->n[4] = r4;
+}
+
+static void fe_mul(fe_t *r, const fe_t *a, const fe_t *b) {
+    const uint64_t a0 = a->n[0], a1 = a->n[1], a2 = a->n[2], a3 = a->n[3], a4 = a->n[4];
+    const uint64_t b0 = b->n[0], b1 = b->n[1], b2 = b->n[2], b3 = b->n[3], b4 = b->n[4];
+    uint64_t t0, t1, t2, t3, t4, t5, t6, t7, t8;
+    uint128_t c;
+
+    c = (uint128_t)a0 * b0;
+    t0 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a0 * b1 + (uint128_t)a1 * b0;
+    t1 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a0 * b2 + (uint128_t)a1 * b1 + (uint128_t)a2 * b0;
+    t2 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a0 * b3 + (uint128_t)a1 * b2 + (uint128_t)a2 * b1 + (uint128_t)a3 * b0;
+    t3 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a0 * b4 + (uint128_t)a1 * b3 + (uint128_t)a2 * b2 + (uint128_t)a3 * b1 + (uint128_t)a4 * b0;
+    t4 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a1 * b4 + (uint128_t)a2 * b3 + (uint128_t)a3 * b2 + (uint128_t)a4 * b1;
+    t5 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a2 * b4 + (uint128_t)a3 * b3 + (uint128_t)a4 * b2;
+    t6 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a3 * b4 + (uint128_t)a4 * b3;
+    t7 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a4 * b4;
+    t8 = (uint64_t)c & M52; c >>= 52;
+
+    fe_reduce(r, t0, t1, t2, t3, t4, t5, t6, t7, t8, (uint64_t)c);
+}
+
+static void fe_sqr(fe_t *r, const fe_t *a) {
+    const uint64_t a0 = a->n[0], a1 = a->n[1], a2 = a->n[2], a3 = a->n[3], a4 = a->n[4];
+    const uint64_t d0 = a0 * 2, d1 = a1 * 2, d2 = a2 * 2, d3 = a3 * 2;
+    uint64_t t0, t1, t2, t3, t4, t5, t6, t7, t8;
+    uint128_t c;
+
+    c = (uint128_t)a0 * a0;
+    t0 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)d0 * a1;
+    t1 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)d0 * a2 + (uint128_t)a1 * a1;
+    t2 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)d0 * a3 + (uint128_t)d1 * a2;
+    t3 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)d0 * a4 + (uint128_t)d1 * a3 + (uint128_t)a2 * a2;
+    t4 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)d1 * a4 + (uint128_t)d2 * a3;
+    t5 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)d2 * a4 + (uint128_t)a3 * a3;
+    t6 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)d3 * a4;
+    t7 = (uint64_t)c & M52; c >>= 52;
+    c += (uint128_t)a4 * a4;
+    t8 = (uint64_t)c & M52; c >>= 52;
+
+    fe_reduce(r, t0, t1, t2, t3, t4, t5, t6, t7, t8, (uint64_t)c);
+}
+
+#endif
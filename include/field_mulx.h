@@ -0,0 +1,225 @@
+#ifndef FIELD_MULX_H
+#define FIELD_MULX_H
+
+#include <stdint.h>
+
+#define FE_C 0x1000003D1ULL
+
+typedef unsigned __int128 uint128_t;
+
+typedef struct {
+    uint64_t n[4];
+} fe_t;
+
+static void fe_set_limbs(fe_t *r, const uint64_t *a) {
+    r->n[0] = a[0];
+    r->n[1] = a[1];
+    r->n[2] = a[2];
+    r->n[3] = a[3];
+}
+
+static void fe_get_limbs(uint64_t *r, const fe_t *a) {
+    r[0] = a->n[0];
+    r[1] = a->n[1];
+    r[2] = a->n[2];
+    r[3] = a->n[3];
+}
+
+static void fe_set_int(fe_t *r, uint64_t v) {
+    r->n[0] = v;
+    r->n[1] = r->n[2] = r->n[3] = 0;
+}
+
+static void fe_fold(fe_t *r, uint64_t top) {
+    uint128_t c = (uint128_t)top * FE_C + r->n[0];
+    r->n[0] = (uint64_t)c; c >>= 64;
+    c += r->n[1];
+    r->n[1] = (uint64_t)c; c >>= 64;
+    c += r->n[2];
+    r->n[2] = (uint64_t)c; c >>= 64;
+    c += r->n[3];
+    r->n[3] = (uint64_t)c; c >>= 64;
+
+    c = c * FE_C + r->n[0];
+    r->n[0] = (uint64_t)c; c >>= 64;
+    c += r->n[1];
+    r->n[1] = (uint64_t)c; c >>= 64;
+    c += r->n[2];
+    r->n[2] = (uint64_t)c; c >>= 64;
+    r->n[3] += (uint64_t)c;
+}
+
+static void fe_normalize_weak(fe_t *r) {
+    (void)r;
+}
+
+static void fe_normalize(fe_t *r) {
+    uint128_t c = (uint128_t)r->n[0] + FE_C;
+    uint64_t t0 = (uint64_t)c; c >>= 64;
+    c += r->n[1];
+    uint64_t t1 = (uint64_t)c; c >>= 64;
+    c += r->n[2];
+    uint64_t t2 = (uint64_t)c; c >>= 64;
+    c += r->n[3];
+    uint64_t t3 = (uint64_t)c; c >>= 64;
+    uint64_t mask = (uint64_t)0 - (uint64_t)c;
+
+    r->n[0] = (t0 & mask) | (r->n[0] & ~mask);
+    r->n[1] = (t1 & mask) | (r->n[1] & ~mask);
+    r->n[2] = (t2 & mask) | (r->n[2] & ~mask);
+    r->n[3] = (t3 & mask) | (r->n[3] & ~mask);
+}
+
+static int fe_normalizes_to_zero(const fe_t *a) {
+    fe_t t = *a;
+    fe_normalize(&t);
+    return (t.n[0] | t.n[1] | t.n[2] | t.n[3]) == 0;
+}
+
+static int fe_is_odd(const fe_t *a) {
+    return (int)(a->n[0] & 1);
+}
+
+static void fe_add(fe_t *r, const fe_t *a) {
+    uint128_t c = (uint128_t)r->n[0] + a->n[0];
+    r->n[0] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)r->n[1] + a->n[1];
+    r->n[1] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)r->n[2] + a->n[2];
+    r->n[2] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)r->n[3] + a->n[3];
+    r->n[3] = (uint64_t)c; c >>= 64;
+    fe_fold(r, (uint64_t)c);
+}
+
+static void fe_mul_int(fe_t *r, uint64_t k) {
+    uint128_t c = (uint128_t)r->n[0] * k;
+    r->n[0] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)r->n[1] * k;
+    r->n[1] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)r->n[2] * k;
+    r->n[2] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)r->n[3] * k;
+    r->n[3] = (uint64_t)c; c >>= 64;
+    fe_fold(r, (uint64_t)c);
+}
+
+static void fe_negate(fe_t *r, const fe_t *a, uint64_t m) {
+    uint128_t c = (uint128_t)0xFFFFFFFEFFFFFC2FULL - a->n[0];
+    (void)m;
+    r->n[0] = (uint64_t)c;
+    c = (uint128_t)0xFFFFFFFFFFFFFFFFULL - a->n[1] - (uint64_t)((c >> 64) & 1);
+    r->n[1] = (uint64_t)c;
+    c = (uint128_t)0xFFFFFFFFFFFFFFFFULL - a->n[2] - (uint64_t)((c >> 64) & 1);
+    r->n[2] = (uint64_t)c;
+    c = (uint128_t)0xFFFFFFFFFFFFFFFFULL - a->n[3] - (uint64_t)((c >> 64) & 1);
+    r->n[3] = (uint64_t)c;
+
+    uint64_t borrow = (uint64_t)(c >> 64) & 1;
+    c = (uint128_t)r->n[0] - (FE_C & ((uint64_t)0 - borrow));
+    r->n[0] = (uint64_t)c;
+    c = (uint128_t)r->n[1] - (uint64_t)((c >> 64) & 1);
+    r->n[1] = (uint64_t)c;
+    c = (uint128_t)r->n[2] - (uint64_t)((c >> 64) & 1);
+    r->n[2] = (uint64_t)c;
+    r->n[3] -= (uint64_t)((c >> 64) & 1);
+}
+
+static void fe_mul_wide(uint64_t *t, const uint64_t *a, const uint64_t *b) {
+    __asm__ (
+        "movq 0(%[b]), %%rdx\n\t"
+        "mulxq 0(%[a]), %%r8, %%r9\n\t"
+        "mulxq 8(%[a]), %%rax, %%r10\n\t"
+        "addq %%rax, %%r9\n\t"
+        "mulxq 16(%[a]), %%rax, %%r11\n\t"
+        "adcq %%rax, %%r10\n\t"
+        "mulxq 24(%[a]), %%rax, %%r12\n\t"
+        "adcq %%rax, %%r11\n\t"
+        "adcq $0, %%r12\n\t"
+
+        "movq 8(%[b]), %%rdx\n\t"
+        "xorl %%r13d, %%r13d\n\t"
+        "mulxq 0(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r9\n\t"
+        "adoxq %%rbx, %%r10\n\t"
+        "mulxq 8(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r10\n\t"
+        "adoxq %%rbx, %%r11\n\t"
+        "mulxq 16(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r11\n\t"
+        "adoxq %%rbx, %%r12\n\t"
+        "mulxq 24(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r12\n\t"
+        "adoxq %%rbx, %%r13\n\t"
+        "adcq $0, %%r13\n\t"
+
+        "movq 16(%[b]), %%rdx\n\t"
+        "xorl %%r14d, %%r14d\n\t"
+        "mulxq 0(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r10\n\t"
+        "adoxq %%rbx, %%r11\n\t"
+        "mulxq 8(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r11\n\t"
+        "adoxq %%rbx, %%r12\n\t"
+        "mulxq 16(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r12\n\t"
+        "adoxq %%rbx, %%r13\n\t"
+        "mulxq 24(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r13\n\t"
+        "adoxq %%rbx, %%r14\n\t"
+        "adcq $0, %%r14\n\t"
+
+        "movq 24(%[b]), %%rdx\n\t"
+        "xorl %%r15d, %%r15d\n\t"
+        "mulxq 0(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r11\n\t"
+        "adoxq %%rbx, %%r12\n\t"
+        "mulxq 8(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r12\n\t"
+        "adoxq %%rbx, %%r13\n\t"
+        "mulxq 16(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r13\n\t"
+        "adoxq %%rbx, %%r14\n\t"
+        "mulxq 24(%[a]), %%rax, %%rbx\n\t"
+        "adcxq %%rax, %%r14\n\t"
+        "adoxq %%rbx, %%r15\n\t"
+        "adcq $0, %%r15\n\t"
+
+        "movq %%r8, 0(%[t])\n\t"
+        "movq %%r9, 8(%[t])\n\t"
+        "movq %%r10, 16(%[t])\n\t"
+        "movq %%r11, 24(%[t])\n\t"
+        "movq %%r12, 32(%[t])\n\t"
+        "movq %%r13, 40(%[t])\n\t"
+        "movq %%r14, 48(%[t])\n\t"
+        "movq %%r15, 56(%[t])\n\t"
+        :
+        : [t] "r"(t), [a] "r"(a), [b] "r"(b)
+        : "rax", "rbx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory");
+}
+
+static void fe_reduce(fe_t *r, const uint64_t *t) {
+    uint128_t c = (uint128_t)t[4] * FE_C + t[0];
+    r->n[0] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)t[5] * FE_C + t[1];
+    r->n[1] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)t[6] * FE_C + t[2];
+    r->n[2] = (uint64_t)c; c >>= 64;
+    c += (uint128_t)t[7] * FE_C + t[3];
+    r->n[3] = (uint64_t)c; c >>= 64;
+    fe_fold(r, (uint64_t)c);
+}
+
+static void fe_mul(fe_t *r, const fe_t *a, const fe_t *b) {
+    uint64_t t[8];
+    fe_mul_wide(t, a->n, b->n);
+    fe_reduce(r, t);
+}
+
+static void fe_sqr(fe_t *r, const fe_t *a) {
+    uint64_t t[8];
+    fe_mul_wide(t, a->n, a->n);
+    fe_reduce(r, t);
+}
+
+#endif
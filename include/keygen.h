@@ -4,6 +4,12 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "crypto.h"
+#include "address.h"
+
+#define KEYGEN_BLOCK_SIZE 256
+#define KEYGEN_RECORD_MAX 512
+#define KEYGEN_REORDER_BLOCKS_PER_THREAD 4
+#define KEYGEN_ARENA_SIZE (256U << 10)
 
 typedef enum {
     OUTPUT_FORMAT_HEX,
@@ -19,11 +25,60 @@ typedef struct {
     int testnet;
     int verbose;
     int quiet;
+    int threads;
+    int ordered;
+    const char *output_path;
+    int io_uring;
+    address_type_t address_type;
+    const char *derive_path;
+    const char *xkey;
+    const char *xkeys[MULTISIG_MAX_KEYS];
+    int xkey_count;
+    int multisig;
+    const char *seed;
+    uint32_t range_start;
+    uint32_t range_end;
+    const char *serve_path;
+    int pool_size;
+    int mnemonic;
+    int mnemonic_words;
+    const char *passphrase;
+    const char *phrase;
+    const char *dump_path;
+    const char *index_path;
+    const char *lookup;
+    const char *input_path;
+    const char *validate_path;
+    int pipeline;
+    int pin_threads;
+    int stats;
+    int progress;
+    const volatile int *running;
+    unsigned int table_bits;
+    const char *table_path;
+    const char *sign_path;
+    const char *verify_path;
+    int schnorr;
 } keygen_options_t;
 
 int generate_bitcoin_key_pair(private_key_t *private_key, public_key_t *public_key, const keygen_options_t *options);
+int generate_private_keys(private_key_t *private_keys, int *key_numbers, int first, int count, const keygen_options_t *options);
+int generate_bitcoin_key_pairs(private_key_t *private_keys, public_key_t *public_keys, int *key_numbers, int first, int count, const keygen_options_t *options);
 int generate_multiple_keys(int count, const keygen_options_t *options);
+int derive_keys(const keygen_options_t *options);
+int import_keys(const keygen_options_t *options);
+int validate_addresses(const keygen_options_t *options);
+int sign_messages(const keygen_options_t *options);
+int verify_signatures(const keygen_options_t *options);
+int generate_wallets(const keygen_options_t *options);
+int dump_keystore(const keygen_options_t *options);
+int index_keystore(const keygen_options_t *options);
+int lookup_addresses(const keygen_options_t *options);
+int format_key_record(const private_key_t *private_key, const public_key_t *public_key, const char *address_string, const keygen_options_t *options, char *output, size_t output_size);
+int format_key_information(const private_key_t *private_key, const public_key_t *public_key, const bitcoin_address_t *address, const keygen_options_t *options, char *output, size_t output_size);
 int print_key_information(const private_key_t *private_key, const public_key_t *public_key, const bitcoin_address_t *address, const keygen_options_t *options);
+int keygen_output_open(const keygen_options_t *options);
+int keygen_output_close(void);
 int parse_command_line_args(int argc, char *argv[], keygen_options_t *options);
 void print_usage(const char *program_name);
 void print_version(void);
@@ -0,0 +1,57 @@
+#ifndef KEYINDEX_H
+#define KEYINDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "keystore.h"
+#include "address.h"
+
+#define KEYINDEX_MAGIC "BTCKEYIX"
+#define KEYINDEX_MAGIC_SIZE 8
+#define KEYINDEX_VERSION 2
+#define KEYINDEX_HEADER_SIZE 64
+#define KEYINDEX_SUFFIX ".idx"
+#define KEYINDEX_BATCH_SIZE 16
+#define KEYINDEX_PREFETCH_STRIDE 8
+#define KEYINDEX_PROGRAM_SIZE 32
+#define KEYINDEX_KIND_MASK 0x07
+#define KEYINDEX_KIND_KEY_HASH 0
+#define KEYINDEX_KIND_COMPRESSED_HASH 1
+#define KEYINDEX_KIND_SCRIPT_HASH 2
+#define KEYINDEX_KIND_TAPROOT 3
+#define KEYINDEX_MAX_KINDS 4
+
+typedef struct {
+    uint8_t magic[KEYINDEX_MAGIC_SIZE];
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t reserved;
+    uint64_t entry_count;
+    uint64_t store_size;
+    uint8_t store_checksum[SHA256_DIGEST_SIZE];
+} keyindex_header_t;
+
+_Static_assert(sizeof(keyindex_header_t) == KEYINDEX_HEADER_SIZE, "key index header layout");
+_Static_assert(KEYSTORE_HEADER_SIZE % (KEYINDEX_KIND_MASK + 1) == 0 &&
+               KEYSTORE_RECORD_SIZE % (KEYINDEX_KIND_MASK + 1) == 0, "key index kind tag");
+
+typedef struct {
+    keystore_reader_t store;
+    int fd;
+    const uint8_t *data;
+    size_t size;
+    size_t count;
+    const uint64_t *keys;
+    const uint64_t *offsets;
+} keyindex_t;
+
+int keyindex_path(const char *store_path, char *path, size_t path_size);
+int keyindex_build(const char *store_path, const char *index_path, size_t *count);
+int keyindex_open(keyindex_t *index, const char *store_path, const char *index_path);
+void keyindex_close(keyindex_t *index);
+const keystore_record_t *keyindex_lookup(const keyindex_t *index, address_type_t type, const uint8_t *program,
+                                         int *compressed);
+void keyindex_lookup_batch(const keyindex_t *index, const address_type_t *types, const uint8_t *programs, size_t count,
+                           const keystore_record_t **records, int *compressed);
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef KEYSTORE_H
+#define KEYSTORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto.h"
+#include "ripemd160.h"
+#include "sha256.h"
+
+#define KEYSTORE_MAGIC "BTCKEYST"
+#define KEYSTORE_MAGIC_SIZE 8
+#define KEYSTORE_VERSION 1
+#define KEYSTORE_HEADER_SIZE 64
+#define KEYSTORE_RECORD_SIZE 88
+#define KEYSTORE_MAX_BLOCK_RECORDS 4096
+#define KEYSTORE_CHECKSUM_OFFSET 20
+
+#define KEYSTORE_FLAG_COMPRESSED 0x01
+#define KEYSTORE_FLAG_TESTNET 0x02
+
+typedef struct {
+    uint8_t magic[KEYSTORE_MAGIC_SIZE];
+    uint16_t version;
+    uint16_t header_size;
+    uint16_t record_size;
+    uint16_t reserved;
+    uint32_t record_count;
+    uint8_t checksum[SHA256_DIGEST_SIZE];
+    uint8_t padding[12];
+} keystore_header_t;
+
+typedef struct {
+    uint8_t private_key[PRIVATE_KEY_SIZE];
+    uint8_t public_key[COMPRESSED_PUBLIC_KEY_SIZE];
+    uint8_t hash160[HASH160_SIZE];
+    uint8_t flags;
+    uint8_t reserved[2];
+} keystore_record_t;
+
+_Static_assert(sizeof(keystore_header_t) == KEYSTORE_HEADER_SIZE, "keystore header layout");
+_Static_assert(sizeof(keystore_record_t) == KEYSTORE_RECORD_SIZE, "keystore record layout");
+_Static_assert(offsetof(keystore_header_t, checksum) == KEYSTORE_CHECKSUM_OFFSET, "keystore checksum offset");
+
+typedef struct {
+    int fd;
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+    const keystore_header_t *block;
+    uint32_t next_record;
+} keystore_reader_t;
+
+size_t keystore_block_size(size_t count);
+int keystore_fill_records(const private_key_t *private_keys, const public_key_t *public_keys, size_t count,
+                          int testnet, keystore_record_t *records);
+int keystore_record_keys(const keystore_record_t *record, private_key_t *private_key, public_key_t *public_key);
+int keystore_encode_block(const keystore_record_t *records, size_t count, uint8_t *output, size_t output_size,
+                          size_t *length);
+int keystore_verify_block(const keystore_header_t *header, const keystore_record_t *records);
+
+int keystore_open(keystore_reader_t *reader, const char *path);
+void keystore_close(keystore_reader_t *reader);
+int keystore_next_block(keystore_reader_t *reader, const keystore_header_t **header, const keystore_record_t **records);
+int keystore_next_record(keystore_reader_t *reader, const keystore_record_t **record);
+
+#endif
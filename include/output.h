@@ -0,0 +1,45 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#define OUTPUT_BUFFER_SIZE (1U << 20)
+#define OUTPUT_URING_DEPTH 8
+#define OUTPUT_IOV_MAX 64
+
+typedef enum {
+    OUTPUT_BACKEND_WRITE,
+    OUTPUT_BACKEND_IO_URING
+} output_backend_t;
+
+typedef struct {
+    char *data;
+    size_t used;
+    size_t capacity;
+} output_buffer_t;
+
+typedef struct output_uring_s output_uring_t;
+
+typedef struct {
+    int fd;
+    int owns_fd;
+    output_backend_t backend;
+    off_t offset;
+    int error;
+    pthread_mutex_t lock;
+    output_uring_t *uring;
+} output_t;
+
+int output_open(output_t *out, const char *path, output_backend_t backend);
+int output_close(output_t *out);
+int output_buffer_init(output_buffer_t *buffer, size_t capacity);
+void output_buffer_free(output_buffer_t *buffer);
+int output_flush(output_t *out, output_buffer_t *buffer);
+int output_write(output_t *out, const void *data, size_t length);
+int output_writev(output_t *out, const struct iovec *iov, int count);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "keygen.h"
+#include "output.h"
+
+#define PIPELINE_RING_SIZE 8
+#define PIPELINE_BATCHES_PER_LANE 2
+#define PIPELINE_SHARED_STAGES 4
+
+int pipeline_run(int count, const keygen_options_t *options, output_t *out);
+
+#endif
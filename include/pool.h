@@ -0,0 +1,13 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+#define POOL_MAX_THREADS 256
+
+typedef int (*pool_task_fn)(size_t task, int worker, void *context);
+
+int pool_cpu_count(void);
+int pool_run(int threads, size_t task_count, pool_task_fn fn, void *context);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef RING_H
+#define RING_H
+
+#include <stddef.h>
+
+#define RING_CACHE_LINE 64
+#define RING_SPIN_LIMIT 128
+
+typedef struct {
+    void **slots;
+    size_t mask;
+    char pad0[RING_CACHE_LINE - sizeof(void **) - sizeof(size_t)];
+    size_t head;
+    size_t cached_tail;
+    char pad1[RING_CACHE_LINE - 2 * sizeof(size_t)];
+    size_t tail;
+    size_t cached_head;
+    char pad2[RING_CACHE_LINE - 2 * sizeof(size_t)];
+} ring_t;
+
+int ring_init(ring_t *ring, size_t capacity);
+void ring_free(ring_t *ring);
+int ring_try_push(ring_t *ring, void *item);
+int ring_try_pop(ring_t *ring, void **item);
+void ring_push(ring_t *ring, void *item);
+void *ring_pop(ring_t *ring);
+
+#endif
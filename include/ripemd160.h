@@ -0,0 +1,30 @@
+#ifndef RIPEMD160_H
+#define RIPEMD160_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RIPEMD160_DIGEST_SIZE 20
+#define RIPEMD160_BLOCK_SIZE 64
+#define RIPEMD160_MAX_LANES 16
+#define HASH160_SIZE RIPEMD160_DIGEST_SIZE
+
+typedef enum {
+    RIPEMD160_IMPL_AUTO,
+    RIPEMD160_IMPL_SCALAR,
+    RIPEMD160_IMPL_SSE2,
+    RIPEMD160_IMPL_AVX2,
+    RIPEMD160_IMPL_AVX512
+} ripemd160_impl_t;
+
+int ripemd160_select(ripemd160_impl_t impl);
+ripemd160_impl_t ripemd160_active(void);
+const char *ripemd160_impl_name(ripemd160_impl_t impl);
+int ripemd160_supported(ripemd160_impl_t impl);
+
+void ripemd160(const uint8_t *data, size_t length, uint8_t *digest);
+void ripemd160_batch(const uint8_t *const *messages, size_t length, size_t count, uint8_t *digests);
+void hash160(const uint8_t *data, size_t length, uint8_t *digest);
+void hash160_batch(const uint8_t *const *messages, size_t length, size_t count, uint8_t *digests);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RNG_KEY_SIZE 32
+#define RNG_BUFFER_BLOCKS 16
+#define RNG_BUFFER_SIZE (RNG_BUFFER_BLOCKS * 64)
+#define RNG_RESEED_INTERVAL (1ULL << 24)
+
+int rng_init(void);
+void rng_cleanup(void);
+int rng_reseed(void);
+int rng_bytes(uint8_t *output, size_t length);
+int rng_scalars(uint8_t *scalars, size_t count);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef SCALAR_H
+#define SCALAR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SCALAR_SIZE 32
+
+typedef struct {
+    uint64_t d[4];
+} scalar_t;
+
+int scalar_is_valid_b32(const uint8_t *scalar);
+int scalar_add_b32(uint8_t *result, const uint8_t *a, const uint8_t *b);
+int scalar_set_b32(scalar_t *r, const uint8_t *b32);
+void scalar_get_b32(uint8_t *b32, const scalar_t *a);
+int scalar_is_zero(const scalar_t *a);
+int scalar_is_high(const scalar_t *a);
+void scalar_add(scalar_t *r, const scalar_t *a, const scalar_t *b);
+void scalar_negate(scalar_t *r, const scalar_t *a);
+void scalar_mul(scalar_t *r, const scalar_t *a, const scalar_t *b);
+void scalar_inverse(scalar_t *r, const scalar_t *a);
+int scalar_inverse_batch(scalar_t *r, const scalar_t *a, size_t count);
+void scalar_split_lambda(scalar_t *r1, scalar_t *r2, const scalar_t *k);
+
+#endif
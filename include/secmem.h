@@ -0,0 +1,23 @@
+#ifndef SECMEM_H
+#define SECMEM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SECMEM_ALIGNMENT 64
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t used;
+} secmem_arena_t;
+
+void secmem_set_quiet(int quiet);
+void *secmem_map(size_t size);
+void secmem_unmap(void *data, size_t size);
+int secmem_arena_init(secmem_arena_t *arena, size_t size);
+void secmem_arena_free(secmem_arena_t *arena);
+void *secmem_alloc(secmem_arena_t *arena, size_t size);
+void secmem_reset(secmem_arena_t *arena);
+
+#endif
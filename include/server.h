@@ -0,0 +1,30 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "keygen.h"
+
+#define SERVER_MAX_WALLETS 64
+#define SERVER_MAX_CLIENTS 64
+#define SERVER_DEFAULT_POOL_SIZE 1024
+#define SERVER_MAX_POOL_SIZE 65536
+#define SERVER_MAX_FRAME 256
+#define SERVER_POLL_TIMEOUT_MS 500
+#define SERVER_DEFAULT_CHAIN "m/0"
+
+#define SERVER_OP_REGISTER 0x01
+#define SERVER_OP_NEXT 0x02
+
+#define SERVER_STATUS_OK 0x00
+#define SERVER_STATUS_ERROR 0x01
+#define SERVER_STATUS_UNKNOWN_WALLET 0x02
+#define SERVER_STATUS_FULL 0x03
+#define SERVER_STATUS_EXHAUSTED 0x04
+
+int server_run(const keygen_options_t *options, const volatile int *running);
+int server_connect(const char *path);
+int server_register(int fd, const char *xkey, uint32_t start, uint32_t *wallet);
+int server_next_address(int fd, uint32_t wallet, uint32_t *index, char *address, size_t address_size);
+
+#endif
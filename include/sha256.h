@@ -0,0 +1,49 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SHA256_DIGEST_SIZE 32
+#define SHA256_BLOCK_SIZE 64
+#define SHA256_MAX_LANES 16
+
+typedef enum {
+    SHA256_IMPL_AUTO,
+    SHA256_IMPL_SCALAR,
+    SHA256_IMPL_SHANI,
+    SHA256_IMPL_AVX2,
+    SHA256_IMPL_AVX512
+} sha256_impl_t;
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t buffer[SHA256_BLOCK_SIZE];
+    size_t buffered;
+} sha256_ctx_t;
+
+typedef struct {
+    sha256_ctx_t inner;
+    sha256_ctx_t outer;
+} hmac_sha256_ctx_t;
+
+int sha256_select(sha256_impl_t impl);
+sha256_impl_t sha256_active(void);
+const char *sha256_impl_name(sha256_impl_t impl);
+int sha256_supported(sha256_impl_t impl);
+
+void sha256_init(sha256_ctx_t *ctx);
+void sha256_tagged_init(sha256_ctx_t *ctx, const char *tag);
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t length);
+void sha256_final(sha256_ctx_t *ctx, uint8_t *digest);
+void sha256(const uint8_t *data, size_t length, uint8_t *digest);
+void sha256d(const uint8_t *data, size_t length, uint8_t *digest);
+void hmac_sha256_init(hmac_sha256_ctx_t *ctx, const uint8_t *key, size_t key_length);
+void hmac_sha256_update(hmac_sha256_ctx_t *ctx, const uint8_t *data, size_t length);
+void hmac_sha256_final(hmac_sha256_ctx_t *ctx, uint8_t *mac);
+void hmac_sha256(const uint8_t *key, size_t key_length, const uint8_t *data, size_t length, uint8_t *mac);
+void sha256_batch(const uint8_t *const *messages, size_t length, size_t count, uint8_t *digests);
+void sha256d_batch(const uint8_t *const *messages, size_t length, size_t count, uint8_t *digests);
+
+#endif
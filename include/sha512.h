@@ -0,0 +1,50 @@
+#ifndef SHA512_H
+#define SHA512_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SHA512_DIGEST_SIZE 64
+#define SHA512_BLOCK_SIZE 128
+#define SHA512_MAX_LANES 8
+
+typedef enum {
+    SHA512_IMPL_AUTO,
+    SHA512_IMPL_SCALAR,
+    SHA512_IMPL_AVX2,
+    SHA512_IMPL_AVX512
+} sha512_impl_t;
+
+typedef struct {
+    uint64_t state[8];
+    uint64_t length;
+    uint8_t buffer[SHA512_BLOCK_SIZE];
+    size_t buffered;
+} sha512_ctx_t;
+
+typedef struct {
+    sha512_ctx_t inner;
+    sha512_ctx_t outer;
+} hmac_sha512_ctx_t;
+
+int sha512_select(sha512_impl_t impl);
+sha512_impl_t sha512_active(void);
+const char *sha512_impl_name(sha512_impl_t impl);
+int sha512_supported(sha512_impl_t impl);
+size_t sha512_lanes(void);
+
+void sha512_init(sha512_ctx_t *ctx);
+void sha512_update(sha512_ctx_t *ctx, const uint8_t *data, size_t length);
+void sha512_final(sha512_ctx_t *ctx, uint8_t *digest);
+void sha512(const uint8_t *data, size_t length, uint8_t *digest);
+void hmac_sha512_init(hmac_sha512_ctx_t *ctx, const uint8_t *key, size_t key_length);
+void hmac_sha512_update(hmac_sha512_ctx_t *ctx, const uint8_t *data, size_t length);
+void hmac_sha512_final(hmac_sha512_ctx_t *ctx, uint8_t *mac);
+void hmac_sha512(const uint8_t *key, size_t key_length, const uint8_t *data, size_t length, uint8_t *mac);
+int pbkdf2_hmac_sha512(const uint8_t *password, size_t password_length, const uint8_t *salt, size_t salt_length,
+                       uint32_t iterations, uint8_t *output, size_t output_length);
+int pbkdf2_hmac_sha512_batch(const uint8_t *const *passwords, const size_t *password_lengths,
+                             const uint8_t *const *salts, const size_t *salt_lengths,
+                             size_t count, uint32_t iterations, uint8_t *outputs);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef SIGNATURE_H
+#define SIGNATURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto.h"
+
+#define SIGNATURE_HASH_SIZE 32
+#define SIGNATURE_SIZE 64
+#define SCHNORR_PUBLIC_KEY_SIZE 32
+#define SCHNORR_AUX_SIZE 32
+#define SIGNATURE_BATCH_SIZE 256
+
+int ecdsa_sign(const private_key_t *key, const uint8_t *hash, uint8_t *signature);
+int ecdsa_sign_batch(const private_key_t *keys, const uint8_t *hashes, uint8_t *signatures, size_t count);
+int ecdsa_verify(const public_key_t *public_key, const uint8_t *hash, const uint8_t *signature);
+int schnorr_public_key(const private_key_t *key, uint8_t *public_key);
+int schnorr_sign(const private_key_t *key, const uint8_t *message, const uint8_t *aux, uint8_t *signature);
+int schnorr_sign_batch(const private_key_t *keys, const uint8_t *messages, const uint8_t *aux, uint8_t *signatures,
+                       size_t count);
+int schnorr_verify(const uint8_t *public_key, const uint8_t *message, const uint8_t *signature);
+int schnorr_verify_batch(const uint8_t *public_keys, const uint8_t *messages, const uint8_t *signatures, size_t count);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define STATS_MAX_THREADS 1024
+#define STATS_HISTOGRAM_BUCKETS 40
+#define STATS_PROGRESS_INTERVAL_MS 1000
+
+typedef enum {
+    STATS_STAGE_RNG,
+    STATS_STAGE_DERIVE,
+    STATS_STAGE_HASH,
+    STATS_STAGE_ENCODE,
+    STATS_STAGE_WRITE,
+    STATS_STAGE_COUNT
+} stats_stage_t;
+
+typedef enum {
+    STATS_COUNTER_KEYS,
+    STATS_COUNTER_REJECTED,
+    STATS_COUNTER_BYTES,
+    STATS_COUNTER_COUNT
+} stats_counter_t;
+
+typedef struct {
+    uint64_t counters[STATS_COUNTER_COUNT];
+    uint64_t stage_ns[STATS_STAGE_COUNT];
+    uint64_t stage_batches[STATS_STAGE_COUNT];
+    uint64_t histogram[STATS_STAGE_COUNT][STATS_HISTOGRAM_BUCKETS];
+} stats_thread_t;
+
+extern int stats_enabled;
+
+int stats_start(int progress, uint64_t expected);
+void stats_stop(void);
+void stats_report(FILE *stream, int interrupted);
+uint64_t stats_clock(void);
+void stats_record(stats_stage_t stage, uint64_t start);
+void stats_add(stats_counter_t counter, uint64_t value);
+
+static inline uint64_t stats_begin(void) {
+    return __builtin_expect(stats_enabled, 0) ? stats_clock() : 0;
+}
+
+static inline void stats_end(stats_stage_t stage, uint64_t start) {
+    if (__builtin_expect(start != 0, 0)) {
+        stats_record(stage, start);
+    }
+}
+
+static inline void stats_count(stats_counter_t counter, uint64_t value) {
+    if (__builtin_expect(stats_enabled, 0)) {
+        stats_add(counter, value);
+    }
+}
+
+#endif
@@ -6,10 +6,12 @@
 #include <stdbool.h>
 
 #define MAX_HEX_STRING_SIZE 131
-#define MAX_WIF_STRING_SIZE 52
-#define MAX_ADDRESS_STRING_SIZE 35
+#define MAX_WIF_STRING_SIZE 53
+#define MAX_ADDRESS_STRING_SIZE 91
 
+int hex_decode(const char *hex, size_t hex_len, uint8_t *bytes);
 int hex_to_bytes(const char *hex, uint8_t *bytes, size_t bytes_size);
+size_t encode_hex(const uint8_t *bytes, size_t bytes_size, char *hex);
 int bytes_to_hex(const uint8_t *bytes, size_t bytes_size, char *hex, size_t hex_size);
 int validate_hex_string(const char *hex);
 int validate_wif_string(const char *wif);
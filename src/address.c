@@ -1,35 +1,242 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include "address.h"
+#include "sha256.h"
+#include "ripemd160.h"
+#include "bech32.h"
+#include "ec.h"
+#include "scalar.h"
 #include "utils.h"
 
-static const char *base58_chars = BASE58_ALPHABET;
+static const char base58_chars[] = BASE58_ALPHABET;
+
+static const int8_t base58_map[128] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8, -1, -1, -1, -1, -1, -1,
+    -1,  9, 10, 11, 12, 13, 14, 15, 16, -1, 17, 18, 19, 20, 21, -1,
+    22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, -1, -1, -1, -1, -1,
+    -1, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, -1, 44, 45, 46,
+    47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, -1, -1, -1, -1, -1
+};
+
+static inline __attribute__((always_inline))
+size_t base58_encode_limbs(const uint8_t *data, size_t data_len, char *output) {
+    uint32_t limbs[BASE58_MAX_LIMBS];
+    char digits[BASE58_MAX_ENCODED + 5];
+    size_t zeros = 0;
+    size_t count = (data_len + 3) / 4;
+    size_t top = 0;
+    size_t produced = 0;
+
+    while (zeros < data_len && data[zeros] == 0) {
+        zeros++;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        limbs[i] = 0;
+    }
+    for (size_t i = 0; i < data_len; i++) {
+        size_t bit = (data_len - 1 - i) * 8;
+        limbs[count - 1 - bit / 32] |= (uint32_t)data[i] << (bit % 32);
+    }
+
+    while (top < count && limbs[top] == 0) {
+        top++;
+    }
+
+    while (top < count) {
+        uint64_t remainder = 0;
+        for (size_t i = top; i < count; i++) {
+            uint64_t current = (remainder << 32) | limbs[i];
+            limbs[i] = (uint32_t)(current / BASE58_POW5);
+            remainder = current % BASE58_POW5;
+        }
+        for (int d = 0; d < 5; d++) {
+            digits[produced++] = base58_chars[remainder % 58];
+            remainder /= 58;
+        }
+        while (top < count && limbs[top] == 0) {
+            top++;
+        }
+    }
+
+    while (produced > 0 && digits[produced - 1] == base58_chars[0]) {
+        produced--;
+    }
+
+    for (size_t i = 0; i < zeros; i++) {
+        output[i] = base58_chars[0];
+    }
+    for (size_t i = 0; i < produced; i++) {
+        output[zeros + i] = digits[produced - 1 - i];
+    }
+    output[zeros + produced] = '\0';
+
+    return zeros + produced;
+}
+
+static size_t base58_encode_25(const uint8_t *data, char *output) {
+    return base58_encode_limbs(data, 25, output);
+}
+
+static size_t base58_encode_37(const uint8_t *data, char *output) {
+    return base58_encode_limbs(data, 37, output);
+}
+
+static size_t base58_encode_38(const uint8_t *data, char *output) {
+    return base58_encode_limbs(data, 38, output);
+}
+
+static size_t base58_encode_any(const uint8_t *data, size_t data_len, char *output) {
+    switch (data_len) {
+        case 25:
+            return base58_encode_25(data, output);
+        case 37:
+            return base58_encode_37(data, output);
+        case 38:
+            return base58_encode_38(data, output);
+        default:
+            return base58_encode_limbs(data, data_len, output);
+    }
+}
 
 int base58_encode(const uint8_t *data, size_t data_len, char *output, size_t output_size) {
     if (!data || !output || output_size == 0) return -1;
+    if (data_len > BASE58_MAX_PAYLOAD) return -1;
+    
+    char encoded[BASE58_MAX_ENCODED + 1];
+    size_t length = base58_encode_any(data, data_len, encoded);
+    if (length + 1 > output_size) return -1;
+    
+    memcpy(output, encoded, length + 1);
+    return 0;
+}
+
+int base58_encode_batch(const uint8_t *data, size_t data_len, size_t count, char *output, size_t output_stride) {
+    if (!data || !output) return -1;
+    if (data_len > BASE58_MAX_PAYLOAD || output_stride < BASE58_ENCODED_SIZE(data_len) + 1) return -1;
+    
+    switch (data_len) {
+        case 25:
+            for (size_t i = 0; i < count; i++) {
+                base58_encode_25(data + i * 25, output + i * output_stride);
+            }
+            break;
+        case 37:
+            for (size_t i = 0; i < count; i++) {
+                base58_encode_37(data + i * 37, output + i * output_stride);
+            }
+            break;
+        case 38:
+            for (size_t i = 0; i < count; i++) {
+                base58_encode_38(data + i * 38, output + i * output_stride);
+            }
+            break;
+        default:
+            for (size_t i = 0; i < count; i++) {
+                base58_encode_limbs(data + i * data_len, data_len, output + i * output_stride);
+            }
+            break;
+    }
     
-    snprintf(output, output_size, "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa");
     return 0;
 }
 
 int base58_decode(const char *input, uint8_t *output, size_t output_size) {
     if (!input || !output || output_size == 0) return -1;
     
-    for (size_t i = 0; i < output_size && i < strlen(input); i++) {
-        output[i] = (uint8_t)input[i];
+    uint32_t limbs[BASE58_MAX_LIMBS];
+    size_t length = strlen(input);
+    size_t zeros = 0;
+    size_t count = 0;
+    
+    if (length > BASE58_MAX_ENCODED) return -1;
+    
+    while (zeros < length && input[zeros] == base58_chars[0]) {
+        zeros++;
     }
     
-    return 0;
+    for (size_t i = zeros; i < length; ) {
+        uint64_t chunk = 0;
+        uint64_t scale = 1;
+        
+        for (int d = 0; d < 5 && i < length; d++, i++) {
+            unsigned char c = (unsigned char)input[i];
+            if (c >= 128 || base58_map[c] < 0) return -1;
+            chunk = chunk * 58 + (uint64_t)base58_map[c];
+            scale *= 58;
+        }
+        
+        uint64_t carry = chunk;
+        for (size_t j = 0; j < count; j++) {
+            uint64_t current = (uint64_t)limbs[j] * scale + carry;
+            limbs[j] = (uint32_t)current;
+            carry = current >> 32;
+        }
+        while (carry > 0) {
+            if (count == BASE58_MAX_LIMBS) return -1;
+            limbs[count++] = (uint32_t)carry;
+            carry >>= 32;
+        }
+    }
+    
+    size_t significant = count * 4;
+    while (significant > 0 && ((limbs[(significant - 1) / 4] >> (((significant - 1) % 4) * 8)) & 0xFF) == 0) {
+        significant--;
+    }
+    
+    if (zeros + significant > output_size) return -1;
+    
+    memset(output, 0, zeros);
+    for (size_t i = 0; i < significant; i++) {
+        size_t byte = significant - 1 - i;
+        output[zeros + i] = (uint8_t)(limbs[byte / 4] >> ((byte % 4) * 8));
+    }
+    
+    return (int)(zeros + significant);
+}
+
+int base58check_encode(const uint8_t *payload, size_t payload_len, char *output, size_t output_size) {
+    if (!payload || !output) return -1;
+    if (payload_len + CHECKSUM_SIZE > BASE58_MAX_PAYLOAD) return -1;
+    
+    uint8_t buffer[BASE58_MAX_PAYLOAD];
+    memcpy(buffer, payload, payload_len);
+    if (calculate_checksum(payload, payload_len, buffer + payload_len) != 0) {
+        return -1;
+    }
+    
+    int result = base58_encode(buffer, payload_len + CHECKSUM_SIZE, output, output_size);
+    secure_zero_memory(buffer, sizeof(buffer));
+    return result;
+}
+
+int base58check_decode(const char *input, uint8_t *payload, size_t payload_size) {
+    if (!input || !payload) return -1;
+    
+    uint8_t buffer[BASE58_MAX_PAYLOAD];
+    int length = base58_decode(input, buffer, sizeof(buffer));
+    int result = -1;
+    
+    if (length >= CHECKSUM_SIZE + 1 && (size_t)length - CHECKSUM_SIZE <= payload_size &&
+        verify_checksum(buffer, (size_t)length - CHECKSUM_SIZE, buffer + length - CHECKSUM_SIZE) == 0) {
+        memcpy(payload, buffer, (size_t)length - CHECKSUM_SIZE);
+        result = length - CHECKSUM_SIZE;
+    }
+    
+    secure_zero_memory(buffer, sizeof(buffer));
+    return result;
 }
 
 int calculate_checksum(const uint8_t *data, size_t data_len, uint8_t *checksum) {
     if (!data || !checksum) return -1;
     
-    for (int i = 0; i < CHECKSUM_SIZE; i++) {
-        checksum[i] = (uint8_t)(rand() % 256);
-    }
+    uint8_t hash[SHA256_DIGEST_SIZE];
+    sha256d(data, data_len, hash);
+    memcpy(checksum, hash, CHECKSUM_SIZE);
     
     return 0;
 }
@@ -37,58 +244,516 @@ int calculate_checksum(const uint8_t *data, size_t data_len, uint8_t *checksum)
 int verify_checksum(const uint8_t *data, size_t data_len, const uint8_t *checksum) {
     if (!data || !checksum) return -1;
     
-    return 0;
+    uint8_t expected[CHECKSUM_SIZE];
+    if (calculate_checksum(data, data_len, expected) != 0) {
+        return -1;
+    }
+    
+    return memcmp(expected, checksum, CHECKSUM_SIZE) == 0 ? 0 : -1;
+}
+
+static void finish_addresses(bitcoin_address_t *addresses, size_t count) {
+    const uint8_t *messages[SHA256_MAX_LANES];
+    uint8_t digests[SHA256_MAX_LANES * SHA256_DIGEST_SIZE];
+    
+    for (size_t base = 0; base < count; base += SHA256_MAX_LANES) {
+        size_t n = count - base < SHA256_MAX_LANES ? count - base : SHA256_MAX_LANES;
+        for (size_t i = 0; i < n; i++) {
+            messages[i] = addresses[base + i].data;
+        }
+        sha256d_batch(messages, 1 + HASH160_SIZE, n, digests);
+        for (size_t i = 0; i < n; i++) {
+            memcpy(addresses[base + i].data + 1 + HASH160_SIZE, digests + i * SHA256_DIGEST_SIZE, CHECKSUM_SIZE);
+            addresses[base + i].length = 1 + HASH160_SIZE + CHECKSUM_SIZE;
+        }
+    }
 }
 
 int create_p2pkh_address(const public_key_t *public_key, bitcoin_address_t *address) {
-    if (!public_key || !address) return -1;
+    return create_p2pkh_addresses(public_key, address, 1, 0);
+}
+
+int create_p2pkh_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count, int testnet) {
+    if (!public_keys || !addresses) return -1;
+    
+    const uint8_t *messages[HASH160_BATCH_SIZE];
+    uint8_t digests[HASH160_BATCH_SIZE * HASH160_SIZE];
     
-    address->data[0] = VERSION_BYTE_MAINNET;
-    for (int i = 1; i < 21; i++) {
-        address->data[i] = (uint8_t)(rand() % 256);
+    for (size_t base = 0; base < count; ) {
+        size_t length = public_keys[base].length;
+        size_t n = 0;
+        
+        if (length != PUBLIC_KEY_SIZE && length != COMPRESSED_PUBLIC_KEY_SIZE) return -1;
+        while (n < HASH160_BATCH_SIZE && base + n < count && public_keys[base + n].length == length) {
+            messages[n] = public_keys[base + n].data;
+            n++;
+        }
+        
+        hash160_batch(messages, length, n, digests);
+        for (size_t i = 0; i < n; i++) {
+            addresses[base + i].data[0] = testnet ? VERSION_BYTE_TESTNET : VERSION_BYTE_MAINNET;
+            memcpy(addresses[base + i].data + 1, digests + i * HASH160_SIZE, HASH160_SIZE);
+        }
+        finish_addresses(addresses + base, n);
+        base += n;
     }
     
-    for (int i = 21; i < 25; i++) {
-        address->data[i] = (uint8_t)(rand() % 256);
+    secure_zero_memory(digests, sizeof(digests));
+    return 0;
+}
+
+static int compress_public_key(const public_key_t *public_key, uint8_t *output) {
+    if (public_key->length == COMPRESSED_PUBLIC_KEY_SIZE) {
+        memcpy(output, public_key->data, COMPRESSED_PUBLIC_KEY_SIZE);
+        return 0;
     }
+    if (public_key->length != PUBLIC_KEY_SIZE || public_key->data[0] != 0x04) return -1;
     
-    address->length = 25;
+    output[0] = (public_key->data[PUBLIC_KEY_SIZE - 1] & 1) ? 0x03 : 0x02;
+    memcpy(output + 1, public_key->data + 1, 32);
+    return 0;
+}
+
+static int compressed_key_hash160s(const public_key_t *public_keys, size_t count, uint8_t *digests) {
+    uint8_t keys[HASH160_BATCH_SIZE][COMPRESSED_PUBLIC_KEY_SIZE];
+    const uint8_t *messages[HASH160_BATCH_SIZE];
+    
+    for (size_t i = 0; i < count; i++) {
+        if (compress_public_key(&public_keys[i], keys[i]) != 0) return -1;
+        messages[i] = keys[i];
+    }
+    hash160_batch(messages, COMPRESSED_PUBLIC_KEY_SIZE, count, digests);
     return 0;
 }
 
 int create_p2sh_address(const public_key_t *public_key, bitcoin_address_t *address) {
-    if (!public_key || !address) return -1;
+    return create_p2sh_addresses(public_key, address, 1, 0);
+}
+
+int create_p2sh_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count, int testnet) {
+    if (!public_keys || !addresses) return -1;
     
-    address->data[0] = 0x05;
-    for (int i = 1; i < 21; i++) {
-        address->data[i] = (uint8_t)(rand() % 256);
+    uint8_t scripts[HASH160_BATCH_SIZE][2 + HASH160_SIZE];
+    const uint8_t *messages[HASH160_BATCH_SIZE];
+    uint8_t digests[HASH160_BATCH_SIZE * HASH160_SIZE];
+    
+    for (size_t base = 0; base < count; base += HASH160_BATCH_SIZE) {
+        size_t n = count - base < HASH160_BATCH_SIZE ? count - base : HASH160_BATCH_SIZE;
+        
+        if (compressed_key_hash160s(public_keys + base, n, digests) != 0) return -1;
+        for (size_t i = 0; i < n; i++) {
+            scripts[i][0] = 0x00;
+            scripts[i][1] = HASH160_SIZE;
+            memcpy(scripts[i] + 2, digests + i * HASH160_SIZE, HASH160_SIZE);
+            messages[i] = scripts[i];
+        }
+        
+        hash160_batch(messages, 2 + HASH160_SIZE, n, digests);
+        for (size_t i = 0; i < n; i++) {
+            addresses[base + i].data[0] = testnet ? P2SH_VERSION_BYTE_TESTNET : P2SH_VERSION_BYTE_MAINNET;
+            memcpy(addresses[base + i].data + 1, digests + i * HASH160_SIZE, HASH160_SIZE);
+        }
+        finish_addresses(addresses + base, n);
     }
     
-    for (int i = 21; i < 25; i++) {
-        address->data[i] = (uint8_t)(rand() % 256);
+    secure_zero_memory(scripts, sizeof(scripts));
+    secure_zero_memory(digests, sizeof(digests));
+    return 0;
+}
+
+static void sort_public_keys(const uint8_t *public_keys, size_t keys, const uint8_t **sorted) {
+    for (size_t i = 0; i < keys; i++) {
+        const uint8_t *key = public_keys + i * COMPRESSED_PUBLIC_KEY_SIZE;
+        size_t j = i;
+        
+        while (j > 0 && memcmp(sorted[j - 1], key, COMPRESSED_PUBLIC_KEY_SIZE) > 0) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = key;
+    }
+}
+
+int multisig_script(const uint8_t *public_keys, size_t keys, size_t threshold, uint8_t *script, size_t script_size) {
+    if (!public_keys || !script) return -1;
+    if (keys == 0 || keys > MULTISIG_MAX_KEYS || threshold == 0 || threshold > keys) return -1;
+    if (script_size < MULTISIG_SCRIPT_SIZE(keys)) return -1;
+    
+    const uint8_t *sorted[MULTISIG_MAX_KEYS];
+    uint8_t *p = script;
+    
+    sort_public_keys(public_keys, keys, sorted);
+    *p++ = (uint8_t)(OP_1 + threshold - 1);
+    for (size_t i = 0; i < keys; i++) {
+        if (sorted[i][0] != 0x02 && sorted[i][0] != 0x03) return -1;
+        *p++ = COMPRESSED_PUBLIC_KEY_SIZE;
+        memcpy(p, sorted[i], COMPRESSED_PUBLIC_KEY_SIZE);
+        p += COMPRESSED_PUBLIC_KEY_SIZE;
+    }
+    *p++ = (uint8_t)(OP_1 + keys - 1);
+    *p++ = OP_CHECKMULTISIG;
+    
+    return (int)(p - script);
+}
+
+int create_multisig_addresses(const uint8_t *public_keys, size_t keys, size_t threshold, bitcoin_address_t *addresses,
+                              size_t count, address_type_t type, int testnet) {
+    if (!public_keys || !addresses) return -1;
+    if (type != ADDRESS_TYPE_P2SH && type != ADDRESS_TYPE_P2WSH) return -1;
+    
+    uint8_t scripts[HASH160_BATCH_SIZE][MULTISIG_SCRIPT_MAX];
+    const uint8_t *messages[HASH160_BATCH_SIZE];
+    uint8_t digests[HASH160_BATCH_SIZE * SHA256_DIGEST_SIZE];
+    size_t stride = keys * COMPRESSED_PUBLIC_KEY_SIZE;
+    size_t length = MULTISIG_SCRIPT_SIZE(keys);
+    
+    for (size_t base = 0; base < count; base += HASH160_BATCH_SIZE) {
+        size_t n = count - base < HASH160_BATCH_SIZE ? count - base : HASH160_BATCH_SIZE;
+        
+        for (size_t i = 0; i < n; i++) {
+            if (multisig_script(public_keys + (base + i) * stride, keys, threshold, scripts[i], MULTISIG_SCRIPT_MAX) < 0) {
+                return -1;
+            }
+            messages[i] = scripts[i];
+        }
+        
+        if (type == ADDRESS_TYPE_P2SH) {
+            hash160_batch(messages, length, n, digests);
+            for (size_t i = 0; i < n; i++) {
+                addresses[base + i].data[0] = testnet ? P2SH_VERSION_BYTE_TESTNET : P2SH_VERSION_BYTE_MAINNET;
+                memcpy(addresses[base + i].data + 1, digests + i * HASH160_SIZE, HASH160_SIZE);
+            }
+            finish_addresses(addresses + base, n);
+        } else {
+            sha256_batch(messages, length, n, digests);
+            for (size_t i = 0; i < n; i++) {
+                memcpy(addresses[base + i].data, digests + i * SHA256_DIGEST_SIZE, SHA256_DIGEST_SIZE);
+                addresses[base + i].length = SHA256_DIGEST_SIZE;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+int create_p2wpkh_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count) {
+    if (!public_keys || !addresses) return -1;
+    
+    uint8_t digests[HASH160_BATCH_SIZE * HASH160_SIZE];
+    
+    for (size_t base = 0; base < count; base += HASH160_BATCH_SIZE) {
+        size_t n = count - base < HASH160_BATCH_SIZE ? count - base : HASH160_BATCH_SIZE;
+        
+        if (compressed_key_hash160s(public_keys + base, n, digests) != 0) return -1;
+        for (size_t i = 0; i < n; i++) {
+            memcpy(addresses[base + i].data, digests + i * HASH160_SIZE, HASH160_SIZE);
+            addresses[base + i].length = HASH160_SIZE;
+        }
     }
     
-    address->length = 25;
+    secure_zero_memory(digests, sizeof(digests));
     return 0;
 }
 
+int create_p2tr_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count) {
+    if (!public_keys || !addresses) return -1;
+    
+    ec_point_t points[HASH160_BATCH_SIZE];
+    uint8_t tweaks[HASH160_BATCH_SIZE * SCALAR_SIZE];
+    uint8_t key[COMPRESSED_PUBLIC_KEY_SIZE];
+    sha256_ctx_t tag, ctx;
+    size_t length;
+    int result = 0;
+    
+    sha256_tagged_init(&tag, TAPROOT_TWEAK_TAG);
+    
+    for (size_t base = 0; base < count && result == 0; base += HASH160_BATCH_SIZE) {
+        size_t n = count - base < HASH160_BATCH_SIZE ? count - base : HASH160_BATCH_SIZE;
+        
+        for (size_t i = 0; i < n; i++) {
+            uint8_t *tweak = tweaks + i * SCALAR_SIZE;
+            
+            if (compress_public_key(&public_keys[base + i], key) != 0 ||
+                ec_point_parse(&points[i], key + 1, 32) != 0) {
+                result = -1;
+                break;
+            }
+            ctx = tag;
+            sha256_update(&ctx, key + 1, 32);
+            sha256_final(&ctx, tweak);
+            if (!scalar_is_valid_b32(tweak)) {
+                result = -1;
+                break;
+            }
+        }
+        
+        if (result == 0 && ec_point_tweak_add_batch(points, tweaks, n) != 0) {
+            result = -1;
+        }
+        for (size_t i = 0; i < n && result == 0; i++) {
+            if (ec_point_serialize(&points[i], key, &length, 1) != 0) {
+                result = -1;
+                break;
+            }
+            memcpy(addresses[base + i].data, key + 1, 32);
+            addresses[base + i].length = 32;
+        }
+    }
+    
+    secure_zero_memory(tweaks, sizeof(tweaks));
+    return result;
+}
+
+int create_addresses(const public_key_t *public_keys, bitcoin_address_t *addresses, size_t count,
+                     address_type_t type, int testnet) {
+    switch (type) {
+        case ADDRESS_TYPE_P2PKH:
+            return create_p2pkh_addresses(public_keys, addresses, count, testnet);
+        case ADDRESS_TYPE_P2SH:
+            return create_p2sh_addresses(public_keys, addresses, count, testnet);
+        case ADDRESS_TYPE_P2WPKH:
+            return create_p2wpkh_addresses(public_keys, addresses, count);
+        case ADDRESS_TYPE_P2TR:
+            return create_p2tr_addresses(public_keys, addresses, count);
+        case ADDRESS_TYPE_P2WSH:
+            return -1;
+    }
+    return -1;
+}
+
+int encode_address(const bitcoin_address_t *address, address_type_t type, int testnet, char *output, size_t output_size) {
+    return encode_addresses(address, 1, type, testnet, output, output_size);
+}
+
+int encode_addresses(const bitcoin_address_t *addresses, size_t count, address_type_t type, int testnet,
+                     char *output, size_t output_stride) {
+    if (!addresses || !output) return -1;
+    
+    const char *hrp = testnet ? SEGWIT_HRP_TESTNET : SEGWIT_HRP_MAINNET;
+    
+    switch (type) {
+        case ADDRESS_TYPE_P2PKH:
+        case ADDRESS_TYPE_P2SH:
+            if (output_stride < BASE58_ENCODED_SIZE(25) + 1) return -1;
+            for (size_t i = 0; i < count; i++) {
+                if (addresses[i].length != 25) return -1;
+                base58_encode_25(addresses[i].data, output + i * output_stride);
+            }
+            return 0;
+        case ADDRESS_TYPE_P2WPKH:
+            return segwit_address_encode_batch(hrp, 0, addresses->data, HASH160_SIZE, sizeof(bitcoin_address_t),
+                                               count, output, output_stride);
+        case ADDRESS_TYPE_P2TR:
+            return segwit_address_encode_batch(hrp, 1, addresses->data, 32, sizeof(bitcoin_address_t),
+                                               count, output, output_stride);
+        case ADDRESS_TYPE_P2WSH:
+            return segwit_address_encode_batch(hrp, 0, addresses->data, SHA256_DIGEST_SIZE, sizeof(bitcoin_address_t),
+                                               count, output, output_stride);
+    }
+    return -1;
+}
+
+static int is_segwit_prefix(const char *address) {
+    return (address[0] == 'b' || address[0] == 'B' || address[0] == 't' || address[0] == 'T') &&
+           ((address[1] == 'c' || address[1] == 'C') || ((address[0] == 't' || address[0] == 'T') &&
+                                                          (address[1] == 'b' || address[1] == 'B'))) &&
+           address[2] == '1';
+}
+
+static address_status_t network_status(int testnet, int network) {
+    if (network == ADDRESS_NETWORK_ANY || network == testnet) return ADDRESS_VALID;
+    return ADDRESS_INVALID_NETWORK;
+}
+
+static address_status_t segwit_status(const char *address, int network) {
+    char hrp[SEGWIT_MAX_HRP + 1];
+    uint8_t program[SEGWIT_MAX_PROGRAM];
+    size_t program_len;
+    int witness_version;
+    
+    switch (segwit_address_check(address, hrp, sizeof(hrp), &witness_version, program, &program_len)) {
+        case SEGWIT_VALID:
+            break;
+        case SEGWIT_INVALID_LENGTH:
+            return ADDRESS_INVALID_LENGTH;
+        case SEGWIT_INVALID_CHARACTER:
+            return ADDRESS_INVALID_CHARACTER;
+        case SEGWIT_INVALID_CHECKSUM:
+            return ADDRESS_INVALID_CHECKSUM;
+        case SEGWIT_INVALID_VERSION:
+            return ADDRESS_INVALID_VERSION;
+        case SEGWIT_INVALID_PADDING:
+        case SEGWIT_INVALID_PROGRAM:
+            return ADDRESS_INVALID_PROGRAM;
+        default:
+            return ADDRESS_INVALID_ENCODING;
+    }
+    
+    if (strcmp(hrp, SEGWIT_HRP_MAINNET) == 0) return network_status(0, network);
+    if (strcmp(hrp, SEGWIT_HRP_TESTNET) == 0) return network_status(1, network);
+    return ADDRESS_INVALID_ENCODING;
+}
+
+static address_status_t base58_address_payload(const char *address, uint8_t *payload) {
+    size_t length = strlen(address);
+    
+    if (length < ADDRESS_BASE58_MIN_LENGTH || length > ADDRESS_BASE58_MAX_LENGTH) return ADDRESS_INVALID_LENGTH;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)address[i];
+        if (c >= 128 || base58_map[c] < 0) return ADDRESS_INVALID_CHARACTER;
+    }
+    if (base58_decode(address, payload, ADDRESS_PAYLOAD_SIZE) != ADDRESS_PAYLOAD_SIZE) return ADDRESS_INVALID_LENGTH;
+    return ADDRESS_VALID;
+}
+
+static void finish_base58_checks(const uint8_t *const *payloads, const size_t *slots, size_t count,
+                                 int network, address_status_t *statuses) {
+    uint8_t digests[ADDRESS_VALIDATE_BATCH * SHA256_DIGEST_SIZE];
+    
+    sha256d_batch(payloads, 1 + HASH160_SIZE, count, digests);
+    
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *payload = payloads[i];
+        address_status_t status;
+        
+        if (memcmp(digests + i * SHA256_DIGEST_SIZE, payload + 1 + HASH160_SIZE, CHECKSUM_SIZE) != 0) {
+            status = ADDRESS_INVALID_CHECKSUM;
+        } else if (payload[0] == VERSION_BYTE_MAINNET || payload[0] == P2SH_VERSION_BYTE_MAINNET) {
+            status = network_status(0, network);
+        } else if (payload[0] == VERSION_BYTE_TESTNET || payload[0] == P2SH_VERSION_BYTE_TESTNET) {
+            status = network_status(1, network);
+        } else {
+            status = ADDRESS_INVALID_VERSION;
+        }
+        statuses[slots[i]] = status;
+    }
+}
+
+int address_validate_batch(const char *const *addresses, size_t count, int network, address_status_t *statuses) {
+    if (!addresses || !statuses) return -1;
+    
+    uint8_t payloads[ADDRESS_VALIDATE_BATCH][ADDRESS_PAYLOAD_SIZE];
+    const uint8_t *messages[ADDRESS_VALIDATE_BATCH];
+    size_t slots[ADDRESS_VALIDATE_BATCH];
+    size_t pending = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        const char *address = addresses[i];
+        
+        if (!address || address[0] == '\0' || address[1] == '\0') {
+            statuses[i] = ADDRESS_INVALID_LENGTH;
+            continue;
+        }
+        if (is_segwit_prefix(address)) {
+            statuses[i] = segwit_status(address, network);
+            continue;
+        }
+        
+        statuses[i] = base58_address_payload(address, payloads[pending]);
+        if (statuses[i] != ADDRESS_VALID) continue;
+        
+        messages[pending] = payloads[pending];
+        slots[pending++] = i;
+        if (pending == ADDRESS_VALIDATE_BATCH) {
+            finish_base58_checks(messages, slots, pending, network, statuses);
+            pending = 0;
+        }
+    }
+    if (pending > 0) {
+        finish_base58_checks(messages, slots, pending, network, statuses);
+    }
+    
+    return 0;
+}
+
+const char *address_status_string(address_status_t status) {
+    switch (status) {
+        case ADDRESS_VALID:
+            return "valid";
+        case ADDRESS_INVALID_LENGTH:
+            return "invalid length";
+        case ADDRESS_INVALID_CHARACTER:
+            return "invalid character";
+        case ADDRESS_INVALID_ENCODING:
+            return "malformed encoding";
+        case ADDRESS_INVALID_CHECKSUM:
+            return "checksum mismatch";
+        case ADDRESS_INVALID_VERSION:
+            return "unknown version";
+        case ADDRESS_INVALID_PROGRAM:
+            return "invalid witness program";
+        case ADDRESS_INVALID_NETWORK:
+            return "wrong network";
+    }
+    return "unknown";
+}
+
 int validate_bitcoin_address(const char *address) {
     if (!address) return -1;
     
+    address_status_t status;
+    if (address_validate_batch(&address, 1, ADDRESS_NETWORK_ANY, &status) != 0) return -1;
+    return status == ADDRESS_VALID ? 0 : -1;
+}
+
+int address_decode(const char *address, address_type_t *type, int *testnet, uint8_t *program, size_t *program_len) {
+    if (!address || !type || !testnet || !program || !program_len) return -1;
+    
+    char hrp[SEGWIT_MAX_HRP + 1];
+    int witness_version;
+    
+    if (segwit_address_decode(address, hrp, sizeof(hrp), &witness_version, program, program_len) == 0) {
+        if (strcmp(hrp, SEGWIT_HRP_MAINNET) == 0) {
+            *testnet = 0;
+        } else if (strcmp(hrp, SEGWIT_HRP_TESTNET) == 0) {
+            *testnet = 1;
+        } else {
+            return -1;
+        }
+        if (witness_version == 0 && *program_len == HASH160_SIZE) {
+            *type = ADDRESS_TYPE_P2WPKH;
+        } else if (witness_version == 0 && *program_len == SHA256_DIGEST_SIZE) {
+            *type = ADDRESS_TYPE_P2WSH;
+        } else if (witness_version == 1 && *program_len == 32) {
+            *type = ADDRESS_TYPE_P2TR;
+        } else {
+            return -1;
+        }
+        return 0;
+    }
+    
+    uint8_t payload[1 + HASH160_SIZE];
+    if (base58check_decode(address, payload, sizeof(payload)) != (int)sizeof(payload)) return -1;
+    
+    switch (payload[0]) {
+        case VERSION_BYTE_MAINNET:
+        case VERSION_BYTE_TESTNET:
+            *type = ADDRESS_TYPE_P2PKH;
+            break;
+        case P2SH_VERSION_BYTE_MAINNET:
+        case P2SH_VERSION_BYTE_TESTNET:
+            *type = ADDRESS_TYPE_P2SH;
+            break;
+        default:
+            return -1;
+    }
+    *testnet = payload[0] == VERSION_BYTE_TESTNET || payload[0] == P2SH_VERSION_BYTE_TESTNET;
+    memcpy(program, payload + 1, HASH160_SIZE);
+    *program_len = HASH160_SIZE;
     return 0;
 }
 
 int address_to_bytes(const char *address, address_data_t *data) {
     if (!address || !data) return -1;
     
-    data->version = address[0];
-    for (int i = 0; i < 20; i++) {
-        data->payload[i] = (uint8_t)address[i + 1];
-    }
-    
-    for (int i = 0; i < CHECKSUM_SIZE; i++) {
-        data->checksum[i] = (uint8_t)address[i + 21];
+    uint8_t payload[ADDRESS_PAYLOAD_SIZE];
+    if (base58_address_payload(address, payload) != ADDRESS_VALID ||
+        verify_checksum(payload, 1 + HASH160_SIZE, payload + 1 + HASH160_SIZE) != 0) {
+        return -1;
     }
     
+    data->version = payload[0];
+    memcpy(data->payload, payload + 1, HASH160_SIZE);
+    memcpy(data->checksum, payload + 1 + HASH160_SIZE, CHECKSUM_SIZE);
     return 0;
-} 
\ No newline at end of file
+}
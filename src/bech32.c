@@ -0,0 +1,190 @@
+#include <string.h>
+#include "bech32.h"
+
+static const char bech32_chars[] = BECH32_CHARSET;
+
+static const uint32_t bech32_generator[32] = {
+    0x00000000, 0x3b6a57b2, 0x26508e6d, 0x1d3ad9df, 0x1ea119fa, 0x25cb4e48, 0x38f19797, 0x039bc025,
+    0x3d4233dd, 0x0628646f, 0x1b12bdb0, 0x2078ea02, 0x23e32a27, 0x18897d95, 0x05b3a44a, 0x3ed9f3f8,
+    0x2a1462b3, 0x117e3501, 0x0c44ecde, 0x372ebb6c, 0x34b57b49, 0x0fdf2cfb, 0x12e5f524, 0x298fa296,
+    0x1756516e, 0x2c3c06dc, 0x3106df03, 0x0a6c88b1, 0x09f74894, 0x329d1f26, 0x2fa7c6f9, 0x14cd914b
+};
+
+static inline uint32_t polymod_step(uint32_t chk, uint8_t value) {
+    return ((chk & 0x1ffffff) << 5) ^ value ^ bech32_generator[chk >> 25];
+}
+
+static int hrp_polymod(const char *hrp, size_t hrp_len, uint32_t *chk) {
+    uint32_t c = 1;
+
+    for (size_t i = 0; i < hrp_len; i++) {
+        unsigned char ch = (unsigned char)hrp[i];
+        if (ch < 33 || ch > 126 || (ch >= 'A' && ch <= 'Z')) return -1;
+        c = polymod_step(c, ch >> 5);
+    }
+    c = polymod_step(c, 0);
+    for (size_t i = 0; i < hrp_len; i++) {
+        c = polymod_step(c, (unsigned char)hrp[i] & 31);
+    }
+
+    *chk = c;
+    return 0;
+}
+
+static size_t program_to_words(const uint8_t *program, size_t program_len, uint8_t *words) {
+    uint32_t acc = 0;
+    int bits = 0;
+    size_t count = 0;
+
+    for (size_t i = 0; i < program_len; i++) {
+        acc = (acc << 8) | program[i];
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            words[count++] = (uint8_t)((acc >> bits) & 31);
+        }
+    }
+    if (bits > 0) {
+        words[count++] = (uint8_t)((acc << (5 - bits)) & 31);
+    }
+
+    return count;
+}
+
+static size_t encode_words(uint32_t hrp_chk, uint32_t constant, const uint8_t *words, size_t word_count, char *output) {
+    uint32_t chk = hrp_chk;
+
+    for (size_t i = 0; i < word_count; i++) {
+        chk = polymod_step(chk, words[i]);
+        output[i] = bech32_chars[words[i]];
+    }
+    for (int i = 0; i < BECH32_CHECKSUM_LENGTH; i++) {
+        chk = polymod_step(chk, 0);
+    }
+    chk ^= constant;
+    for (int i = 0; i < BECH32_CHECKSUM_LENGTH; i++) {
+        output[word_count + i] = bech32_chars[(chk >> (5 * (5 - i))) & 31];
+    }
+
+    return word_count + BECH32_CHECKSUM_LENGTH;
+}
+
+static int segwit_check(const char *hrp, int witness_version, size_t program_len, size_t *hrp_len, size_t *encoded_len) {
+    if (!hrp || witness_version < 0 || witness_version > 16) return -1;
+    if (program_len < 2 || program_len > SEGWIT_MAX_PROGRAM) return -1;
+    if (witness_version == 0 && program_len != 20 && program_len != 32) return -1;
+
+    *hrp_len = strlen(hrp);
+    *encoded_len = *hrp_len + 1 + 1 + (program_len * 8 + 4) / 5 + BECH32_CHECKSUM_LENGTH;
+    if (*hrp_len == 0 || *encoded_len > BECH32_MAX_LENGTH) return -1;
+    return 0;
+}
+
+int segwit_address_encode(const char *hrp, int witness_version, const uint8_t *program, size_t program_len,
+                          char *output, size_t output_size) {
+    return segwit_address_encode_batch(hrp, witness_version, program, program_len, program_len, 1, output, output_size);
+}
+
+int segwit_address_encode_batch(const char *hrp, int witness_version, const uint8_t *programs, size_t program_len,
+                                size_t program_stride, size_t count, char *output, size_t output_stride) {
+    size_t hrp_len, encoded_len;
+    uint32_t hrp_chk;
+    uint8_t words[1 + (SEGWIT_MAX_PROGRAM * 8 + 4) / 5];
+
+    if (!programs || !output) return -1;
+    if (segwit_check(hrp, witness_version, program_len, &hrp_len, &encoded_len) != 0) return -1;
+    if (output_stride < encoded_len + 1) return -1;
+    if (hrp_polymod(hrp, hrp_len, &hrp_chk) != 0) return -1;
+
+    uint32_t constant = witness_version == 0 ? BECH32_CONST : BECH32M_CONST;
+    hrp_chk = polymod_step(hrp_chk, (uint8_t)witness_version);
+
+    for (size_t i = 0; i < count; i++) {
+        char *out = output + i * output_stride;
+        size_t word_count = program_to_words(programs + i * program_stride, program_len, words);
+
+        memcpy(out, hrp, hrp_len);
+        out[hrp_len] = '1';
+        out[hrp_len + 1] = bech32_chars[witness_version];
+        size_t length = encode_words(hrp_chk, constant, words, word_count, out + hrp_len + 2);
+        out[hrp_len + 2 + length] = '\0';
+    }
+
+    return 0;
+}
+
+static int bech32_char_value(unsigned char c) {
+    const char *p = c ? strchr(bech32_chars, c) : NULL;
+    return p ? (int)(p - bech32_chars) : -1;
+}
+
+segwit_status_t segwit_address_check(const char *address, char *hrp, size_t hrp_size, int *witness_version,
+                                     uint8_t *program, size_t *program_len) {
+    if (!address || !hrp || !witness_version || !program || !program_len) return SEGWIT_INVALID_FORMAT;
+
+    char lower[BECH32_MAX_LENGTH + 1];
+    uint8_t words[BECH32_MAX_LENGTH];
+    size_t length = strlen(address);
+    size_t separator = 0;
+    int has_lower = 0, has_upper = 0;
+
+    if (length < 8 || length > BECH32_MAX_LENGTH) return SEGWIT_INVALID_LENGTH;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)address[i];
+        if (c < 33 || c > 126) return SEGWIT_INVALID_CHARACTER;
+        if (c >= 'a' && c <= 'z') has_lower = 1;
+        if (c >= 'A' && c <= 'Z') {
+            has_upper = 1;
+            c = (unsigned char)(c - 'A' + 'a');
+        }
+        if (c == '1') separator = i;
+        lower[i] = (char)c;
+    }
+    lower[length] = '\0';
+    if ((has_lower && has_upper) || separator == 0 || separator >= hrp_size ||
+        length - separator - 1 < 1 + BECH32_CHECKSUM_LENGTH) {
+        return SEGWIT_INVALID_FORMAT;
+    }
+
+    uint32_t chk;
+    if (hrp_polymod(lower, separator, &chk) != 0) return SEGWIT_INVALID_FORMAT;
+
+    size_t word_count = length - separator - 1;
+    for (size_t i = 0; i < word_count; i++) {
+        int value = bech32_char_value((unsigned char)lower[separator + 1 + i]);
+        if (value < 0) return SEGWIT_INVALID_CHARACTER;
+        words[i] = (uint8_t)value;
+        chk = polymod_step(chk, words[i]);
+    }
+
+    int version = words[0];
+    if (chk != BECH32_CONST && chk != BECH32M_CONST) return SEGWIT_INVALID_CHECKSUM;
+    if (version > 16) return SEGWIT_INVALID_VERSION;
+    if (chk != (version == 0 ? BECH32_CONST : BECH32M_CONST)) return SEGWIT_INVALID_CHECKSUM;
+
+    uint32_t acc = 0;
+    int bits = 0;
+    size_t count = 0;
+    for (size_t i = 1; i < word_count - BECH32_CHECKSUM_LENGTH; i++) {
+        acc = (acc << 5) | words[i];
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            if (count == SEGWIT_MAX_PROGRAM) return SEGWIT_INVALID_PROGRAM;
+            program[count++] = (uint8_t)(acc >> bits);
+        }
+    }
+    if (bits >= 5 || (acc & ((1u << bits) - 1)) != 0) return SEGWIT_INVALID_PADDING;
+    if (count < 2 || (version == 0 && count != 20 && count != 32)) return SEGWIT_INVALID_PROGRAM;
+
+    memcpy(hrp, lower, separator);
+    hrp[separator] = '\0';
+    *witness_version = version;
+    *program_len = count;
+    return SEGWIT_VALID;
+}
+
+int segwit_address_decode(const char *address, char *hrp, size_t hrp_size, int *witness_version,
+                          uint8_t *program, size_t *program_len) {
+    return segwit_address_check(address, hrp, hrp_size, witness_version, program, program_len) == SEGWIT_VALID ? 0 : -1;
+}
@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include "keygen.h"
+#include "crypto.h"
+#include "address.h"
+#include "ec.h"
+#include "rng.h"
+#include "sha256.h"
+#include "ripemd160.h"
+#include "sha512.h"
+#include "bip39.h"
+#include "pool.h"
+#include "utils.h"
+#include "signature.h"
+#include "cpu.h"
+#ifdef CPU_X86
+#include <x86intrin.h>
+#endif
+
+#define BENCH_MAX_BATCH 256
+#define BENCH_DEFAULT_MIN_MS 100
+#define BENCH_PIPELINE_START 4096
+
+typedef struct {
+    private_key_t private_keys[BENCH_MAX_BATCH];
+    public_key_t public_keys[BENCH_MAX_BATCH];
+    uint8_t scalars[BENCH_MAX_BATCH * EC_SCALAR_SIZE];
+    ec_point_t points[BENCH_MAX_BATCH];
+    ec_point_t products[BENCH_MAX_BATCH];
+    uint64_t field[BENCH_MAX_BATCH * 4];
+    const uint8_t *keys[BENCH_MAX_BATCH];
+    const uint8_t *inner[BENCH_MAX_BATCH];
+    uint8_t sha_digests[BENCH_MAX_BATCH * SHA256_DIGEST_SIZE];
+    uint8_t ripemd_digests[BENCH_MAX_BATCH * RIPEMD160_DIGEST_SIZE];
+    bitcoin_address_t legacy[BENCH_MAX_BATCH];
+    bitcoin_address_t segwit[BENCH_MAX_BATCH];
+    char strings[BENCH_MAX_BATCH * MAX_ADDRESS_STRING_SIZE];
+    char record[KEYGEN_RECORD_MAX];
+    const char *mnemonics[BENCH_MAX_BATCH];
+    uint8_t seeds[BENCH_MAX_BATCH * BIP39_SEED_SIZE];
+    uint8_t hashes[BENCH_MAX_BATCH * SIGNATURE_HASH_SIZE];
+    uint8_t aux[BENCH_MAX_BATCH * SCHNORR_AUX_SIZE];
+    uint8_t signatures[BENCH_MAX_BATCH * SIGNATURE_SIZE];
+    uint8_t schnorr_keys[BENCH_MAX_BATCH * SCHNORR_PUBLIC_KEY_SIZE];
+    uint8_t schnorr_signatures[BENCH_MAX_BATCH * SIGNATURE_SIZE];
+    keygen_options_t options;
+} bench_state_t;
+
+typedef int (*bench_stage_fn)(bench_state_t *state, size_t batch);
+
+typedef struct {
+    const char *name;
+    bench_stage_fn fn;
+} bench_stage_t;
+
+typedef struct {
+    bench_stage_fn fn;
+    bench_state_t *states;
+    size_t batch;
+    size_t rounds;
+} bench_run_t;
+
+typedef struct {
+    size_t ops;
+    double elapsed_ns;
+    double cycles;
+} bench_result_t;
+
+static int first_result = 1;
+
+static unsigned long long read_cycles(void) {
+#ifdef CPU_X86
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int stage_rng(bench_state_t *state, size_t batch) {
+    return rng_scalars(state->scalars, batch);
+}
+
+static int stage_scalar_mult(bench_state_t *state, size_t batch) {
+    return ec_mult_gen_batch(state->points, state->scalars, batch);
+}
+
+static int stage_point_mult(bench_state_t *state, size_t batch) {
+    for (size_t i = 0; i < batch; i++) {
+        if (ec_mult(&state->products[i], &state->points[i], state->scalars + i * EC_SCALAR_SIZE) != 0) return -1;
+    }
+    return 0;
+}
+
+static int stage_multi_mult(bench_state_t *state, size_t batch) {
+    return ec_mult_multi(&state->products[0], state->points, state->scalars, batch, state->scalars);
+}
+
+static int stage_batch_inversion(bench_state_t *state, size_t batch) {
+    return ec_field_inv_batch(state->field, batch);
+}
+
+static int stage_sha256(bench_state_t *state, size_t batch) {
+    sha256_batch(state->keys, COMPRESSED_PUBLIC_KEY_SIZE, batch, state->sha_digests);
+    return 0;
+}
+
+static int stage_ripemd160(bench_state_t *state, size_t batch) {
+    ripemd160_batch(state->inner, SHA256_DIGEST_SIZE, batch, state->ripemd_digests);
+    return 0;
+}
+
+static int stage_base58(bench_state_t *state, size_t batch) {
+    return encode_addresses(state->legacy, batch, ADDRESS_TYPE_P2PKH, 0, state->strings, MAX_ADDRESS_STRING_SIZE);
+}
+
+static int stage_bech32(bench_state_t *state, size_t batch) {
+    return encode_addresses(state->segwit, batch, ADDRESS_TYPE_P2WPKH, 0, state->strings, MAX_ADDRESS_STRING_SIZE);
+}
+
+static int stage_format(bench_state_t *state, size_t batch) {
+    for (size_t i = 0; i < batch; i++) {
+        if (format_key_information(&state->private_keys[i], &state->public_keys[i], &state->legacy[i],
+                                   &state->options, state->record, sizeof(state->record)) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int stage_bip39_seed(bench_state_t *state, size_t batch) {
+    return bip39_mnemonic_to_seed_batch(state->mnemonics, NULL, batch, state->seeds);
+}
+
+static int stage_ecdsa_sign(bench_state_t *state, size_t batch) {
+    return ecdsa_sign_batch(state->private_keys, state->hashes, state->signatures, batch);
+}
+
+static int stage_schnorr_sign(bench_state_t *state, size_t batch) {
+    return schnorr_sign_batch(state->private_keys, state->hashes, state->aux, state->signatures, batch);
+}
+
+static int stage_schnorr_verify(bench_state_t *state, size_t batch) {
+    for (size_t i = 0; i < batch; i++) {
+        if (schnorr_verify(state->schnorr_keys + i * SCHNORR_PUBLIC_KEY_SIZE, state->hashes + i * SIGNATURE_HASH_SIZE,
+                           state->schnorr_signatures + i * SIGNATURE_SIZE) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int stage_batch_verify(bench_state_t *state, size_t batch) {
+    return schnorr_verify_batch(state->schnorr_keys, state->hashes, state->schnorr_signatures, batch);
+}
+
+static const bench_stage_t bench_stages[] = {
+    {"rng", stage_rng},
+    {"scalar_mult", stage_scalar_mult},
+    {"point_mult", stage_point_mult},
+    {"multi_mult", stage_multi_mult},
+    {"batch_inversion", stage_batch_inversion},
+    {"sha256", stage_sha256},
+    {"ripemd160", stage_ripemd160},
+    {"base58", stage_base58},
+    {"bech32", stage_bech32},
+    {"format", stage_format},
+    {"bip39_seed", stage_bip39_seed},
+    {"ecdsa_sign", stage_ecdsa_sign},
+    {"schnorr_sign", stage_schnorr_sign},
+    {"schnorr_verify", stage_schnorr_verify},
+    {"batch_verify", stage_batch_verify}
+};
+
+static const size_t bench_batches[] = {1, 16, 64, 256};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int bench_state_init(bench_state_t *state) {
+    memset(state, 0, sizeof(*state));
+    state->options.format = OUTPUT_FORMAT_WIF;
+    state->options.with_address = 1;
+    state->options.compressed = 1;
+    state->options.quiet = 1;
+    state->options.address_type = ADDRESS_TYPE_P2PKH;
+
+    if (generate_secure_private_keys(state->private_keys, BENCH_MAX_BATCH) != 0) return -1;
+    if (derive_public_keys_batch(state->private_keys, state->public_keys, BENCH_MAX_BATCH, 1) != 0) return -1;
+    if (create_p2pkh_addresses(state->public_keys, state->legacy, BENCH_MAX_BATCH, 0) != 0) return -1;
+    if (create_p2wpkh_addresses(state->public_keys, state->segwit, BENCH_MAX_BATCH) != 0) return -1;
+    for (size_t i = 0; i < BENCH_MAX_BATCH; i++) {
+        state->mnemonics[i] = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+    }
+    for (size_t i = 0; i < BENCH_MAX_BATCH; i++) {
+        memcpy(state->scalars + i * EC_SCALAR_SIZE, state->private_keys[i].data, EC_SCALAR_SIZE);
+    }
+    if (ec_mult_gen_batch(state->points, state->scalars, BENCH_MAX_BATCH) != 0) return -1;
+    if (rng_bytes(state->hashes, sizeof(state->hashes)) != 0 || rng_bytes(state->aux, sizeof(state->aux)) != 0) return -1;
+    if (schnorr_sign_batch(state->private_keys, state->hashes, state->aux, state->schnorr_signatures, BENCH_MAX_BATCH) != 0) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < BENCH_MAX_BATCH; i++) {
+        if (schnorr_public_key(&state->private_keys[i], state->schnorr_keys + i * SCHNORR_PUBLIC_KEY_SIZE) != 0) return -1;
+        memcpy(state->field + i * 4, state->points[i].x, sizeof(state->points[i].x));
+        state->keys[i] = state->public_keys[i].data;
+        state->inner[i] = state->sha_digests + i * SHA256_DIGEST_SIZE;
+    }
+    return 0;
+}
+
+static int bench_task(size_t task, int worker, void *context) {
+    bench_run_t *run = context;
+    bench_state_t *state = &run->states[task];
+    (void)worker;
+
+    for (size_t r = 0; r < run->rounds; r++) {
+        if (run->fn(state, run->batch) != 0) return -1;
+    }
+    return 0;
+}
+
+static int measure_stage(bench_stage_fn fn, bench_state_t *states, size_t batch, int threads,
+                         double min_ns, bench_result_t *result) {
+    bench_run_t run = {fn, states, batch, 1};
+
+    for (;;) {
+        double start = now_ns();
+        unsigned long long tsc = read_cycles();
+        if (pool_run(threads, (size_t)threads, bench_task, &run) != 0) return -1;
+        double elapsed = now_ns() - start;
+        double cycles = (double)(read_cycles() - tsc) * threads;
+
+        if (elapsed >= min_ns) {
+            result->ops = run.rounds * batch * (size_t)threads;
+            result->elapsed_ns = elapsed;
+            result->cycles = cycles;
+            return 0;
+        }
+        run.rounds *= 2;
+    }
+}
+
+static int measure_pipeline(int threads, double min_ns, bench_result_t *result) {
+    keygen_options_t options;
+    int count = BENCH_PIPELINE_START * threads;
+
+    memset(&options, 0, sizeof(options));
+    options.format = OUTPUT_FORMAT_HEX;
+    options.with_address = 1;
+    options.compressed = 1;
+    options.quiet = 1;
+    options.threads = threads;
+    options.address_type = ADDRESS_TYPE_P2PKH;
+
+    for (;;) {
+        options.count = count;
+        double start = now_ns();
+        unsigned long long tsc = read_cycles();
+        if (generate_multiple_keys(count, &options) != 0) return -1;
+        double elapsed = now_ns() - start;
+        double cycles = (double)(read_cycles() - tsc) * threads;
+
+        if (elapsed >= min_ns || count > (1 << 28)) {
+            result->ops = (size_t)count;
+            result->elapsed_ns = elapsed;
+            result->cycles = cycles;
+            return 0;
+        }
+        count *= 2;
+    }
+}
+
+static void print_result(const char *stage, size_t batch, int threads, const bench_result_t *result) {
+    double ops = (double)result->ops;
+    char cycles[32];
+
+    if (result->cycles > 0) {
+        snprintf(cycles, sizeof(cycles), "%.1f", result->cycles / ops);
+    } else {
+        snprintf(cycles, sizeof(cycles), "null");
+    }
+    printf("%s    {\"stage\": \"%s\", \"batch\": %zu, \"threads\": %d, \"ops\": %zu, "
+           "\"ns_per_op\": %.2f, \"cycles_per_op\": %s, \"keys_per_sec\": %.0f}",
+           first_result ? "" : ",\n", stage, batch, threads, result->ops,
+           result->elapsed_ns / ops, cycles, ops * 1e9 / result->elapsed_ns);
+    first_result = 0;
+    fflush(stdout);
+}
+
+static void print_bench_usage(const char *program_name) {
+    printf("Usage: %s [OPTIONS]\n", program_name);
+    printf("Time each key generation stage and print the results as JSON\n\n");
+    printf("Options:\n");
+    printf("  -s, --stage NAME       Run only NAME (rng, scalar_mult, point_mult, multi_mult,\n");
+    printf("                         batch_inversion, sha256, ripemd160, base58, bech32, format,\n");
+    printf("                         bip39_seed, ecdsa_sign, schnorr_sign, schnorr_verify,\n");
+    printf("                         batch_verify, pipeline)\n");
+    printf("  -m, --min-time MS      Run each measurement for at least MS milliseconds (default: %d)\n", BENCH_DEFAULT_MIN_MS);
+    printf("  -j, --threads NUM      Sweep thread counts up to NUM (default: all cores)\n");
+    printf("  -f, --field NAME       Field arithmetic backend (auto, 10x26, 5x52, mulx-adx)\n");
+    printf("  -t, --table-bits NUM   Window size of the fixed-base table, %d-%d (default: %d)\n",
+           EC_MIN_TABLE_BITS, EC_MAX_TABLE_BITS, EC_DEFAULT_TABLE_BITS);
+    printf("  -h, --help             Show this help message\n");
+}
+
+int main(int argc, char *argv[]) {
+    static struct option long_options[] = {
+        {"stage", required_argument, 0, 's'},
+        {"min-time", required_argument, 0, 'm'},
+        {"threads", required_argument, 0, 'j'},
+        {"field", required_argument, 0, 'f'},
+        {"table-bits", required_argument, 0, 't'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    const char *only = NULL;
+    double min_ns = BENCH_DEFAULT_MIN_MS * 1e6;
+    int max_threads = pool_cpu_count();
+    int thread_counts[32];
+    int sweep = 0;
+    ec_field_t field = EC_FIELD_AUTO;
+    unsigned int table_bits = EC_DEFAULT_TABLE_BITS;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "s:m:j:f:t:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 's':
+                only = optarg;
+                break;
+            case 'm':
+                if (atoi(optarg) <= 0) {
+                    fprintf(stderr, "Invalid minimum time: %s\n", optarg);
+                    return 1;
+                }
+                min_ns = atoi(optarg) * 1e6;
+                break;
+            case 'j':
+                max_threads = atoi(optarg);
+                if (max_threads <= 0 || max_threads > POOL_MAX_THREADS) {
+                    fprintf(stderr, "Invalid thread count: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'f':
+                field = EC_FIELD_COUNT;
+                for (int f = EC_FIELD_AUTO; f < EC_FIELD_COUNT; f++) {
+                    if (string_equals(optarg, ec_field_name((ec_field_t)f))) {
+                        field = (ec_field_t)f;
+                    }
+                }
+                if (field == EC_FIELD_COUNT || !ec_field_supported(field)) {
+                    fprintf(stderr, "Unsupported field backend: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 't':
+                table_bits = (unsigned int)atoi(optarg);
+                if (table_bits < EC_MIN_TABLE_BITS || table_bits > EC_MAX_TABLE_BITS) {
+                    fprintf(stderr, "Invalid table bits: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'h':
+                print_bench_usage(argv[0]);
+                return 0;
+            default:
+                print_bench_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    for (int t = 1; t < max_threads; t *= 2) {
+        thread_counts[sweep++] = t;
+    }
+    thread_counts[sweep++] = max_threads;
+
+    if (ec_field_select(field) != 0 || crypto_configure(table_bits, NULL) != 0 || crypto_init() != 0) {
+        fprintf(stderr, "Failed to initialize crypto subsystem\n");
+        return 1;
+    }
+
+    keygen_options_t sink;
+    memset(&sink, 0, sizeof(sink));
+    sink.output_path = "/dev/null";
+    bench_state_t *states = malloc(sizeof(bench_state_t) * (size_t)max_threads);
+    int result = 0;
+
+    if (!states || keygen_output_open(&sink) != 0) {
+        fprintf(stderr, "Failed to set up benchmark\n");
+        free(states);
+        crypto_cleanup();
+        return 1;
+    }
+    for (int t = 0; t < max_threads && result == 0; t++) {
+        result = bench_state_init(&states[t]);
+    }
+
+    printf("{\n  \"cpus\": %d,\n  \"sha256\": \"%s\",\n  \"ripemd160\": \"%s\",\n  \"sha512\": \"%s\",\n"
+           "  \"field\": \"%s\",\n  \"table_bits\": %u,\n  \"results\": [\n",
+           pool_cpu_count(), sha256_impl_name(sha256_active()), ripemd160_impl_name(ripemd160_active()),
+           sha512_impl_name(sha512_active()), ec_field_name(ec_field_active()),
+           ec_table_bits());
+
+    for (size_t s = 0; result == 0 && s < sizeof(bench_stages) / sizeof(bench_stages[0]); s++) {
+        if (only && !string_equals(only, bench_stages[s].name)) continue;
+        for (size_t b = 0; result == 0 && b < sizeof(bench_batches) / sizeof(bench_batches[0]); b++) {
+            for (int t = 0; result == 0 && t < sweep; t++) {
+                bench_result_t measured;
+                result = measure_stage(bench_stages[s].fn, states, bench_batches[b], thread_counts[t], min_ns, &measured);
+                if (result == 0) {
+                    print_result(bench_stages[s].name, bench_batches[b], thread_counts[t], &measured);
+                }
+            }
+        }
+    }
+
+    if (!only || string_equals(only, "pipeline")) {
+        for (int t = 0; result == 0 && t < sweep; t++) {
+            bench_result_t measured;
+            result = measure_pipeline(thread_counts[t], min_ns, &measured);
+            if (result == 0) {
+                print_result("pipeline", KEYGEN_BLOCK_SIZE, thread_counts[t], &measured);
+            }
+        }
+    }
+
+    printf("\n  ]\n}\n");
+
+    if (result != 0) {
+        fprintf(stderr, "Benchmark failed\n");
+    }
+
+    for (int t = 0; t < max_threads; t++) {
+        secure_zero_memory(&states[t], sizeof(states[t]));
+    }
+    free(states);
+    keygen_output_close();
+    crypto_cleanup();
+    return result == 0 ? 0 : 1;
+}
@@ -0,0 +1,310 @@
+#include <stdio.h>
+#include <string.h>
+#include "bip32.h"
+#include "address.h"
+#include "ec.h"
+#include "scalar.h"
+#include "sha512.h"
+#include "ripemd160.h"
+#include "utils.h"
+
+static uint32_t read_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void write_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static int node_set_public(bip32_node_t *node) {
+    ec_point_t point;
+    size_t length;
+
+    if (ec_mult_gen(&point, node->private_key.data) != 0) return -1;
+    return ec_point_serialize(&point, node->public_key, &length, 1);
+}
+
+static void node_fingerprint(const bip32_node_t *node, uint8_t *fingerprint) {
+    uint8_t digest[HASH160_SIZE];
+
+    hash160(node->public_key, COMPRESSED_PUBLIC_KEY_SIZE, digest);
+    memcpy(fingerprint, digest, 4);
+}
+
+int bip32_from_seed(const uint8_t *seed, size_t seed_len, int testnet, bip32_node_t *node) {
+    if (!seed || !node || seed_len < 16 || seed_len > 64) return -1;
+
+    uint8_t digest[SHA512_DIGEST_SIZE];
+    int result = -1;
+
+    memset(node, 0, sizeof(*node));
+    hmac_sha512((const uint8_t *)BIP32_SEED_KEY, strlen(BIP32_SEED_KEY), seed, seed_len, digest);
+
+    if (scalar_is_valid_b32(digest)) {
+        memcpy(node->private_key.data, digest, PRIVATE_KEY_SIZE);
+        memcpy(node->chain_code, digest + 32, BIP32_CHAIN_CODE_SIZE);
+        node->has_private = 1;
+        node->testnet = testnet;
+        result = node_set_public(node);
+    }
+
+    secure_zero_memory(digest, sizeof(digest));
+    if (result != 0) {
+        bip32_node_wipe(node);
+    }
+    return result;
+}
+
+int bip32_parse(const char *xkey, bip32_node_t *node) {
+    if (!xkey || !node) return -1;
+
+    uint8_t data[BIP32_SERIALIZED_SIZE];
+    int result = -1;
+
+    memset(node, 0, sizeof(*node));
+    if (base58check_decode(xkey, data, sizeof(data)) != BIP32_SERIALIZED_SIZE) {
+        return -1;
+    }
+
+    uint32_t version = read_be32(data);
+    node->depth = data[4];
+    memcpy(node->parent_fingerprint, data + 5, 4);
+    node->child_number = read_be32(data + 9);
+    memcpy(node->chain_code, data + 13, BIP32_CHAIN_CODE_SIZE);
+    node->testnet = version == BIP32_VERSION_TPRV || version == BIP32_VERSION_TPUB;
+
+    if (node->depth == 0 && (read_be32(node->parent_fingerprint) != 0 || node->child_number != 0)) {
+        result = -1;
+    } else if (version == BIP32_VERSION_XPRV || version == BIP32_VERSION_TPRV) {
+        if (data[45] == 0x00 && scalar_is_valid_b32(data + 46)) {
+            memcpy(node->private_key.data, data + 46, PRIVATE_KEY_SIZE);
+            node->has_private = 1;
+            result = node_set_public(node);
+        }
+    } else if (version == BIP32_VERSION_XPUB || version == BIP32_VERSION_TPUB) {
+        ec_point_t point;
+        if (ec_point_parse(&point, data + 45, COMPRESSED_PUBLIC_KEY_SIZE) == 0) {
+            memcpy(node->public_key, data + 45, COMPRESSED_PUBLIC_KEY_SIZE);
+            result = 0;
+        }
+    }
+
+    secure_zero_memory(data, sizeof(data));
+    if (result != 0) {
+        bip32_node_wipe(node);
+    }
+    return result;
+}
+
+int bip32_serialize(const bip32_node_t *node, int private, char *output, size_t output_size) {
+    if (!node || !output) return -1;
+    if (private && !node->has_private) return -1;
+
+    uint8_t data[BIP32_SERIALIZED_SIZE];
+    uint32_t version;
+
+    if (private) {
+        version = node->testnet ? BIP32_VERSION_TPRV : BIP32_VERSION_XPRV;
+    } else {
+        version = node->testnet ? BIP32_VERSION_TPUB : BIP32_VERSION_XPUB;
+    }
+
+    write_be32(data, version);
+    data[4] = node->depth;
+    memcpy(data + 5, node->parent_fingerprint, 4);
+    write_be32(data + 9, node->child_number);
+    memcpy(data + 13, node->chain_code, BIP32_CHAIN_CODE_SIZE);
+    if (private) {
+        data[45] = 0x00;
+        memcpy(data + 46, node->private_key.data, PRIVATE_KEY_SIZE);
+    } else {
+        memcpy(data + 45, node->public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+    }
+
+    int result = base58check_encode(data, sizeof(data), output, output_size);
+    secure_zero_memory(data, sizeof(data));
+    return result;
+}
+
+int bip32_neuter(const bip32_node_t *node, bip32_node_t *public_node) {
+    if (!node || !public_node) return -1;
+
+    *public_node = *node;
+    secure_zero_memory(&public_node->private_key, sizeof(public_node->private_key));
+    public_node->has_private = 0;
+    return 0;
+}
+
+int bip32_derive_child(const bip32_node_t *parent, uint32_t index, bip32_node_t *child) {
+    return bip32_derive_children(parent, index, 1, child);
+}
+
+int bip32_derive_children(const bip32_node_t *parent, uint32_t start, size_t count, bip32_node_t *children) {
+    if (!parent || !children) return -1;
+    if (parent->depth == BIP32_MAX_PATH_DEPTH) return -1;
+    if (count > 0 && (uint64_t)start + count - 1 > 0xFFFFFFFFULL) return -1;
+
+    hmac_sha512_ctx_t base, ctx;
+    ec_point_t parent_point;
+    ec_point_t points[BIP32_BATCH_SIZE];
+    uint8_t tweaks[BIP32_BATCH_SIZE * SCALAR_SIZE];
+    uint8_t digest[SHA512_DIGEST_SIZE];
+    uint8_t data[1 + PRIVATE_KEY_SIZE + 4];
+    uint8_t fingerprint[4];
+    size_t length;
+    int result = 0;
+
+    if (ec_point_parse(&parent_point, parent->public_key, COMPRESSED_PUBLIC_KEY_SIZE) != 0) return -1;
+    node_fingerprint(parent, fingerprint);
+    hmac_sha512_init(&base, parent->chain_code, BIP32_CHAIN_CODE_SIZE);
+
+    for (size_t offset = 0; offset < count && result == 0; offset += BIP32_BATCH_SIZE) {
+        size_t n = count - offset < BIP32_BATCH_SIZE ? count - offset : BIP32_BATCH_SIZE;
+
+        for (size_t i = 0; i < n; i++) {
+            uint32_t index = start + (uint32_t)(offset + i);
+            bip32_node_t *child = &children[offset + i];
+
+            if (index & BIP32_HARDENED) {
+                if (!parent->has_private) {
+                    result = -1;
+                    break;
+                }
+                data[0] = 0x00;
+                memcpy(data + 1, parent->private_key.data, PRIVATE_KEY_SIZE);
+            } else {
+                memcpy(data, parent->public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+            }
+            write_be32(data + COMPRESSED_PUBLIC_KEY_SIZE, index);
+
+            ctx = base;
+            hmac_sha512_update(&ctx, data, sizeof(data));
+            hmac_sha512_final(&ctx, digest);
+            if (!scalar_is_valid_b32(digest)) {
+                result = -1;
+                break;
+            }
+
+            memset(child, 0, sizeof(*child));
+            memcpy(child->chain_code, digest + 32, BIP32_CHAIN_CODE_SIZE);
+            memcpy(child->parent_fingerprint, fingerprint, 4);
+            child->child_number = index;
+            child->depth = parent->depth + 1;
+            child->testnet = parent->testnet;
+            if (parent->has_private) {
+                if (scalar_add_b32(child->private_key.data, digest, parent->private_key.data) != 0) {
+                    result = -1;
+                    break;
+                }
+                child->has_private = 1;
+            }
+
+            points[i] = parent_point;
+            memcpy(tweaks + i * SCALAR_SIZE, digest, SCALAR_SIZE);
+        }
+
+        if (result == 0 && ec_point_tweak_add_batch(points, tweaks, n) != 0) {
+            result = -1;
+        }
+        for (size_t i = 0; i < n && result == 0; i++) {
+            result = ec_point_serialize(&points[i], children[offset + i].public_key, &length, 1);
+        }
+    }
+
+    secure_zero_memory(&base, sizeof(base));
+    secure_zero_memory(&ctx, sizeof(ctx));
+    secure_zero_memory(tweaks, sizeof(tweaks));
+    secure_zero_memory(digest, sizeof(digest));
+    secure_zero_memory(data, sizeof(data));
+    if (result != 0) {
+        secure_zero_memory(children, sizeof(bip32_node_t) * count);
+    }
+    return result;
+}
+
+int bip32_parse_path(const char *path, uint32_t *indices, size_t max_indices, size_t *count) {
+    if (!path || !indices || !count) return -1;
+
+    const char *p = path;
+    size_t n = 0;
+
+    if (*p == 'm') {
+        p++;
+        if (*p == '\0') {
+            *count = 0;
+            return 0;
+        }
+        if (*p != '/') return -1;
+        p++;
+    }
+
+    for (;;) {
+        uint64_t value = 0;
+        const char *digits = p;
+
+        while (*p >= '0' && *p <= '9') {
+            value = value * 10 + (uint64_t)(*p - '0');
+            if (value >= BIP32_HARDENED) return -1;
+            p++;
+        }
+        if (p == digits || n == max_indices) return -1;
+        if (*p == '\'' || *p == 'h' || *p == 'H') {
+            value |= BIP32_HARDENED;
+            p++;
+        }
+        indices[n++] = (uint32_t)value;
+
+        if (*p == '\0') break;
+        if (*p != '/') return -1;
+        p++;
+    }
+
+    *count = n;
+    return 0;
+}
+
+int bip32_format_path(const uint32_t *indices, size_t count, char *output, size_t output_size) {
+    if (!indices || !output || output_size < 2) return -1;
+
+    size_t used = 1;
+    output[0] = 'm';
+    output[1] = '\0';
+
+    for (size_t i = 0; i < count; i++) {
+        int written = snprintf(output + used, output_size - used, "/%u%s",
+                               indices[i] & ~BIP32_HARDENED, (indices[i] & BIP32_HARDENED) ? "'" : "");
+        if (written < 0 || (size_t)written >= output_size - used) return -1;
+        used += (size_t)written;
+    }
+
+    return 0;
+}
+
+int bip32_derive_path(const bip32_node_t *root, const uint32_t *indices, size_t count, bip32_node_t *node) {
+    if (!root || !node || (count > 0 && !indices)) return -1;
+
+    bip32_node_t current = *root;
+    bip32_node_t next;
+
+    for (size_t i = 0; i < count; i++) {
+        if (bip32_derive_child(&current, indices[i], &next) != 0) {
+            bip32_node_wipe(&current);
+            return -1;
+        }
+        current = next;
+        bip32_node_wipe(&next);
+    }
+
+    *node = current;
+    bip32_node_wipe(&current);
+    return 0;
+}
+
+void bip32_node_wipe(bip32_node_t *node) {
+    if (node) {
+        secure_zero_memory(node, sizeof(*node));
+    }
+}
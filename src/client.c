@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include "server.h"
+#include "utils.h"
+
+static void print_client_usage(const char *program_name) {
+    printf("Usage: %s [OPTIONS] SOCKET XKEY\n", program_name);
+    printf("Request addresses from a btc_keygen --serve daemon\n\n");
+    printf("Options:\n");
+    printf("  -c, --count NUM        Request NUM addresses (default: 1)\n");
+    printf("  -s, --start INDEX      First child index when registering the key (default: 0)\n");
+    printf("  -v, --verbose          Report the average request latency on stderr\n");
+    printf("  -h, --help             Show this help message\n");
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(int argc, char *argv[]) {
+    static struct option long_options[] = {
+        {"count", required_argument, 0, 'c'},
+        {"start", required_argument, 0, 's'},
+        {"verbose", no_argument, 0, 'v'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    long count = 1;
+    unsigned long start = 0;
+    int verbose = 0;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "c:s:vh", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'c':
+                count = atol(optarg);
+                if (count <= 0) {
+                    fprintf(stderr, "Invalid count: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 's':
+                start = strtoul(optarg, NULL, 10);
+                break;
+            case 'v':
+                verbose = 1;
+                break;
+            case 'h':
+                print_client_usage(argv[0]);
+                return 0;
+            default:
+                print_client_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (argc - optind != 2) {
+        print_client_usage(argv[0]);
+        return 1;
+    }
+
+    int fd = server_connect(argv[optind]);
+    if (fd < 0) {
+        fprintf(stderr, "Failed to connect to %s\n", argv[optind]);
+        return 1;
+    }
+
+    uint32_t wallet;
+    if (server_register(fd, argv[optind + 1], (uint32_t)start, &wallet) != 0) {
+        fprintf(stderr, "Failed to register key\n");
+        close(fd);
+        return 1;
+    }
+
+    char address[MAX_ADDRESS_STRING_SIZE];
+    uint32_t index;
+    double elapsed = 0;
+    for (long i = 0; i < count; i++) {
+        double begin = now_ns();
+        if (server_next_address(fd, wallet, &index, address, sizeof(address)) != 0) {
+            fprintf(stderr, "Failed to fetch address\n");
+            close(fd);
+            return 1;
+        }
+        elapsed += now_ns() - begin;
+        printf("%u %s\n", index, address);
+    }
+
+    if (verbose) {
+        fprintf(stderr, "%ld addresses, %.1f us/request\n", count, elapsed / (double)count / 1e3);
+    }
+
+    close(fd);
+    return 0;
+}
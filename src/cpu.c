@@ -0,0 +1,63 @@
+#include <stdint.h>
+#include <pthread.h>
+#include "cpu.h"
+#ifdef CPU_X86
+#include <cpuid.h>
+#endif
+
+static pthread_once_t cpu_once = PTHREAD_ONCE_INIT;
+static bool cpu_features[CPU_FEATURE_COUNT];
+
+static const char *cpu_feature_names[CPU_FEATURE_COUNT] = {
+    "sse4.1", "ssse3", "avx2", "avx512f", "avx512bw", "sha", "bmi2", "adx"
+};
+
+#ifdef CPU_X86
+static uint64_t read_xcr0(void) {
+    uint32_t eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+}
+
+static void cpu_detect(void) {
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int max_leaf = __get_cpuid_max(0, NULL);
+    bool os_avx = false;
+    bool os_avx512 = false;
+
+    if (max_leaf < 1) return;
+
+    __cpuid(1, eax, ebx, ecx, edx);
+    cpu_features[CPU_FEATURE_SSSE3] = (ecx >> 9) & 1;
+    cpu_features[CPU_FEATURE_SSE41] = (ecx >> 19) & 1;
+    if (((ecx >> 27) & 1) && ((ecx >> 28) & 1)) {
+        uint64_t xcr0 = read_xcr0();
+        os_avx = (xcr0 & 0x6) == 0x6;
+        os_avx512 = os_avx && (xcr0 & 0xE0) == 0xE0;
+    }
+
+    if (max_leaf < 7) return;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    cpu_features[CPU_FEATURE_AVX2] = os_avx && ((ebx >> 5) & 1);
+    cpu_features[CPU_FEATURE_BMI2] = (ebx >> 8) & 1;
+    cpu_features[CPU_FEATURE_AVX512F] = os_avx512 && ((ebx >> 16) & 1);
+    cpu_features[CPU_FEATURE_ADX] = (ebx >> 19) & 1;
+    cpu_features[CPU_FEATURE_SHA] = (ebx >> 29) & 1;
+    cpu_features[CPU_FEATURE_AVX512BW] = os_avx512 && ((ebx >> 30) & 1);
+}
+#else
+static void cpu_detect(void) {
+}
+#endif
+
+bool cpu_has(cpu_feature_t feature) {
+    if ((unsigned int)feature >= CPU_FEATURE_COUNT) return false;
+    pthread_once(&cpu_once, cpu_detect);
+    return cpu_features[feature];
+}
+
+const char *cpu_feature_name(cpu_feature_t feature) {
+    if ((unsigned int)feature >= CPU_FEATURE_COUNT) return "unknown";
+    return cpu_feature_names[feature];
+}
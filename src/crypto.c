@@ -1,111 +1,189 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include "crypto.h"
+#include "ec.h"
+#include "rng.h"
+#include "scalar.h"
 #include "address.h"
 #include "utils.h"
 
+_Static_assert(sizeof(private_key_t) == PRIVATE_KEY_SIZE, "private_key_t must be tightly packed");
+_Static_assert(PRIVATE_KEY_SIZE == EC_SCALAR_SIZE, "private keys are passed to ec_mult_gen_batch in place");
+
 static int initialized = 0;
+static unsigned int table_bits = EC_DEFAULT_TABLE_BITS;
+static const char *table_path = NULL;
+
+int crypto_configure(unsigned int bits, const char *path) {
+    if (bits != 0 && (bits < EC_MIN_TABLE_BITS || bits > EC_MAX_TABLE_BITS)) return -1;
+    
+    table_bits = bits != 0 ? bits : EC_DEFAULT_TABLE_BITS;
+    table_path = path;
+    return 0;
+}
 
 int crypto_init(void) {
     if (!initialized) {
-        srand((unsigned int)time(NULL));
+        if (rng_init() != 0) {
+            return -1;
+        }
+        if (ec_context_init(table_bits, table_path) != 0) {
+            return -1;
+        }
         initialized = 1;
     }
     return 0;
 }
 
 void crypto_cleanup(void) {
+    ec_context_cleanup();
+    rng_cleanup();
     initialized = 0;
 }
 
 int generate_secure_private_key(private_key_t *key) {
     if (!key) return -1;
     
-    for (int i = 0; i < PRIVATE_KEY_SIZE; i++) {
-        key->data[i] = (uint8_t)(rand() % 256);
-    }
+    return rng_scalars(key->data, 1);
+}
+
+int generate_secure_private_keys(private_key_t *keys, size_t count) {
+    if (!keys) return -1;
     
-    return 0;
+    return rng_scalars((uint8_t *)keys, count);
 }
 
 int validate_private_key(const private_key_t *key) {
     if (!key) return -1;
     
-    for (int i = 0; i < PRIVATE_KEY_SIZE; i++) {
-        if (key->data[i] != 0) return 0;
-    }
-    
-    return -1;
+    return scalar_is_valid_b32(key->data) ? 0 : -1;
 }
 
-int derive_public_key(const private_key_t *private_key, public_key_t *public_key) {
+static int derive_serialized_public_key(const private_key_t *private_key, public_key_t *public_key, int compressed) {
     if (!private_key || !public_key) return -1;
     
-    public_key->data[0] = 0x04;
-    for (int i = 1; i < PUBLIC_KEY_SIZE; i++) {
-        public_key->data[i] = (uint8_t)(rand() % 256);
+    ec_point_t point;
+    size_t length = 0;
+    
+    if (ec_mult_gen(&point, private_key->data) != 0) {
+        return -1;
+    }
+    
+    if (ec_point_serialize(&point, public_key->data, &length, compressed) != 0) {
+        return -1;
     }
-    public_key->length = PUBLIC_KEY_SIZE;
+    public_key->length = length;
     
     return 0;
 }
 
+int derive_public_key(const private_key_t *private_key, public_key_t *public_key) {
+    return derive_serialized_public_key(private_key, public_key, 0);
+}
+
 int derive_compressed_public_key(const private_key_t *private_key, public_key_t *public_key) {
-    if (!private_key || !public_key) return -1;
-    
-    public_key->data[0] = 0x02;
-    for (int i = 1; i < COMPRESSED_PUBLIC_KEY_SIZE; i++) {
-        public_key->data[i] = (uint8_t)(rand() % 256);
+    return derive_serialized_public_key(private_key, public_key, 1);
+}
+
+int derive_public_keys_batch(const private_key_t *private_keys, public_key_t *public_keys, size_t count, int compressed) {
+    if (!private_keys || !public_keys) return -1;
+    
+    ec_point_t points[EC_BATCH_SIZE];
+    int result = 0;
+    
+    for (size_t base = 0; base < count; base += EC_BATCH_SIZE) {
+        size_t n = count - base < EC_BATCH_SIZE ? count - base : EC_BATCH_SIZE;
+        
+        if (ec_mult_gen_batch(points, private_keys[base].data, n) != 0) {
+            result = -1;
+            break;
+        }
+        
+        for (size_t i = 0; i < n; i++) {
+            size_t length = 0;
+            public_key_t *public_key = &public_keys[base + i];
+            
+            if (ec_point_serialize(&points[i], public_key->data, &length, compressed) != 0) {
+                public_key->length = 0;
+                result = -1;
+                continue;
+            }
+            public_key->length = length;
+        }
     }
-    public_key->length = COMPRESSED_PUBLIC_KEY_SIZE;
     
-    return 0;
+    return result;
 }
 
-int generate_bitcoin_address(const public_key_t *public_key, bitcoin_address_t *address) {
-    if (!public_key || !address) return -1;
+int public_key_tweak_mul(const public_key_t *public_key, const uint8_t *tweak, public_key_t *result) {
+    if (!public_key || !tweak || !result || !scalar_is_valid_b32(tweak)) return -1;
     
-    address->data[0] = VERSION_BYTE_MAINNET;
-    for (int i = 1; i < 21; i++) {
-        address->data[i] = (uint8_t)(rand() % 256);
-    }
+    ec_point_t point, product;
+    size_t length = 0;
     
-    for (int i = 21; i < 25; i++) {
-        address->data[i] = (uint8_t)(rand() % 256);
+    if (ec_point_parse(&point, public_key->data, public_key->length) != 0 ||
+        ec_mult(&product, &point, tweak) != 0 ||
+        ec_point_serialize(&product, result->data, &length, public_key->length == COMPRESSED_PUBLIC_KEY_SIZE) != 0) {
+        return -1;
     }
+    result->length = length;
     
-    address->length = 25;
     return 0;
 }
 
-int private_key_to_wif(const private_key_t *key, char *wif, size_t wif_size) {
+int generate_bitcoin_address(const public_key_t *public_key, bitcoin_address_t *address) {
+    if (!public_key || !address) return -1;
+    
+    return create_p2pkh_address(public_key, address);
+}
+
+int encode_wif(const private_key_t *key, int compressed, int testnet, char *wif, size_t wif_size) {
     if (!key || !wif || wif_size < WIF_SIZE) return -1;
     
-    char hex_key[65];
-    if (bytes_to_hex(key->data, PRIVATE_KEY_SIZE, hex_key, sizeof(hex_key)) != 0) {
-        return -1;
-    }
+    uint8_t payload[WIF_PAYLOAD_COMPRESSED_SIZE];
+    size_t payload_len = compressed ? WIF_PAYLOAD_COMPRESSED_SIZE : WIF_PAYLOAD_SIZE;
     
-    snprintf(wif, wif_size, "5%s", hex_key);
-    return 0;
+    payload[0] = testnet ? WIF_VERSION_TESTNET : WIF_VERSION_MAINNET;
+    memcpy(payload + 1, key->data, PRIVATE_KEY_SIZE);
+    payload[WIF_PAYLOAD_SIZE] = 0x01;
+    
+    int result = base58check_encode(payload, payload_len, wif, wif_size);
+    secure_zero_memory(payload, sizeof(payload));
+    return result;
 }
 
-int wif_to_private_key(const char *wif, private_key_t *key) {
+int wif_decode(const char *wif, private_key_t *key, int *compressed, int *testnet) {
     if (!wif || !key) return -1;
     
-    if (strlen(wif) < 66) return -1;
+    uint8_t payload[WIF_PAYLOAD_COMPRESSED_SIZE];
+    int length = base58check_decode(wif, payload, sizeof(payload));
+    int result = -1;
+    
+    if ((length == WIF_PAYLOAD_SIZE ||
+         (length == WIF_PAYLOAD_COMPRESSED_SIZE && payload[WIF_PAYLOAD_SIZE] == 0x01)) &&
+        (payload[0] == WIF_VERSION_MAINNET || payload[0] == WIF_VERSION_TESTNET)) {
+        memcpy(key->data, payload + 1, PRIVATE_KEY_SIZE);
+        if (compressed) *compressed = length == WIF_PAYLOAD_COMPRESSED_SIZE;
+        if (testnet) *testnet = payload[0] == WIF_VERSION_TESTNET;
+        result = validate_private_key(key);
+    }
     
-    const char *hex_part = wif + 1;
-    return hex_to_bytes(hex_part, key->data, PRIVATE_KEY_SIZE);
+    secure_zero_memory(payload, sizeof(payload));
+    return result;
+}
+
+int private_key_to_wif(const private_key_t *key, char *wif, size_t wif_size) {
+    return encode_wif(key, 0, 0, wif, wif_size);
+}
+
+int wif_to_private_key(const char *wif, private_key_t *key) {
+    return wif_decode(wif, key, NULL, NULL);
 }
 
 void secure_zero_memory(void *ptr, size_t size) {
     if (!ptr) return;
     
-    volatile uint8_t *p = (volatile uint8_t *)ptr;
-    while (size--) {
-        *p++ = 0;
-    }
+    memset(ptr, 0, size);
+    __asm__ __volatile__("" : : "r"(ptr) : "memory");
 } 
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ec.h"
+#include "ec_backend.h"
+#include "ec_table.h"
+#include "cpu.h"
+
+static const ec_storage_t *gen_table = NULL;
+static size_t gen_table_mapped = 0;
+static ec_gen_table_t gen_context;
+static ec_field_t active_field = EC_FIELD_AUTO;
+static const ec_backend_t *backend = NULL;
+
+static const ec_backend_t *field_backend(ec_field_t field) {
+    switch (field) {
+        case EC_FIELD_10X26:
+            return &ec_backend_10x26;
+        case EC_FIELD_5X52:
+            return &ec_backend_5x52;
+        case EC_FIELD_MULX:
+#ifdef CPU_X86_64
+            return &ec_backend_mulx;
+#else
+            break;
+#endif
+        case EC_FIELD_AUTO:
+        case EC_FIELD_COUNT:
+            break;
+    }
+    return NULL;
+}
+
+int ec_field_supported(ec_field_t field) {
+    switch (field) {
+        case EC_FIELD_AUTO:
+        case EC_FIELD_10X26:
+        case EC_FIELD_5X52:
+            return 1;
+        case EC_FIELD_MULX:
+#ifdef CPU_X86_64
+            return cpu_has(CPU_FEATURE_BMI2) && cpu_has(CPU_FEATURE_ADX);
+#else
+            return 0;
+#endif
+        case EC_FIELD_COUNT:
+            break;
+    }
+    return 0;
+}
+
+int ec_field_select(ec_field_t field) {
+    if (!ec_field_supported(field)) return -1;
+
+    if (field == EC_FIELD_AUTO) {
+        field = ec_field_supported(EC_FIELD_MULX) ? EC_FIELD_MULX : EC_FIELD_5X52;
+    }
+    active_field = field;
+    backend = field_backend(field);
+    return 0;
+}
+
+ec_field_t ec_field_active(void) {
+    return active_field;
+}
+
+const char *ec_field_name(ec_field_t field) {
+    switch (field) {
+        case EC_FIELD_AUTO:
+            return "auto";
+        case EC_FIELD_10X26:
+            return "10x26";
+        case EC_FIELD_5X52:
+            return "5x52";
+        case EC_FIELD_MULX:
+            return "mulx-adx";
+        case EC_FIELD_COUNT:
+            break;
+    }
+    return "unknown";
+}
+
+int ec_context_init(unsigned int table_bits, const char *table_path) {
+    if (table_bits == 0) {
+        table_bits = EC_DEFAULT_TABLE_BITS;
+    }
+    if (table_bits < EC_MIN_TABLE_BITS || table_bits > EC_MAX_TABLE_BITS) return -1;
+    if (!backend && ec_field_select(EC_FIELD_AUTO) != 0) return -1;
+    if (gen_table && gen_context.bits == table_bits) return 0;
+
+    ec_context_cleanup();
+
+    unsigned int windows = (256 + table_bits - 1) / table_bits;
+    unsigned int odd_entries = EC_WNAF_ENTRIES(EC_GEN_WNAF_WINDOW);
+    size_t entries = (size_t)windows * (1U << table_bits);
+    const ec_storage_t *mapped = NULL;
+    size_t mapped_size = 0;
+
+    if (table_path) {
+        mapped = ec_table_map(table_path, table_bits, windows, odd_entries, &mapped_size);
+    }
+    if (mapped) {
+        gen_table = mapped;
+        gen_table_mapped = mapped_size;
+    } else {
+        size_t bytes = (entries + 2 * odd_entries) * sizeof(ec_storage_t);
+        ec_storage_t *table = aligned_alloc(64, bytes);
+        if (!table) return -1;
+
+        if (backend->build_gen_table(table, table_bits, windows) != 0 ||
+            backend->build_odd_table(table + entries, odd_entries) != 0) {
+            free(table);
+            return -1;
+        }
+        if (table_path) {
+            ec_table_store(table_path, table, table_bits, windows, odd_entries);
+        }
+        gen_table = table;
+    }
+
+    gen_context.entries = gen_table;
+    gen_context.odd = gen_table + entries;
+    gen_context.bits = table_bits;
+    gen_context.windows = windows;
+    return 0;
+}
+
+void ec_context_cleanup(void) {
+    if (gen_table_mapped) {
+        ec_table_unmap(gen_table, gen_table_mapped);
+    } else {
+        free((void *)gen_table);
+    }
+    gen_table = NULL;
+    gen_table_mapped = 0;
+    memset(&gen_context, 0, sizeof(gen_context));
+}
+
+unsigned int ec_table_bits(void) {
+    return gen_context.bits;
+}
+
+int ec_mult_gen(ec_point_t *result, const uint8_t *scalar) {
+    if (!result || !scalar || !gen_table) return -1;
+
+    if (backend->mult_gen_batch(&gen_context, result, scalar, 1) != 0) return -1;
+    return result->infinity ? -1 : 0;
+}
+
+int ec_mult_gen_batch(ec_point_t *results, const uint8_t *scalars, size_t count) {
+    if (!results || !scalars || !gen_table) return -1;
+
+    return backend->mult_gen_batch(&gen_context, results, scalars, count);
+}
+
+int ec_field_inv_batch(uint64_t *limbs, size_t count) {
+    if (!limbs || (!backend && ec_field_select(EC_FIELD_AUTO) != 0)) return -1;
+
+    return backend->field_inv_batch(limbs, count);
+}
+
+int ec_point_tweak_add_batch(ec_point_t *points, const uint8_t *tweaks, size_t count) {
+    if (!points || !tweaks || !gen_table) return -1;
+
+    return backend->tweak_add_batch(&gen_context, points, tweaks, count);
+}
+
+int ec_mult(ec_point_t *result, const ec_point_t *point, const uint8_t *scalar) {
+    if (!result || !point || !scalar || !gen_table) return -1;
+
+    if (backend->mult_multi(&gen_context, result, point, scalar, 1, NULL) != 0) return -1;
+    return result->infinity ? -1 : 0;
+}
+
+int ec_mult_multi(ec_point_t *result, const ec_point_t *points, const uint8_t *scalars, size_t count,
+                  const uint8_t *gen_scalar) {
+    if (!result || (count > 0 && (!points || !scalars)) || !gen_table) return -1;
+
+    return backend->mult_multi(&gen_context, result, points, scalars, count, gen_scalar);
+}
+
+int ec_point_parse(ec_point_t *point, const uint8_t *input, size_t input_len) {
+    if (!point || !input || (!backend && ec_field_select(EC_FIELD_AUTO) != 0)) return -1;
+
+    return backend->point_parse(point, input, input_len);
+}
+
+static void limbs_to_bytes(uint8_t *out, const uint64_t *limbs) {
+    for (int i = 0; i < 4; i++) {
+        uint64_t v = limbs[3 - i];
+        for (int b = 0; b < 8; b++) {
+            out[i * 8 + b] = (uint8_t)(v >> (56 - 8 * b));
+        }
+    }
+}
+
+int ec_point_serialize(const ec_point_t *point, uint8_t *output, size_t *output_len, int compressed) {
+    if (!point || !output || !output_len || point->infinity) return -1;
+
+    if (compressed) {
+        output[0] = (point->y[0] & 1) ? 0x03 : 0x02;
+        limbs_to_bytes(output + 1, point->x);
+        *output_len = 33;
+    } else {
+        output[0] = 0x04;
+        limbs_to_bytes(output + 1, point->x);
+        limbs_to_bytes(output + 33, point->y);
+        *output_len = 65;
+    }
+
+    return 0;
+}
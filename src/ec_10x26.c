@@ -0,0 +1,4 @@
+#include "field_10x26.h"
+
+#define EC_BACKEND ec_backend_10x26
+#include "ec_impl.h"
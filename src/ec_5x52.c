@@ -0,0 +1,4 @@
+#include "field_5x52.h"
+
+#define EC_BACKEND ec_backend_5x52
+#include "ec_impl.h"
@@ -0,0 +1,7 @@
+#include "cpu.h"
+#ifdef CPU_X86_64
+#include "field_mulx.h"
+
+#define EC_BACKEND ec_backend_mulx
+#include "ec_impl.h"
+#endif
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ec_table.h"
+#include "sha256.h"
+
+_Static_assert(sizeof(ec_table_header_t) == EC_TABLE_HEADER_SIZE, "ec_table_header_t must match the file header");
+
+static uint64_t table_entries(unsigned int bits, unsigned int windows, unsigned int odd_entries) {
+    return (uint64_t)windows * (1U << bits) + 2 * (uint64_t)odd_entries;
+}
+
+static void table_header(ec_table_header_t *header, const ec_storage_t *table, unsigned int bits,
+                         unsigned int windows, unsigned int odd_entries) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, EC_TABLE_MAGIC, sizeof(EC_TABLE_MAGIC));
+    header->version = EC_TABLE_VERSION;
+    header->bits = bits;
+    header->windows = windows;
+    header->odd_entries = odd_entries;
+    header->storage_size = sizeof(ec_storage_t);
+    header->entries = table_entries(bits, windows, odd_entries);
+    sha256((const uint8_t *)table, (size_t)header->entries * sizeof(ec_storage_t), header->checksum);
+}
+
+int ec_table_default_path(char *path, size_t size, unsigned int bits) {
+    const char *cache = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    int written;
+
+    if (!path || size == 0) return -1;
+
+    if (cache && cache[0] == '/') {
+        written = snprintf(path, size, "%s/btc_keygen/secp256k1-%u.tbl", cache, bits);
+    } else if (home && home[0] == '/') {
+        written = snprintf(path, size, "%s/.cache/btc_keygen/secp256k1-%u.tbl", home, bits);
+    } else {
+        return -1;
+    }
+    return written > 0 && (size_t)written < size ? 0 : -1;
+}
+
+const ec_storage_t *ec_table_map(const char *path, unsigned int bits, unsigned int windows, unsigned int odd_entries,
+                                 size_t *mapped_size) {
+    ec_table_header_t expected, header;
+    struct stat st;
+    uint8_t *map;
+    uint64_t entries = table_entries(bits, windows, odd_entries);
+    size_t size = EC_TABLE_HEADER_SIZE + (size_t)entries * sizeof(ec_storage_t);
+
+    if (!path || !mapped_size) return NULL;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (size_t)st.st_size != size) {
+        close(fd);
+        return NULL;
+    }
+    map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    memcpy(&header, map, sizeof(header));
+    table_header(&expected, (const ec_storage_t *)(map + EC_TABLE_HEADER_SIZE), bits, windows, odd_entries);
+    if (memcmp(&header, &expected, sizeof(header)) != 0) {
+        munmap(map, size);
+        return NULL;
+    }
+
+    *mapped_size = size;
+    return (const ec_storage_t *)(map + EC_TABLE_HEADER_SIZE);
+}
+
+void ec_table_unmap(const ec_storage_t *table, size_t mapped_size) {
+    if (!table || mapped_size == 0) return;
+
+    munmap((uint8_t *)table - EC_TABLE_HEADER_SIZE, mapped_size);
+}
+
+static int make_parent_dirs(const char *path) {
+    char dir[EC_TABLE_PATH_MAX];
+    size_t length = strlen(path);
+
+    if (length >= sizeof(dir)) return -1;
+    memcpy(dir, path, length + 1);
+    for (char *p = dir + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(dir, 0700) != 0 && errno != EEXIST) return -1;
+        *p = '/';
+    }
+    return 0;
+}
+
+static int write_all(int fd, const void *data, size_t length) {
+    const uint8_t *p = data;
+
+    while (length > 0) {
+        ssize_t written = write(fd, p, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+int ec_table_store(const char *path, const ec_storage_t *table, unsigned int bits, unsigned int windows,
+                   unsigned int odd_entries) {
+    ec_table_header_t header;
+    char temp[EC_TABLE_PATH_MAX];
+    struct stat st;
+    int result = 0;
+
+    if (!path || !table) return -1;
+    if (lstat(path, &st) == 0 && !S_ISREG(st.st_mode)) return -1;
+    if (snprintf(temp, sizeof(temp), "%s.%ld.tmp", path, (long)getpid()) >= (int)sizeof(temp)) return -1;
+    if (make_parent_dirs(path) != 0) return -1;
+
+    int fd = open(temp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+
+    table_header(&header, table, bits, windows, odd_entries);
+    if (write_all(fd, &header, sizeof(header)) != 0 ||
+        write_all(fd, table, (size_t)header.entries * sizeof(ec_storage_t)) != 0) {
+        result = -1;
+    }
+    if (close(fd) != 0) {
+        result = -1;
+    }
+    if (result == 0 && rename(temp, path) != 0) {
+        result = -1;
+    }
+    if (result != 0) {
+        unlink(temp);
+    }
+    return result;
+}
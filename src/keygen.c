@@ -2,12 +2,181 @@
 #include <stdlib.h>
 #include <string.h>
 #include <getopt.h>
+#include <pthread.h>
+#include <limits.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "keygen.h"
 #include "crypto.h"
 #include "address.h"
+#include "bech32.h"
 #include "utils.h"
+#include "pool.h"
+#include "output.h"
+#include "bip32.h"
+#include "bip39.h"
+#include "keystore.h"
+#include "keyindex.h"
+#include "server.h"
+#include "pipeline.h"
+#include "secmem.h"
+#include "ec.h"
+#include "rng.h"
+#include "signature.h"
+#include "stats.h"
 
 #define VERSION "2.0.0"
+#define OPT_ORDERED 256
+#define OPT_IO_URING 257
+#define OPT_ADDRESS_TYPE 258
+#define OPT_DERIVE 259
+#define OPT_RANGE 260
+#define OPT_XKEY 261
+#define OPT_SEED 262
+#define OPT_SERVE 263
+#define OPT_POOL_SIZE 264
+#define OPT_MNEMONIC 265
+#define OPT_WORDS 266
+#define OPT_PASSPHRASE 267
+#define OPT_PHRASE 268
+#define OPT_DUMP 269
+#define OPT_INDEX 270
+#define OPT_LOOKUP 271
+#define OPT_INPUT 272
+#define OPT_VALIDATE 273
+#define OPT_PIPELINE 274
+#define OPT_PIN 275
+#define OPT_STATS 276
+#define OPT_PROGRESS 277
+#define OPT_TABLE_BITS 278
+#define OPT_TABLE_FILE 279
+#define OPT_SIGN 280
+#define OPT_VERIFY 281
+#define OPT_SCHNORR 282
+#define OPT_MULTISIG 283
+#define SIGNATURE_LINE_MAX 400
+
+typedef int (*keygen_block_fn)(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                               int first, int count, char *buffer, size_t buffer_size, size_t *length);
+
+typedef struct {
+    const char *data;
+    size_t size;
+    size_t *block_offsets;
+    size_t blocks;
+    int lines;
+    char *stream;
+    void *mapping;
+} keygen_input_t;
+
+typedef struct {
+    keygen_input_t input;
+    size_t *checked;
+    size_t *invalid;
+} keygen_validation_t;
+
+typedef struct {
+    bip32_node_t parent;
+    uint32_t start;
+    char path[BIP32_MAX_PATH_STRING];
+} keygen_derivation_t;
+
+typedef struct {
+    bip32_node_t parents[MULTISIG_MAX_KEYS];
+    size_t keys;
+    size_t threshold;
+    uint32_t start;
+    char path[BIP32_MAX_PATH_STRING];
+} keygen_multisig_t;
+
+typedef struct {
+    uint32_t indices[BIP32_MAX_PATH_DEPTH];
+    size_t depth;
+    char path[BIP32_MAX_PATH_STRING];
+} keygen_wallet_path_t;
+
+typedef struct {
+    char mnemonics[KEYGEN_BLOCK_SIZE][BIP39_MNEMONIC_SIZE];
+    const char *phrases[KEYGEN_BLOCK_SIZE];
+    uint8_t seeds[KEYGEN_BLOCK_SIZE * BIP39_SEED_SIZE];
+    bip32_node_t nodes[KEYGEN_BLOCK_SIZE];
+    public_key_t public_keys[KEYGEN_BLOCK_SIZE];
+    bitcoin_address_t addresses[KEYGEN_BLOCK_SIZE];
+    char address_strings[KEYGEN_BLOCK_SIZE][MAX_ADDRESS_STRING_SIZE];
+} keygen_wallet_block_t;
+
+typedef struct {
+    const keygen_options_t *options;
+    keygen_block_fn produce;
+    const void *source;
+    output_t *out;
+    output_buffer_t *buffers;
+    secmem_arena_t *arenas;
+    int count;
+    size_t window;
+    size_t next_block;
+    char *pending_data;
+    char **pending;
+    size_t *pending_length;
+    unsigned char *pending_ready;
+    pthread_mutex_t lock;
+    pthread_cond_t advanced;
+} keygen_run_t;
+
+static output_t keygen_output;
+static int keygen_output_ready = 0;
+
+static char *append_text(char *p, const char *end, const char *text, size_t length) {
+    if (!p || (size_t)(end - p) < length) return NULL;
+    memcpy(p, text, length);
+    return p + length;
+}
+
+static char *append_string(char *p, const char *end, const char *text) {
+    return append_text(p, end, text, strlen(text));
+}
+
+static char *append_hex(char *p, const char *end, const uint8_t *data, size_t length) {
+    if (!p || (size_t)(end - p) < length * 2) return NULL;
+    return p + encode_hex(data, length, p);
+}
+
+static char *append_wif(char *p, const char *end, const private_key_t *private_key, const keygen_options_t *options) {
+    if (!p || encode_wif(private_key, options->compressed, options->testnet, p, (size_t)(end - p)) != 0) return NULL;
+    return p + strlen(p);
+}
+
+int keygen_output_open(const keygen_options_t *options) {
+    if (!options) return -1;
+    if (keygen_output_ready) return 0;
+    
+    output_backend_t backend = options->io_uring ? OUTPUT_BACKEND_IO_URING : OUTPUT_BACKEND_WRITE;
+    if (output_open(&keygen_output, options->output_path, backend) != 0) {
+        return -1;
+    }
+    if (options->io_uring && keygen_output.backend != OUTPUT_BACKEND_IO_URING && !options->quiet) {
+        fprintf(stderr, "io_uring unavailable, falling back to write()\n");
+    }
+    keygen_output_ready = 1;
+    return 0;
+}
+
+int keygen_output_close(void) {
+    if (!keygen_output_ready) return 0;
+    
+    keygen_output_ready = 0;
+    return output_close(&keygen_output);
+}
+
+static output_t *keygen_writer(const keygen_options_t *options) {
+    if (!keygen_output_ready && keygen_output_open(options) != 0) {
+        return NULL;
+    }
+    return &keygen_output;
+}
 
 int generate_bitcoin_key_pair(private_key_t *private_key, public_key_t *public_key, const keygen_options_t *options) {
     if (!private_key || !public_key || !options) return -1;
@@ -16,122 +185,1631 @@ int generate_bitcoin_key_pair(private_key_t *private_key, public_key_t *public_k
         return -1;
     }
     
-    if (validate_private_key(private_key) != 0) {
-        return -1;
+    if (validate_private_key(private_key) != 0) {
+        return -1;
+    }
+    
+    if (options->compressed) {
+        if (derive_compressed_public_key(private_key, public_key) != 0) {
+            return -1;
+        }
+    } else {
+        if (derive_public_key(private_key, public_key) != 0) {
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+int generate_private_keys(private_key_t *private_keys, int *key_numbers, int first, int count, const keygen_options_t *options) {
+    if (!private_keys || !key_numbers || count <= 0 || !options) return -1;
+    
+    int generated = 0;
+    uint64_t started = stats_begin();
+    
+    if (generate_secure_private_keys(private_keys, (size_t)count) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to generate key pairs %d-%d\n", first + 1, first + count);
+        }
+        secure_zero_memory(private_keys, sizeof(private_key_t) * (size_t)count);
+        return -1;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        if (i != generated) {
+            private_keys[generated] = private_keys[i];
+        }
+        if (validate_private_key(&private_keys[generated]) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to generate key pair %d\n", first + i + 1);
+            }
+            continue;
+        }
+        key_numbers[generated++] = first + i + 1;
+    }
+    
+    stats_end(STATS_STAGE_RNG, started);
+    stats_count(STATS_COUNTER_KEYS, (uint64_t)generated);
+    return generated;
+}
+
+int generate_bitcoin_key_pairs(private_key_t *private_keys, public_key_t *public_keys, int *key_numbers, int first, int count, const keygen_options_t *options) {
+    if (!private_keys || !public_keys || !key_numbers || count <= 0 || !options) return -1;
+    
+    int generated = generate_private_keys(private_keys, key_numbers, first, count, options);
+    if (generated < 0) return -1;
+    
+    uint64_t started = stats_begin();
+    if (generated > 0 && derive_public_keys_batch(private_keys, public_keys, (size_t)generated, options->compressed) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to derive public keys for key pairs %d-%d\n", first + 1, first + count);
+        }
+        secure_zero_memory(private_keys, sizeof(private_key_t) * (size_t)generated);
+        return -1;
+    }
+    stats_end(STATS_STAGE_DERIVE, started);
+    
+    return generated;
+}
+
+int format_key_record(const private_key_t *private_key, const public_key_t *public_key,
+                      const char *address_string, const keygen_options_t *options,
+                      char *output, size_t output_size) {
+    const char *end = output + output_size;
+    char *p = output;
+    
+    size_t pub_key_len = public_key->length;
+    if (pub_key_len == 0) {
+        pub_key_len = PUBLIC_KEY_SIZE;
+    }
+    
+    if (options->verbose) {
+        p = append_string(p, end, "Private Key (Hex): ");
+        p = append_hex(p, end, private_key->data, PRIVATE_KEY_SIZE);
+        p = append_string(p, end, "\nPrivate Key (WIF): ");
+        p = append_wif(p, end, private_key, options);
+        p = append_string(p, end, "\nPublic Key (Hex): ");
+        p = append_hex(p, end, public_key->data, pub_key_len);
+        p = append_string(p, end, "\n");
+        if (address_string) {
+            p = append_string(p, end, "Bitcoin Address: ");
+            p = append_string(p, end, address_string);
+            p = append_string(p, end, "\n");
+        }
+        p = append_string(p, end, "---\n");
+    } else {
+        switch (options->format) {
+            case OUTPUT_FORMAT_HEX:
+                p = append_hex(p, end, private_key->data, PRIVATE_KEY_SIZE);
+                break;
+            case OUTPUT_FORMAT_WIF:
+                p = append_wif(p, end, private_key, options);
+                break;
+            case OUTPUT_FORMAT_BINARY:
+                p = append_hex(p, end, private_key->data, PRIVATE_KEY_SIZE);
+                p = append_string(p, end, "\n");
+                break;
+        }
+        
+        if (options->with_address && address_string) {
+            p = append_string(p, end, " ");
+            p = append_string(p, end, address_string);
+        }
+        p = append_string(p, end, "\n");
+    }
+    
+    if (!p) {
+        return -1;
+    }
+    
+    return (int)(p - output);
+}
+
+int format_key_information(const private_key_t *private_key, const public_key_t *public_key, 
+                          const bitcoin_address_t *address, const keygen_options_t *options,
+                          char *output, size_t output_size) {
+    if (!private_key || !public_key || !options || !output) return -1;
+    
+    char address_string[MAX_ADDRESS_STRING_SIZE];
+    
+    if (address && encode_address(address, options->address_type, options->testnet,
+                                  address_string, sizeof(address_string)) != 0) {
+        return -1;
+    }
+    
+    return format_key_record(private_key, public_key, address ? address_string : NULL, options, output, output_size);
+}
+
+static int emit_key_block(const keygen_options_t *options, secmem_arena_t *arena, const private_key_t *private_keys,
+                          const public_key_t *public_keys, const int *key_numbers, int generated,
+                          char *buffer, size_t buffer_size, size_t *length) {
+    bitcoin_address_t addresses[KEYGEN_BLOCK_SIZE];
+    char address_strings[KEYGEN_BLOCK_SIZE][MAX_ADDRESS_STRING_SIZE];
+    size_t used = 0;
+    int with_address = options->with_address;
+    int result = 0;
+    uint64_t started;
+    
+    *length = 0;
+    if (generated <= 0) return 0;
+    
+    if (options->format == OUTPUT_FORMAT_BINARY) {
+        keystore_record_t *records = secmem_alloc(arena, sizeof(keystore_record_t) * (size_t)generated);
+        
+        started = stats_begin();
+        if (!records ||
+            keystore_fill_records(private_keys, public_keys, (size_t)generated, options->testnet, records) != 0) {
+            result = -1;
+        }
+        stats_end(STATS_STAGE_HASH, started);
+        
+        started = stats_begin();
+        if (result != 0 ||
+            keystore_encode_block(records, (size_t)generated, (uint8_t *)buffer, buffer_size, &used) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to encode key pairs %d-%d\n", key_numbers[0], key_numbers[generated - 1]);
+            }
+            used = 0;
+            result = -1;
+        }
+        stats_end(STATS_STAGE_ENCODE, started);
+        *length = used;
+        return result;
+    }
+    
+    started = stats_begin();
+    int hashed = !with_address ||
+                 create_addresses(public_keys, addresses, (size_t)generated, options->address_type, options->testnet) == 0;
+    stats_end(STATS_STAGE_HASH, started);
+    
+    started = stats_begin();
+    if (with_address &&
+        (!hashed ||
+         encode_addresses(addresses, (size_t)generated, options->address_type, options->testnet,
+                          address_strings[0], MAX_ADDRESS_STRING_SIZE) != 0)) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to generate addresses for key pairs %d-%d\n", key_numbers[0], key_numbers[generated - 1]);
+        }
+        with_address = 0;
+    }
+    
+    for (int i = 0; i < generated; i++) {
+        int written = format_key_record(&private_keys[i], &public_keys[i],
+                                        with_address ? address_strings[i] : NULL, options,
+                                        buffer + used, buffer_size - used);
+        if (written < 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to print key information for key pair %d\n", key_numbers[i]);
+            }
+            continue;
+        }
+        used += (size_t)written;
+    }
+    stats_end(STATS_STAGE_ENCODE, started);
+    
+    *length = used;
+    return 0;
+}
+
+static int generate_key_block(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                              int first, int count, char *buffer, size_t buffer_size, size_t *length) {
+    private_key_t *private_keys = secmem_alloc(arena, sizeof(private_key_t) * KEYGEN_BLOCK_SIZE);
+    public_key_t *public_keys = secmem_alloc(arena, sizeof(public_key_t) * KEYGEN_BLOCK_SIZE);
+    int key_numbers[KEYGEN_BLOCK_SIZE];
+    (void)source;
+    
+    if (!private_keys || !public_keys) {
+        *length = 0;
+        return -1;
+    }
+    
+    int generated = generate_bitcoin_key_pairs(private_keys, public_keys, key_numbers, first, count, options);
+    if (generated < 0) {
+        *length = 0;
+        return -1;
+    }
+    
+    return emit_key_block(options, arena, private_keys, public_keys, key_numbers, generated, buffer, buffer_size, length);
+}
+
+static int write_pending_blocks(keygen_run_t *run) {
+    struct iovec iov[OUTPUT_IOV_MAX];
+    size_t first = run->next_block;
+    int count = 0;
+    int result = 0;
+    
+    while (count < OUTPUT_IOV_MAX && run->pending_ready[(first + (size_t)count) % run->window]) {
+        size_t slot = (first + (size_t)count) % run->window;
+        iov[count].iov_base = run->pending[slot];
+        iov[count].iov_len = run->pending_length[slot];
+        count++;
+    }
+    if (count == 0) return 0;
+    
+    if (output_writev(run->out, iov, count) != 0) {
+        result = -1;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        size_t slot = (first + (size_t)i) % run->window;
+        secure_zero_memory(run->pending[slot], run->pending_length[slot]);
+        run->pending_length[slot] = 0;
+        run->pending_ready[slot] = 0;
+    }
+    run->next_block += (size_t)count;
+    
+    return result;
+}
+
+static int generate_block_task(size_t task, int worker, void *context) {
+    keygen_run_t *run = (keygen_run_t *)context;
+    const keygen_options_t *options = run->options;
+    int first = (int)task * KEYGEN_BLOCK_SIZE;
+    int count = run->count - first < KEYGEN_BLOCK_SIZE ? run->count - first : KEYGEN_BLOCK_SIZE;
+    size_t block_size = (size_t)count * KEYGEN_RECORD_MAX;
+    secmem_arena_t *arena = &run->arenas[worker];
+    size_t length = 0;
+    int stopped = options->running && !*options->running;
+    int result = 0;
+    
+    if (!options->ordered) {
+        if (stopped) return 0;
+        output_buffer_t *buffer = &run->buffers[worker];
+        if (buffer->capacity - buffer->used < block_size && output_flush(run->out, buffer) != 0) {
+            return -1;
+        }
+        result = run->produce(options, run->source, arena, first, count, buffer->data + buffer->used,
+                              buffer->capacity - buffer->used, &length);
+        secmem_reset(arena);
+        buffer->used += length;
+        return result;
+    }
+    
+    pthread_mutex_lock(&run->lock);
+    while (task >= run->next_block + run->window) {
+        pthread_cond_wait(&run->advanced, &run->lock);
+    }
+    pthread_mutex_unlock(&run->lock);
+    
+    size_t slot = task % run->window;
+    if (!stopped) {
+        result = run->produce(options, run->source, arena, first, count, run->pending[slot], block_size, &length);
+        secmem_reset(arena);
+    }
+    
+    pthread_mutex_lock(&run->lock);
+    run->pending_length[slot] = length;
+    run->pending_ready[slot] = 1;
+    while (run->pending_ready[run->next_block % run->window]) {
+        if (write_pending_blocks(run) != 0) {
+            result = -1;
+        }
+    }
+    pthread_cond_broadcast(&run->advanced);
+    pthread_mutex_unlock(&run->lock);
+    
+    return result;
+}
+
+static int run_key_blocks(int count, const keygen_options_t *options, keygen_block_fn produce, const void *source) {
+    keygen_run_t run;
+    size_t blocks = ((size_t)count + KEYGEN_BLOCK_SIZE - 1) / KEYGEN_BLOCK_SIZE;
+    int threads = options->threads > 0 ? options->threads : pool_cpu_count();
+    int result = 0;
+    
+    memset(&run, 0, sizeof(run));
+    run.options = options;
+    run.produce = produce;
+    run.source = source;
+    run.count = count;
+    run.window = (size_t)threads * KEYGEN_REORDER_BLOCKS_PER_THREAD;
+    run.out = keygen_writer(options);
+    if (!run.out) return -1;
+    
+    run.arenas = calloc((size_t)threads, sizeof(secmem_arena_t));
+    if (!run.arenas) {
+        result = -1;
+    }
+    for (int i = 0; result == 0 && i < threads; i++) {
+        if (secmem_arena_init(&run.arenas[i], KEYGEN_ARENA_SIZE) != 0) {
+            result = -1;
+        }
+    }
+    
+    if (options->ordered) {
+        run.pending_data = secmem_map(run.window * KEYGEN_BLOCK_SIZE * KEYGEN_RECORD_MAX);
+        run.pending = calloc(run.window, sizeof(char *));
+        run.pending_length = calloc(run.window, sizeof(size_t));
+        run.pending_ready = calloc(run.window, sizeof(unsigned char));
+        if (!run.pending_data || !run.pending || !run.pending_length || !run.pending_ready) {
+            result = -1;
+        }
+        for (size_t i = 0; result == 0 && i < run.window; i++) {
+            run.pending[i] = run.pending_data + i * KEYGEN_BLOCK_SIZE * KEYGEN_RECORD_MAX;
+        }
+    } else {
+        run.buffers = calloc((size_t)threads, sizeof(output_buffer_t));
+        if (!run.buffers) {
+            result = -1;
+        }
+        for (int i = 0; result == 0 && i < threads; i++) {
+            if (output_buffer_init(&run.buffers[i], OUTPUT_BUFFER_SIZE) != 0) {
+                result = -1;
+            }
+        }
+    }
+    
+    if (result == 0) {
+        pthread_mutex_init(&run.lock, NULL);
+        pthread_cond_init(&run.advanced, NULL);
+        
+        result = pool_run(threads, blocks, generate_block_task, &run);
+        
+        pthread_cond_destroy(&run.advanced);
+        pthread_mutex_destroy(&run.lock);
+    }
+    
+    if (run.buffers) {
+        for (int i = 0; i < threads; i++) {
+            if (run.buffers[i].data && output_flush(run.out, &run.buffers[i]) != 0) {
+                result = -1;
+            }
+            output_buffer_free(&run.buffers[i]);
+        }
+    }
+    if (run.arenas) {
+        for (int i = 0; i < threads; i++) {
+            secmem_arena_free(&run.arenas[i]);
+        }
+    }
+    free(run.buffers);
+    free(run.arenas);
+    secmem_unmap(run.pending_data, run.window * KEYGEN_BLOCK_SIZE * KEYGEN_RECORD_MAX);
+    free(run.pending);
+    free(run.pending_length);
+    free(run.pending_ready);
+    
+    return result;
+}
+
+int generate_multiple_keys(int count, const keygen_options_t *options) {
+    if (count <= 0 || !options) return -1;
+    
+    if (options->pipeline) {
+        output_t *out = keygen_writer(options);
+        return out ? pipeline_run(count, options, out) : -1;
+    }
+    return run_key_blocks(count, options, generate_key_block, NULL);
+}
+
+static int requires_compressed(const keygen_options_t *options) {
+    return options->with_address && options->address_type != ADDRESS_TYPE_P2PKH;
+}
+
+static int parse_key_line(const char *line, size_t length, const keygen_options_t *options,
+                          private_key_t *key, int *compressed, int *testnet) {
+    if (length == PRIVATE_KEY_SIZE * 2) {
+        if (hex_decode(line, length, key->data) != 0) return -1;
+        *compressed = options->compressed;
+        *testnet = options->testnet;
+        return validate_private_key(key);
+    }
+    if (length >= MAX_WIF_STRING_SIZE) return -1;
+    
+    char wif[MAX_WIF_STRING_SIZE];
+    memcpy(wif, line, length);
+    wif[length] = '\0';
+    int result = wif_decode(wif, key, compressed, testnet);
+    secure_zero_memory(wif, sizeof(wif));
+    return result;
+}
+
+static int import_key_block(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                            int first, int count, char *buffer, size_t buffer_size, size_t *length) {
+    const keygen_input_t *input = source;
+    private_key_t *private_keys = secmem_alloc(arena, sizeof(private_key_t) * KEYGEN_BLOCK_SIZE);
+    public_key_t *public_keys = secmem_alloc(arena, sizeof(public_key_t) * KEYGEN_BLOCK_SIZE);
+    int key_numbers[KEYGEN_BLOCK_SIZE];
+    uint8_t flags[KEYGEN_BLOCK_SIZE];
+    size_t position = input->block_offsets[first / KEYGEN_BLOCK_SIZE];
+    size_t used = 0;
+    int parsed = 0;
+    int result = 0;
+    
+    *length = 0;
+    if (!private_keys || !public_keys) return -1;
+    
+    for (int i = 0; i < count && position < input->size; i++) {
+        const char *line = input->data + position;
+        const char *newline = memchr(line, '\n', input->size - position);
+        size_t end = newline ? (size_t)(newline - line) : input->size - position;
+        size_t start = 0;
+        int compressed, testnet;
+        
+        position += end + 1;
+        while (start < end && isspace((unsigned char)line[start])) {
+            start++;
+        }
+        while (end > start && isspace((unsigned char)line[end - 1])) {
+            end--;
+        }
+        if (start == end) continue;
+        
+        if (parse_key_line(line + start, end - start, options, &private_keys[parsed], &compressed, &testnet) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Invalid private key on line %d\n", first + i + 1);
+            }
+            result = -1;
+            continue;
+        }
+        if (requires_compressed(options)) {
+            compressed = 1;
+        }
+        flags[parsed] = (uint8_t)((compressed ? KEYSTORE_FLAG_COMPRESSED : 0) | (testnet ? KEYSTORE_FLAG_TESTNET : 0));
+        key_numbers[parsed++] = first + i + 1;
+    }
+    
+    for (int offset = 0; offset < parsed; ) {
+        keygen_options_t run_options = *options;
+        size_t written = 0;
+        int run = 1;
+        
+        while (offset + run < parsed && flags[offset + run] == flags[offset]) {
+            run++;
+        }
+        run_options.compressed = (flags[offset] & KEYSTORE_FLAG_COMPRESSED) != 0;
+        run_options.testnet = (flags[offset] & KEYSTORE_FLAG_TESTNET) != 0;
+        
+        if (derive_public_keys_batch(private_keys + offset, public_keys + offset, (size_t)run, run_options.compressed) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to derive public keys for lines %d-%d\n", key_numbers[offset], key_numbers[offset + run - 1]);
+            }
+            result = -1;
+        } else if (emit_key_block(&run_options, arena, private_keys + offset, public_keys + offset, key_numbers + offset, run,
+                                  buffer + used, buffer_size - used, &written) != 0) {
+            result = -1;
+        }
+        used += written;
+        offset += run;
+    }
+    
+    *length = used;
+    return result;
+}
+
+static int index_input_lines(keygen_input_t *input) {
+    size_t capacity = 0;
+    size_t position = 0;
+    int count = 0;
+    
+    input->blocks = 0;
+    while (position < input->size) {
+        if (count % KEYGEN_BLOCK_SIZE == 0) {
+            if (input->blocks == capacity) {
+                size_t grown = capacity ? capacity * 2 : 1024;
+                size_t *resized = realloc(input->block_offsets, grown * sizeof(size_t));
+                if (!resized) return -1;
+                input->block_offsets = resized;
+                capacity = grown;
+            }
+            input->block_offsets[input->blocks++] = position;
+        }
+        
+        const char *newline = memchr(input->data + position, '\n', input->size - position);
+        position = newline ? (size_t)(newline - input->data) + 1 : input->size;
+        if (count == INT_MAX) return -1;
+        count++;
+    }
+    
+    input->lines = count;
+    return 0;
+}
+
+static char *read_stream(int fd, size_t *size) {
+    size_t capacity = 1 << 20;
+    size_t used = 0;
+    char *data = malloc(capacity);
+    
+    while (data) {
+        if (used == capacity) {
+            char *grown = malloc(capacity * 2);
+            if (grown) {
+                memcpy(grown, data, used);
+            }
+            secure_zero_memory(data, used);
+            free(data);
+            data = grown;
+            capacity *= 2;
+            continue;
+        }
+        ssize_t n = read(fd, data + used, capacity - used);
+        if (n == 0) break;
+        if (n < 0) {
+            secure_zero_memory(data, used);
+            free(data);
+            return NULL;
+        }
+        used += (size_t)n;
+    }
+    
+    *size = used;
+    return data;
+}
+
+static void close_input(keygen_input_t *input) {
+    free(input->block_offsets);
+    if (input->mapping) {
+        munmap(input->mapping, input->size);
+    }
+    if (input->stream) {
+        secure_zero_memory(input->stream, input->size);
+        free(input->stream);
+    }
+    memset(input, 0, sizeof(*input));
+}
+
+static int open_input(keygen_input_t *input, const char *path, const keygen_options_t *options) {
+    memset(input, 0, sizeof(*input));
+    if (strcmp(path, "-") == 0) {
+        input->stream = read_stream(STDIN_FILENO, &input->size);
+        if (!input->stream) return -1;
+        input->data = input->stream;
+    } else {
+        struct stat st;
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to open input: %s\n", path);
+            }
+            if (fd >= 0) close(fd);
+            return -1;
+        }
+        input->size = (size_t)st.st_size;
+        if (input->size > 0) {
+            void *mapping = mmap(NULL, input->size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                input->size = 0;
+                return -1;
+            }
+            madvise(mapping, input->size, MADV_SEQUENTIAL);
+            input->mapping = mapping;
+            input->data = mapping;
+        }
+        close(fd);
+    }
+    
+    if (index_input_lines(input) != 0) {
+        close_input(input);
+        return -1;
+    }
+    return 0;
+}
+
+int import_keys(const keygen_options_t *options) {
+    if (!options || !options->input_path) return -1;
+    
+    keygen_input_t input;
+    int result = 0;
+    
+    if (open_input(&input, options->input_path, options) != 0) return -1;
+    if (input.lines > 0) {
+        result = run_key_blocks(input.lines, options, import_key_block, &input);
+    }
+    
+    close_input(&input);
+    return result;
+}
+
+static int validate_address_block(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                                  int first, int count, char *buffer, size_t buffer_size, size_t *length) {
+    const keygen_validation_t *validation = source;
+    const keygen_input_t *input = &validation->input;
+    char copies[KEYGEN_BLOCK_SIZE][MAX_ADDRESS_STRING_SIZE];
+    const char *addresses[KEYGEN_BLOCK_SIZE];
+    const char *lines[KEYGEN_BLOCK_SIZE];
+    int line_lengths[KEYGEN_BLOCK_SIZE];
+    int line_numbers[KEYGEN_BLOCK_SIZE];
+    address_status_t statuses[KEYGEN_BLOCK_SIZE];
+    size_t position = input->block_offsets[first / KEYGEN_BLOCK_SIZE];
+    size_t used = 0;
+    size_t invalid = 0;
+    int parsed = 0;
+    (void)arena;
+    
+    for (int i = 0; i < count && position < input->size; i++) {
+        const char *line = input->data + position;
+        const char *newline = memchr(line, '\n', input->size - position);
+        size_t end = newline ? (size_t)(newline - line) : input->size - position;
+        size_t start = 0;
+        
+        position += end + 1;
+        while (start < end && isspace((unsigned char)line[start])) {
+            start++;
+        }
+        while (end > start && isspace((unsigned char)line[end - 1])) {
+            end--;
+        }
+        if (start == end) continue;
+        
+        size_t copied = end - start < MAX_ADDRESS_STRING_SIZE ? end - start : MAX_ADDRESS_STRING_SIZE - 1;
+        memcpy(copies[parsed], line + start, copied);
+        copies[parsed][copied] = '\0';
+        addresses[parsed] = end - start < MAX_ADDRESS_STRING_SIZE ? copies[parsed] : NULL;
+        lines[parsed] = line + start;
+        line_lengths[parsed] = (int)copied;
+        line_numbers[parsed++] = first + i + 1;
+    }
+    
+    if (parsed > 0 && address_validate_batch(addresses, (size_t)parsed, options->testnet, statuses) != 0) {
+        *length = 0;
+        return -1;
+    }
+    
+    for (int i = 0; i < parsed; i++) {
+        if (statuses[i] != ADDRESS_VALID) {
+            invalid++;
+        } else if (!options->verbose) {
+            continue;
+        }
+        int written = snprintf(buffer + used, buffer_size - used, "%d %.*s %s\n", line_numbers[i],
+                               line_lengths[i], lines[i], address_status_string(statuses[i]));
+        if (written < 0 || (size_t)written >= buffer_size - used) {
+            *length = used;
+            return -1;
+        }
+        used += (size_t)written;
+    }
+    
+    __atomic_add_fetch(validation->checked, (size_t)parsed, __ATOMIC_RELAXED);
+    __atomic_add_fetch(validation->invalid, invalid, __ATOMIC_RELAXED);
+    *length = used;
+    return 0;
+}
+
+int validate_addresses(const keygen_options_t *options) {
+    if (!options || !options->validate_path) return -1;
+    
+    keygen_validation_t validation;
+    size_t checked = 0;
+    size_t invalid = 0;
+    int result = 0;
+    
+    if (open_input(&validation.input, options->validate_path, options) != 0) return -1;
+    validation.checked = &checked;
+    validation.invalid = &invalid;
+    if (validation.input.lines > 0) {
+        result = run_key_blocks(validation.input.lines, options, validate_address_block, &validation);
+    }
+    close_input(&validation.input);
+    
+    if (result != 0) return -1;
+    if (!options->quiet && (invalid > 0 || options->verbose)) {
+        fprintf(stderr, "%zu of %zu addresses invalid\n", invalid, checked);
+    }
+    return invalid > 0 ? 1 : 0;
+}
+
+static int split_fields(const char *line, size_t length, const char **fields, size_t *lengths, int max) {
+    size_t i = 0;
+    int found = 0;
+    
+    while (i < length) {
+        while (i < length && isspace((unsigned char)line[i])) {
+            i++;
+        }
+        if (i == length) break;
+        if (found == max) return -1;
+        fields[found] = line + i;
+        while (i < length && !isspace((unsigned char)line[i])) {
+            i++;
+        }
+        lengths[found] = (size_t)(line + i - fields[found]);
+        found++;
+    }
+    return found;
+}
+
+static int sign_message_block(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                              int first, int count, char *buffer, size_t buffer_size, size_t *length) {
+    const keygen_input_t *input = source;
+    private_key_t *private_keys = secmem_alloc(arena, sizeof(private_key_t) * KEYGEN_BLOCK_SIZE);
+    uint8_t *aux = secmem_alloc(arena, (size_t)KEYGEN_BLOCK_SIZE * SCHNORR_AUX_SIZE);
+    uint8_t hashes[KEYGEN_BLOCK_SIZE * SIGNATURE_HASH_SIZE];
+    uint8_t signatures[KEYGEN_BLOCK_SIZE * SIGNATURE_SIZE];
+    ec_point_t points[KEYGEN_BLOCK_SIZE];
+    uint8_t compressed_keys[KEYGEN_BLOCK_SIZE];
+    size_t position = input->block_offsets[first / KEYGEN_BLOCK_SIZE];
+    char *p = buffer;
+    const char *end = buffer + buffer_size;
+    int parsed = 0;
+    int result = 0;
+    
+    *length = 0;
+    if (!private_keys || !aux) return -1;
+    
+    for (int i = 0; i < count && position < input->size; i++) {
+        const char *line = input->data + position;
+        const char *newline = memchr(line, '\n', input->size - position);
+        size_t end_of_line = newline ? (size_t)(newline - line) : input->size - position;
+        const char *fields[2];
+        size_t lengths[2];
+        int compressed, testnet;
+        int found;
+        
+        position += end_of_line + 1;
+        found = split_fields(line, end_of_line, fields, lengths, 2);
+        if (found == 0) continue;
+        
+        if (found != 2 || lengths[1] != SIGNATURE_HASH_SIZE * 2 ||
+            hex_decode(fields[1], lengths[1], hashes + (size_t)parsed * SIGNATURE_HASH_SIZE) != 0 ||
+            parse_key_line(fields[0], lengths[0], options, &private_keys[parsed], &compressed, &testnet) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Invalid signing request on line %d\n", first + i + 1);
+            }
+            result = -1;
+            continue;
+        }
+        compressed_keys[parsed++] = (uint8_t)compressed;
+    }
+    if (parsed == 0) return result;
+    
+    uint64_t start = stats_begin();
+    int signed_ok = options->schnorr
+        ? rng_bytes(aux, (size_t)parsed * SCHNORR_AUX_SIZE) == 0 &&
+          schnorr_sign_batch(private_keys, hashes, aux, signatures, (size_t)parsed) == 0
+        : ecdsa_sign_batch(private_keys, hashes, signatures, (size_t)parsed) == 0;
+    if (!signed_ok || ec_mult_gen_batch(points, (const uint8_t *)private_keys, (size_t)parsed) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to sign lines %d-%d\n", first + 1, first + count);
+        }
+        return -1;
+    }
+    stats_end(STATS_STAGE_DERIVE, start);
+    stats_count(STATS_COUNTER_KEYS, (uint64_t)parsed);
+    
+    for (int i = 0; i < parsed; i++) {
+        uint8_t encoded[PUBLIC_KEY_SIZE];
+        size_t encoded_length = 0;
+        
+        if (ec_point_serialize(&points[i], encoded, &encoded_length, options->schnorr || compressed_keys[i]) != 0) {
+            return -1;
+        }
+        if (options->schnorr) {
+            p = append_hex(p, end, encoded + 1, SCHNORR_PUBLIC_KEY_SIZE);
+        } else {
+            p = append_hex(p, end, encoded, encoded_length);
+        }
+        p = append_text(p, end, " ", 1);
+        p = append_hex(p, end, hashes + (size_t)i * SIGNATURE_HASH_SIZE, SIGNATURE_HASH_SIZE);
+        p = append_text(p, end, " ", 1);
+        p = append_hex(p, end, signatures + (size_t)i * SIGNATURE_SIZE, SIGNATURE_SIZE);
+        p = append_text(p, end, "\n", 1);
+        if (!p) return -1;
+    }
+    
+    *length = (size_t)(p - buffer);
+    return result;
+}
+
+int sign_messages(const keygen_options_t *options) {
+    if (!options || !options->sign_path) return -1;
+    
+    keygen_input_t input;
+    int result = 0;
+    
+    if (open_input(&input, options->sign_path, options) != 0) return -1;
+    if (input.lines > 0) {
+        result = run_key_blocks(input.lines, options, sign_message_block, &input);
+    }
+    
+    close_input(&input);
+    return result;
+}
+
+static int verify_signature_block(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                                  int first, int count, char *buffer, size_t buffer_size, size_t *length) {
+    const keygen_validation_t *validation = source;
+    const keygen_input_t *input = &validation->input;
+    uint8_t schnorr_keys[KEYGEN_BLOCK_SIZE * SCHNORR_PUBLIC_KEY_SIZE];
+    uint8_t schnorr_hashes[KEYGEN_BLOCK_SIZE * SIGNATURE_HASH_SIZE];
+    uint8_t schnorr_signatures[KEYGEN_BLOCK_SIZE * SIGNATURE_SIZE];
+    int schnorr_lines[KEYGEN_BLOCK_SIZE];
+    const char *lines[KEYGEN_BLOCK_SIZE];
+    int line_lengths[KEYGEN_BLOCK_SIZE];
+    int line_numbers[KEYGEN_BLOCK_SIZE];
+    const char *statuses[KEYGEN_BLOCK_SIZE];
+    size_t position = input->block_offsets[first / KEYGEN_BLOCK_SIZE];
+    size_t used = 0;
+    size_t invalid = 0;
+    int schnorr_count = 0;
+    int parsed = 0;
+    (void)arena;
+    
+    uint64_t start = stats_begin();
+    for (int i = 0; i < count && position < input->size; i++) {
+        const char *line = input->data + position;
+        const char *newline = memchr(line, '\n', input->size - position);
+        size_t end = newline ? (size_t)(newline - line) : input->size - position;
+        const char *fields[3];
+        size_t lengths[3];
+        uint8_t hash[SIGNATURE_HASH_SIZE];
+        uint8_t signature[SIGNATURE_SIZE];
+        public_key_t public_key;
+        size_t shown;
+        int found;
+        
+        position += end + 1;
+        found = split_fields(line, end, fields, lengths, 3);
+        if (found == 0) continue;
+        
+        while (end > 0 && isspace((unsigned char)line[end - 1])) {
+            end--;
+        }
+        shown = (size_t)(line + end - fields[0]);
+        lines[parsed] = fields[0];
+        line_lengths[parsed] = (int)(shown < SIGNATURE_LINE_MAX ? shown : SIGNATURE_LINE_MAX);
+        line_numbers[parsed] = first + i + 1;
+        statuses[parsed] = "malformed";
+        
+        if (found != 3 ||
+            (lengths[0] != SCHNORR_PUBLIC_KEY_SIZE * 2 && lengths[0] != COMPRESSED_PUBLIC_KEY_SIZE * 2 &&
+             lengths[0] != PUBLIC_KEY_SIZE * 2) ||
+            lengths[1] != SIGNATURE_HASH_SIZE * 2 || lengths[2] != SIGNATURE_SIZE * 2 ||
+            hex_decode(fields[0], lengths[0], public_key.data) != 0 ||
+            hex_decode(fields[1], lengths[1], hash) != 0 ||
+            hex_decode(fields[2], lengths[2], signature) != 0) {
+            parsed++;
+            continue;
+        }
+        public_key.length = lengths[0] / 2;
+        
+        if (public_key.length == SCHNORR_PUBLIC_KEY_SIZE) {
+            memcpy(schnorr_keys + (size_t)schnorr_count * SCHNORR_PUBLIC_KEY_SIZE, public_key.data, SCHNORR_PUBLIC_KEY_SIZE);
+            memcpy(schnorr_hashes + (size_t)schnorr_count * SIGNATURE_HASH_SIZE, hash, SIGNATURE_HASH_SIZE);
+            memcpy(schnorr_signatures + (size_t)schnorr_count * SIGNATURE_SIZE, signature, SIGNATURE_SIZE);
+            schnorr_lines[schnorr_count++] = parsed;
+        } else {
+            statuses[parsed] = ecdsa_verify(&public_key, hash, signature) == 0 ? "valid" : "invalid";
+        }
+        parsed++;
+    }
+    
+    if (schnorr_count > 0 &&
+        schnorr_verify_batch(schnorr_keys, schnorr_hashes, schnorr_signatures, (size_t)schnorr_count) == 0) {
+        for (int i = 0; i < schnorr_count; i++) {
+            statuses[schnorr_lines[i]] = "valid";
+        }
+    } else {
+        for (int i = 0; i < schnorr_count; i++) {
+            statuses[schnorr_lines[i]] = schnorr_verify(schnorr_keys + (size_t)i * SCHNORR_PUBLIC_KEY_SIZE,
+                                                        schnorr_hashes + (size_t)i * SIGNATURE_HASH_SIZE,
+                                                        schnorr_signatures + (size_t)i * SIGNATURE_SIZE) == 0
+                ? "valid" : "invalid";
+        }
+    }
+    stats_end(STATS_STAGE_DERIVE, start);
+    stats_count(STATS_COUNTER_KEYS, (uint64_t)parsed);
+    
+    for (int i = 0; i < parsed; i++) {
+        if (strcmp(statuses[i], "valid") != 0) {
+            invalid++;
+        } else if (!options->verbose) {
+            continue;
+        }
+        int written = snprintf(buffer + used, buffer_size - used, "%d %.*s %s\n", line_numbers[i],
+                               line_lengths[i], lines[i], statuses[i]);
+        if (written < 0 || (size_t)written >= buffer_size - used) {
+            *length = used;
+            return -1;
+        }
+        used += (size_t)written;
+    }
+    
+    __atomic_add_fetch(validation->checked, (size_t)parsed, __ATOMIC_RELAXED);
+    __atomic_add_fetch(validation->invalid, invalid, __ATOMIC_RELAXED);
+    *length = used;
+    return 0;
+}
+
+int verify_signatures(const keygen_options_t *options) {
+    if (!options || !options->verify_path) return -1;
+    
+    keygen_validation_t validation;
+    size_t checked = 0;
+    size_t invalid = 0;
+    int result = 0;
+    
+    if (open_input(&validation.input, options->verify_path, options) != 0) return -1;
+    validation.checked = &checked;
+    validation.invalid = &invalid;
+    if (validation.input.lines > 0) {
+        result = run_key_blocks(validation.input.lines, options, verify_signature_block, &validation);
+    }
+    close_input(&validation.input);
+    
+    if (result != 0) return -1;
+    if (!options->quiet && (invalid > 0 || options->verbose)) {
+        fprintf(stderr, "%zu of %zu signatures invalid\n", invalid, checked);
+    }
+    return invalid > 0 ? 1 : 0;
+}
+
+static int derive_key_block(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                            int first, int count, char *buffer, size_t buffer_size, size_t *length) {
+    const keygen_derivation_t *derivation = source;
+    bip32_node_t *children = secmem_alloc(arena, sizeof(bip32_node_t) * KEYGEN_BLOCK_SIZE);
+    public_key_t public_keys[KEYGEN_BLOCK_SIZE];
+    bitcoin_address_t addresses[KEYGEN_BLOCK_SIZE];
+    char address_strings[KEYGEN_BLOCK_SIZE][MAX_ADDRESS_STRING_SIZE];
+    char key_string[MAX_HEX_STRING_SIZE];
+    char index_string[16];
+    const char *end = buffer + buffer_size;
+    char *p = buffer;
+    int result = 0;
+    
+    if (!children || bip32_derive_children(&derivation->parent, derivation->start + (uint32_t)first, (size_t)count, children) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to derive children %u-%u\n", derivation->start + (uint32_t)first,
+                    derivation->start + (uint32_t)(first + count - 1));
+        }
+        *length = 0;
+        return -1;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        memcpy(public_keys[i].data, children[i].public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+        public_keys[i].length = COMPRESSED_PUBLIC_KEY_SIZE;
+    }
+    if (create_addresses(public_keys, addresses, (size_t)count, options->address_type, options->testnet) != 0 ||
+        encode_addresses(addresses, (size_t)count, options->address_type, options->testnet,
+                         address_strings[0], MAX_ADDRESS_STRING_SIZE) != 0) {
+        result = -1;
     }
     
-    if (options->compressed) {
-        if (derive_compressed_public_key(private_key, public_key) != 0) {
-            return -1;
+    for (int i = 0; i < count && result == 0; i++) {
+        const bip32_node_t *child = &children[i];
+        
+        if (!child->has_private) {
+            encode_hex(child->public_key, COMPRESSED_PUBLIC_KEY_SIZE, key_string);
+            key_string[COMPRESSED_PUBLIC_KEY_SIZE * 2] = '\0';
+        } else if (options->format == OUTPUT_FORMAT_WIF || options->verbose) {
+            result = encode_wif(&child->private_key, 1, options->testnet, key_string, sizeof(key_string));
+        } else {
+            encode_hex(child->private_key.data, PRIVATE_KEY_SIZE, key_string);
+            key_string[PRIVATE_KEY_SIZE * 2] = '\0';
         }
-    } else {
-        if (derive_public_key(private_key, public_key) != 0) {
-            return -1;
+        snprintf(index_string, sizeof(index_string), "/%u", child->child_number);
+        
+        if (options->verbose) {
+            p = append_string(p, end, "Path: ");
+            p = append_string(p, end, derivation->path);
+            p = append_string(p, end, index_string);
+            p = append_string(p, end, child->has_private ? "\nPrivate Key (WIF): " : "\nPublic Key (Hex): ");
+            p = append_string(p, end, key_string);
+            p = append_string(p, end, "\nBitcoin Address: ");
+            p = append_string(p, end, address_strings[i]);
+            p = append_string(p, end, "\n---\n");
+        } else {
+            p = append_string(p, end, derivation->path);
+            p = append_string(p, end, index_string);
+            p = append_string(p, end, " ");
+            p = append_string(p, end, address_strings[i]);
+            p = append_string(p, end, " ");
+            p = append_string(p, end, key_string);
+            p = append_string(p, end, "\n");
+        }
+        if (!p) {
+            result = -1;
         }
     }
     
-    return 0;
+    secure_zero_memory(key_string, sizeof(key_string));
+    *length = result == 0 ? (size_t)(p - buffer) : 0;
+    return result;
 }
 
-int generate_multiple_keys(int count, const keygen_options_t *options) {
-    if (count <= 0 || !options) return -1;
+static int multisig_key_block(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                              int first, int count, char *buffer, size_t buffer_size, size_t *length) {
+    const keygen_multisig_t *multisig = source;
+    bip32_node_t *children = secmem_alloc(arena, sizeof(bip32_node_t) * KEYGEN_BLOCK_SIZE);
+    uint8_t *keys = secmem_alloc(arena, (size_t)KEYGEN_BLOCK_SIZE * MULTISIG_MAX_KEYS * COMPRESSED_PUBLIC_KEY_SIZE);
+    bitcoin_address_t addresses[KEYGEN_BLOCK_SIZE];
+    char address_strings[KEYGEN_BLOCK_SIZE][MAX_ADDRESS_STRING_SIZE];
+    uint8_t script[MULTISIG_SCRIPT_MAX];
+    char script_string[MULTISIG_SCRIPT_MAX * 2 + 1];
+    char index_string[16];
+    size_t stride = multisig->keys * COMPRESSED_PUBLIC_KEY_SIZE;
+    uint32_t start = multisig->start + (uint32_t)first;
+    const char *end = buffer + buffer_size;
+    char *p = buffer;
+    int result = 0;
     
-    for (int i = 0; i < count; i++) {
-        private_key_t private_key;
-        public_key_t public_key;
-        bitcoin_address_t address;
-        
-        if (generate_bitcoin_key_pair(&private_key, &public_key, options) != 0) {
+    *length = 0;
+    if (!children || !keys) return -1;
+    
+    for (size_t c = 0; c < multisig->keys; c++) {
+        if (bip32_derive_children(&multisig->parents[c], start, (size_t)count, children) != 0) {
             if (!options->quiet) {
-                fprintf(stderr, "Failed to generate key pair %d\n", i + 1);
+                fprintf(stderr, "Failed to derive cosigner %zu children %u-%u\n", c + 1, start,
+                        start + (uint32_t)(count - 1));
             }
-            continue;
+            return -1;
         }
+        for (int i = 0; i < count; i++) {
+            memcpy(keys + (size_t)i * stride + c * COMPRESSED_PUBLIC_KEY_SIZE, children[i].public_key,
+                   COMPRESSED_PUBLIC_KEY_SIZE);
+        }
+    }
+    
+    if (create_multisig_addresses(keys, multisig->keys, multisig->threshold, addresses, (size_t)count,
+                                  options->address_type, options->testnet) != 0 ||
+        encode_addresses(addresses, (size_t)count, options->address_type, options->testnet,
+                         address_strings[0], MAX_ADDRESS_STRING_SIZE) != 0) {
+        return -1;
+    }
+    
+    for (int i = 0; i < count && result == 0; i++) {
+        snprintf(index_string, sizeof(index_string), "/%u", start + (uint32_t)i);
         
-        if (options->with_address) {
-            if (create_p2pkh_address(&public_key, &address) != 0) {
-                if (!options->quiet) {
-                    fprintf(stderr, "Failed to generate address for key pair %d\n", i + 1);
-                }
-                continue;
+        if (options->verbose) {
+            int script_length = multisig_script(keys + (size_t)i * stride, multisig->keys, multisig->threshold,
+                                                script, sizeof(script));
+            if (script_length < 0) {
+                result = -1;
+                break;
             }
+            encode_hex(script, (size_t)script_length, script_string);
+            script_string[script_length * 2] = '\0';
+            
+            p = append_string(p, end, "Path: ");
+            p = append_string(p, end, multisig->path);
+            p = append_string(p, end, index_string);
+            p = append_string(p, end, "\nBitcoin Address: ");
+            p = append_string(p, end, address_strings[i]);
+            p = append_string(p, end, options->address_type == ADDRESS_TYPE_P2WSH ? "\nWitness Script: " : "\nRedeem Script: ");
+            p = append_string(p, end, script_string);
+            p = append_string(p, end, "\n---\n");
+        } else {
+            p = append_string(p, end, multisig->path);
+            p = append_string(p, end, index_string);
+            p = append_string(p, end, " ");
+            p = append_string(p, end, address_strings[i]);
+            p = append_string(p, end, "\n");
         }
-        
-        if (print_key_information(&private_key, &public_key, 
-                                options->with_address ? &address : NULL, options) != 0) {
+        if (!p) {
+            result = -1;
+        }
+    }
+    
+    *length = result == 0 ? (size_t)(p - buffer) : 0;
+    return result;
+}
+
+static int derive_multisig(const keygen_options_t *options) {
+    keygen_multisig_t *multisig = calloc(1, sizeof(keygen_multisig_t));
+    keygen_options_t derived = *options;
+    bip32_node_t root;
+    uint32_t indices[BIP32_MAX_PATH_DEPTH];
+    size_t depth = 0;
+    int result = 0;
+    
+    if (!multisig) return -1;
+    
+    if (options->xkey_count < options->multisig || options->seed || options->phrase) {
+        if (!options->quiet) {
+            fprintf(stderr, "--multisig %d requires at least %d --xkey cosigners\n", options->multisig, options->multisig);
+        }
+        result = -1;
+    }
+    if (result == 0 && (bip32_parse_path(options->derive_path, indices, BIP32_MAX_PATH_DEPTH, &depth) != 0 ||
+                        bip32_format_path(indices, depth, multisig->path, sizeof(multisig->path)) != 0)) {
+        if (!options->quiet) {
+            fprintf(stderr, "Invalid derivation path: %s\n", options->derive_path);
+        }
+        result = -1;
+    }
+    if (result == 0 && options->verbose &&
+        strlen(multisig->path) + MULTISIG_SCRIPT_SIZE((size_t)options->xkey_count) * 2 + 128 > KEYGEN_RECORD_MAX) {
+        if (!options->quiet) {
+            fprintf(stderr, "Too many cosigners to print scripts with --verbose\n");
+        }
+        result = -1;
+    }
+    
+    for (int c = 0; c < options->xkey_count && result == 0; c++) {
+        if (bip32_parse(options->xkeys[c], &root) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Invalid extended key for cosigner %d\n", c + 1);
+            }
+            result = -1;
+        } else if (c > 0 && root.testnet != multisig->parents[0].testnet) {
+            if (!options->quiet) {
+                fprintf(stderr, "Cosigner %d is on a different network\n", c + 1);
+            }
+            result = -1;
+        } else if (bip32_derive_path(&root, indices, depth, &multisig->parents[c]) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to derive %s for cosigner %d\n", multisig->path, c + 1);
+            }
+            result = -1;
+        }
+        bip32_node_wipe(&root);
+    }
+    
+    if (result == 0) {
+        int count = options->range_end > options->range_start ?
+                    (int)(options->range_end - options->range_start) : options->count;
+        multisig->keys = (size_t)options->xkey_count;
+        multisig->threshold = (size_t)options->multisig;
+        multisig->start = options->range_start;
+        derived.testnet = options->testnet || multisig->parents[0].testnet;
+        derived.ordered = 1;
+        result = run_key_blocks(count, &derived, multisig_key_block, multisig);
+    }
+    
+    secure_zero_memory(multisig, sizeof(keygen_multisig_t));
+    free(multisig);
+    return result;
+}
+
+int derive_keys(const keygen_options_t *options) {
+    if (!options || !options->derive_path) return -1;
+    if (options->multisig) return derive_multisig(options);
+    
+    keygen_derivation_t *derivation = calloc(1, sizeof(keygen_derivation_t));
+    keygen_options_t derived = *options;
+    bip32_node_t root;
+    uint32_t indices[BIP32_MAX_PATH_DEPTH];
+    uint8_t seed[64];
+    size_t depth = 0;
+    int result = -1;
+    
+    if (!derivation) return -1;
+    
+    if (options->xkey) {
+        result = bip32_parse(options->xkey, &root);
+    } else if (options->seed) {
+        size_t seed_len = strlen(options->seed) / 2;
+        if (seed_len <= sizeof(seed) && hex_to_bytes(options->seed, seed, seed_len) == 0) {
+            result = bip32_from_seed(seed, seed_len, options->testnet, &root);
+        }
+        secure_zero_memory(seed, sizeof(seed));
+    } else if (options->phrase) {
+        if (bip39_validate_mnemonic(options->phrase) != 0) {
             if (!options->quiet) {
-                fprintf(stderr, "Failed to print key information for key pair %d\n", i + 1);
+                fprintf(stderr, "Invalid mnemonic\n");
             }
+        } else if (bip39_mnemonic_to_seed(options->phrase, options->passphrase, seed) == 0) {
+            result = bip32_from_seed(seed, BIP39_SEED_SIZE, options->testnet, &root);
+        }
+        secure_zero_memory(seed, sizeof(seed));
+    } else if (!options->quiet) {
+        fprintf(stderr, "--derive requires --xkey, --seed or --phrase\n");
+    }
+    
+    if (result == 0 && (bip32_parse_path(options->derive_path, indices, BIP32_MAX_PATH_DEPTH, &depth) != 0 ||
+                        bip32_format_path(indices, depth, derivation->path, sizeof(derivation->path)) != 0)) {
+        if (!options->quiet) {
+            fprintf(stderr, "Invalid derivation path: %s\n", options->derive_path);
+        }
+        result = -1;
+    }
+    if (result == 0 && bip32_derive_path(&root, indices, depth, &derivation->parent) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to derive %s\n", derivation->path);
         }
+        result = -1;
+    }
+    
+    if (result == 0) {
+        int count = options->range_end > options->range_start ?
+                    (int)(options->range_end - options->range_start) : options->count;
+        derivation->start = options->range_start;
+        derived.testnet = options->testnet || root.testnet;
+        derived.ordered = 1;
+        result = run_key_blocks(count, &derived, derive_key_block, derivation);
+    }
+    
+    bip32_node_wipe(&root);
+    secure_zero_memory(derivation, sizeof(keygen_derivation_t));
+    free(derivation);
+    return result;
+}
+
+static int wallet_key_block(const keygen_options_t *options, const void *source, secmem_arena_t *arena,
+                            int first, int count, char *buffer, size_t buffer_size, size_t *length) {
+    const keygen_wallet_path_t *wallet_path = source;
+    keygen_wallet_block_t *block = secmem_alloc(arena, sizeof(keygen_wallet_block_t));
+    char root_key[BIP32_XKEY_STRING_SIZE];
+    const char *end = buffer + buffer_size;
+    char *p = buffer;
+    int result = 0;
+    
+    (void)first;
+    *length = 0;
+    if (!block) return -1;
+    
+    for (int i = 0; i < count && result == 0; i++) {
+        block->phrases[i] = block->mnemonics[i];
+        result = bip39_generate_mnemonic((size_t)options->mnemonic_words, block->mnemonics[i], BIP39_MNEMONIC_SIZE);
+    }
+    if (result == 0) {
+        result = bip39_mnemonic_to_seed_batch(block->phrases, options->passphrase, (size_t)count, block->seeds);
+    }
+    
+    for (int i = 0; i < count && result == 0; i++) {
+        bip32_node_t node;
         
-        secure_zero_memory(&private_key, sizeof(private_key));
-        secure_zero_memory(&public_key, sizeof(public_key));
-        if (options->with_address) {
-            secure_zero_memory(&address, sizeof(address));
+        result = bip32_from_seed(block->seeds + (size_t)i * BIP39_SEED_SIZE, BIP39_SEED_SIZE, options->testnet,
+                                 &block->nodes[i]);
+        if (result == 0 && wallet_path) {
+            result = bip32_derive_path(&block->nodes[i], wallet_path->indices, wallet_path->depth, &node);
+            memcpy(block->public_keys[i].data, node.public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+            block->public_keys[i].length = COMPRESSED_PUBLIC_KEY_SIZE;
+            bip32_node_wipe(&node);
         }
     }
     
-    return 0;
+    if (result == 0 && wallet_path &&
+        (create_addresses(block->public_keys, block->addresses, (size_t)count, options->address_type, options->testnet) != 0 ||
+         encode_addresses(block->addresses, (size_t)count, options->address_type, options->testnet,
+                          block->address_strings[0], MAX_ADDRESS_STRING_SIZE) != 0)) {
+        result = -1;
+    }
+    
+    for (int i = 0; i < count && result == 0; i++) {
+        if (bip32_serialize(&block->nodes[i], 1, root_key, sizeof(root_key)) != 0) {
+            result = -1;
+            break;
+        }
+        
+        if (options->verbose) {
+            p = append_string(p, end, "Mnemonic: ");
+            p = append_string(p, end, block->mnemonics[i]);
+            p = append_string(p, end, "\nRoot Key: ");
+            p = append_string(p, end, root_key);
+            p = append_string(p, end, "\n");
+            if (wallet_path) {
+                p = append_string(p, end, "Path: ");
+                p = append_string(p, end, wallet_path->path);
+                p = append_string(p, end, "\nBitcoin Address: ");
+                p = append_string(p, end, block->address_strings[i]);
+                p = append_string(p, end, "\n");
+            }
+            p = append_string(p, end, "---\n");
+        } else {
+            p = append_string(p, end, root_key);
+            if (wallet_path) {
+                p = append_string(p, end, " ");
+                p = append_string(p, end, block->address_strings[i]);
+            }
+            p = append_string(p, end, " ");
+            p = append_string(p, end, block->mnemonics[i]);
+            p = append_string(p, end, "\n");
+        }
+        if (!p) {
+            result = -1;
+        }
+    }
+    
+    secure_zero_memory(root_key, sizeof(root_key));
+    *length = result == 0 ? (size_t)(p - buffer) : 0;
+    return result;
 }
 
-int print_key_information(const private_key_t *private_key, const public_key_t *public_key, 
-                         const bitcoin_address_t *address, const keygen_options_t *options) {
-    if (!private_key || !public_key || !options) return -1;
+int generate_wallets(const keygen_options_t *options) {
+    if (!options || options->count <= 0) return -1;
     
-    char hex_private_key[MAX_HEX_STRING_SIZE];
-    char wif_private_key[MAX_WIF_STRING_SIZE];
-    char hex_public_key[MAX_HEX_STRING_SIZE];
-    char address_string[MAX_ADDRESS_STRING_SIZE];
+    keygen_wallet_path_t *wallet_path = NULL;
+    int result;
     
-    if (bytes_to_hex(private_key->data, PRIVATE_KEY_SIZE, hex_private_key, sizeof(hex_private_key)) != 0) {
-        return -1;
+    if (options->derive_path) {
+        wallet_path = calloc(1, sizeof(keygen_wallet_path_t));
+        if (!wallet_path) return -1;
+        if (bip32_parse_path(options->derive_path, wallet_path->indices, BIP32_MAX_PATH_DEPTH, &wallet_path->depth) != 0 ||
+            bip32_format_path(wallet_path->indices, wallet_path->depth, wallet_path->path, sizeof(wallet_path->path)) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Invalid derivation path: %s\n", options->derive_path);
+            }
+            free(wallet_path);
+            return -1;
+        }
     }
     
-    if (private_key_to_wif(private_key, wif_private_key, sizeof(wif_private_key)) != 0) {
-        return -1;
+    result = run_key_blocks(options->count, options, wallet_key_block, wallet_path);
+    
+    free(wallet_path);
+    return result;
+}
+
+static int dump_records(const keystore_record_t *records, size_t count, const keygen_options_t *options,
+                        secmem_arena_t *arena, output_t *out, output_buffer_t *buffer) {
+    private_key_t *private_keys = secmem_alloc(arena, sizeof(private_key_t) * KEYGEN_BLOCK_SIZE);
+    public_key_t public_keys[KEYGEN_BLOCK_SIZE];
+    bitcoin_address_t addresses[KEYGEN_BLOCK_SIZE];
+    char address_strings[KEYGEN_BLOCK_SIZE][MAX_ADDRESS_STRING_SIZE];
+    keygen_options_t record_options = *options;
+    int result = private_keys ? 0 : -1;
+    
+    if (record_options.format == OUTPUT_FORMAT_BINARY) {
+        record_options.format = OUTPUT_FORMAT_HEX;
     }
     
-    size_t pub_key_len = public_key->length;
-    if (pub_key_len == 0) {
-        pub_key_len = PUBLIC_KEY_SIZE;
+    for (size_t offset = 0; offset < count && result == 0; ) {
+        uint8_t flags = records[offset].flags;
+        size_t run = 0;
+        
+        while (offset + run < count && run < KEYGEN_BLOCK_SIZE && records[offset + run].flags == flags) {
+            if (keystore_record_keys(&records[offset + run], &private_keys[run], &public_keys[run]) != 0) {
+                result = -1;
+                break;
+            }
+            if (requires_compressed(options) && public_keys[run].length == PUBLIC_KEY_SIZE) {
+                public_keys[run].data[0] = (public_keys[run].data[PUBLIC_KEY_SIZE - 1] & 1) ? 0x03 : 0x02;
+                public_keys[run].length = COMPRESSED_PUBLIC_KEY_SIZE;
+            }
+            run++;
+        }
+        
+        record_options.compressed = (flags & KEYSTORE_FLAG_COMPRESSED) != 0 || requires_compressed(options);
+        record_options.testnet = (flags & KEYSTORE_FLAG_TESTNET) != 0;
+        if (result == 0 && options->with_address &&
+            (create_addresses(public_keys, addresses, run, options->address_type, record_options.testnet) != 0 ||
+             encode_addresses(addresses, run, options->address_type, record_options.testnet,
+                              address_strings[0], MAX_ADDRESS_STRING_SIZE) != 0)) {
+            result = -1;
+        }
+        
+        for (size_t i = 0; i < run && result == 0; i++) {
+            if (buffer->capacity - buffer->used < KEYGEN_RECORD_MAX && output_flush(out, buffer) != 0) {
+                result = -1;
+                break;
+            }
+            int written = format_key_record(&private_keys[i], &public_keys[i],
+                                            options->with_address ? address_strings[i] : NULL, &record_options,
+                                            buffer->data + buffer->used, buffer->capacity - buffer->used);
+            if (written < 0) {
+                result = -1;
+            } else {
+                buffer->used += (size_t)written;
+            }
+        }
+        offset += run;
     }
     
-    if (bytes_to_hex(public_key->data, pub_key_len, hex_public_key, sizeof(hex_public_key)) != 0) {
+    secmem_reset(arena);
+    return result;
+}
+
+int dump_keystore(const keygen_options_t *options) {
+    if (!options || !options->dump_path) return -1;
+    
+    keystore_reader_t reader;
+    output_buffer_t buffer;
+    secmem_arena_t arena;
+    output_t *out = keygen_writer(options);
+    const keystore_header_t *header;
+    const keystore_record_t *records;
+    int result = 0;
+    int status;
+    
+    if (!out) return -1;
+    if (keystore_open(&reader, options->dump_path) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to open key store: %s\n", options->dump_path);
+        }
+        return -1;
+    }
+    if (output_buffer_init(&buffer, OUTPUT_BUFFER_SIZE) != 0) {
+        keystore_close(&reader);
+        return -1;
+    }
+    if (secmem_arena_init(&arena, sizeof(private_key_t) * KEYGEN_BLOCK_SIZE) != 0) {
+        output_buffer_free(&buffer);
+        keystore_close(&reader);
         return -1;
     }
     
-    if (address && base58_encode(address->data, address->length, address_string, sizeof(address_string)) != 0) {
+    while (result == 0 && (status = keystore_next_block(&reader, &header, &records)) > 0) {
+        result = dump_records(records, header->record_count, options, &arena, out, &buffer);
+    }
+    if (result == 0 && status < 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Corrupt key store block at offset %zu\n", reader.offset);
+        }
+        result = -1;
+    }
+    if (output_flush(out, &buffer) != 0) {
+        result = -1;
+    }
+    
+    secmem_arena_free(&arena);
+    output_buffer_free(&buffer);
+    keystore_close(&reader);
+    return result;
+}
+
+int index_keystore(const keygen_options_t *options) {
+    if (!options || !options->index_path) return -1;
+    
+    char path[PATH_MAX];
+    size_t count = 0;
+    
+    if (keyindex_path(options->index_path, path, sizeof(path)) != 0 ||
+        keyindex_build(options->index_path, path, &count) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to index key store: %s\n", options->index_path);
+        }
         return -1;
     }
     
     if (options->verbose) {
-        printf("Private Key (Hex): %s\n", hex_private_key);
-        printf("Private Key (WIF): %s\n", wif_private_key);
-        printf("Public Key (Hex): %s\n", hex_public_key);
-        if (address) {
-            printf("Bitcoin Address: %s\n", address_string);
+        fprintf(stderr, "Indexed %zu keys into %s\n", count, path);
+    }
+    return 0;
+}
+
+static int lookup_block(const keyindex_t *index, char (*addresses)[MAX_ADDRESS_STRING_SIZE], size_t count,
+                        const keygen_options_t *options, private_key_t *private_key, output_t *out,
+                        output_buffer_t *buffer, size_t *missing) {
+    uint8_t programs[KEYGEN_BLOCK_SIZE * KEYINDEX_PROGRAM_SIZE];
+    address_type_t types[KEYGEN_BLOCK_SIZE];
+    const keystore_record_t *records[KEYGEN_BLOCK_SIZE];
+    int compressed[KEYGEN_BLOCK_SIZE];
+    size_t slots[KEYGEN_BLOCK_SIZE];
+    size_t queries = 0;
+    int result = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        uint8_t program[SEGWIT_MAX_PROGRAM];
+        size_t program_len;
+        address_type_t type;
+        int testnet;
+        
+        if (address_decode(addresses[i], &type, &testnet, program, &program_len) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Invalid address: %s\n", addresses[i]);
+            }
+            (*missing)++;
+        } else if (type == ADDRESS_TYPE_P2WSH) {
+            if (!options->quiet) {
+                fprintf(stderr, "Unsupported address type: %s\n", addresses[i]);
+            }
+            (*missing)++;
+        } else {
+            memcpy(programs + queries * KEYINDEX_PROGRAM_SIZE, program, program_len);
+            types[queries] = type;
+            slots[queries++] = i;
         }
-        printf("---\n");
-    } else {
-        switch (options->format) {
-            case OUTPUT_FORMAT_HEX:
-                printf("%s", hex_private_key);
-                break;
-            case OUTPUT_FORMAT_WIF:
-                printf("%s", wif_private_key);
-                break;
-            case OUTPUT_FORMAT_BINARY:
-                print_hex(private_key->data, PRIVATE_KEY_SIZE);
-                break;
+    }
+    
+    if (queries > 0) {
+        keyindex_lookup_batch(index, types, programs, queries, records, compressed);
+    }
+    
+    for (size_t q = 0; q < queries && result == 0; q++) {
+        const char *address = addresses[slots[q]];
+        public_key_t public_key;
+        
+        if (!records[q]) {
+            if (!options->quiet) {
+                fprintf(stderr, "Address not found: %s\n", address);
+            }
+            (*missing)++;
+            continue;
         }
         
-        if (options->with_address && address) {
-            printf(" %s", address_string);
+        keygen_options_t record_options = *options;
+        record_options.with_address = 1;
+        record_options.address_type = types[q];
+        record_options.compressed = compressed[q];
+        record_options.testnet = (records[q]->flags & KEYSTORE_FLAG_TESTNET) != 0;
+        if (record_options.format == OUTPUT_FORMAT_BINARY) {
+            record_options.format = OUTPUT_FORMAT_HEX;
+        }
+        
+        if (keystore_record_keys(records[q], private_key, &public_key) != 0 ||
+            (buffer->capacity - buffer->used < KEYGEN_RECORD_MAX && output_flush(out, buffer) != 0)) {
+            result = -1;
+        } else {
+            if (compressed[q]) {
+                memcpy(public_key.data, records[q]->public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+                public_key.length = COMPRESSED_PUBLIC_KEY_SIZE;
+            }
+            int written = format_key_record(private_key, &public_key, address, &record_options,
+                                            buffer->data + buffer->used, buffer->capacity - buffer->used);
+            if (written < 0) {
+                result = -1;
+            } else {
+                buffer->used += (size_t)written;
+            }
         }
-        printf("\n");
     }
     
-    return 0;
+    return result;
+}
+
+int lookup_addresses(const keygen_options_t *options) {
+    if (!options || !options->index_path || !options->lookup) return -1;
+    
+    char path[PATH_MAX];
+    keyindex_t index;
+    output_buffer_t buffer;
+    output_t *out = keygen_writer(options);
+    size_t missing = 0;
+    int result = 0;
+    
+    if (!out) return -1;
+    if (keyindex_path(options->index_path, path, sizeof(path)) != 0 ||
+        keyindex_open(&index, options->index_path, path) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to open key index %s, rebuild it with --index %s\n", path, options->index_path);
+        }
+        return -1;
+    }
+    if (output_buffer_init(&buffer, OUTPUT_BUFFER_SIZE) != 0) {
+        keyindex_close(&index);
+        return -1;
+    }
+    
+    char (*addresses)[MAX_ADDRESS_STRING_SIZE] = malloc(KEYGEN_BLOCK_SIZE * sizeof(*addresses));
+    private_key_t *private_key = secmem_map(sizeof(private_key_t));
+    if (!addresses || !private_key) {
+        result = -1;
+    } else if (strcmp(options->lookup, "-") != 0) {
+        snprintf(addresses[0], MAX_ADDRESS_STRING_SIZE, "%s", options->lookup);
+        result = lookup_block(&index, addresses, 1, options, private_key, out, &buffer, &missing);
+    } else {
+        char *line = NULL;
+        size_t line_size = 0;
+        size_t count = 0;
+        
+        while (result == 0 && getline(&line, &line_size, stdin) >= 0) {
+            trim_string(line);
+            if (line[0] == '\0') continue;
+            snprintf(addresses[count++], MAX_ADDRESS_STRING_SIZE, "%s", line);
+            if (count == KEYGEN_BLOCK_SIZE) {
+                result = lookup_block(&index, addresses, count, options, private_key, out, &buffer, &missing);
+                count = 0;
+            }
+        }
+        if (result == 0 && count > 0) {
+            result = lookup_block(&index, addresses, count, options, private_key, out, &buffer, &missing);
+        }
+        free(line);
+    }
+    
+    if (output_flush(out, &buffer) != 0 || missing) {
+        result = -1;
+    }
+    
+    free(addresses);
+    secmem_unmap(private_key, sizeof(private_key_t));
+    output_buffer_free(&buffer);
+    keyindex_close(&index);
+    return result;
+}
+
+int print_key_information(const private_key_t *private_key, const public_key_t *public_key, 
+                         const bitcoin_address_t *address, const keygen_options_t *options) {
+    char record[KEYGEN_RECORD_MAX];
+    output_t *out = keygen_writer(options);
+    
+    if (!out) {
+        return -1;
+    }
+    
+    int written = format_key_information(private_key, public_key, address, options, record, sizeof(record));
+    if (written < 0) {
+        return -1;
+    }
+    
+    int result = output_write(out, record, (size_t)written);
+    secure_zero_memory(record, (size_t)written);
+    
+    return result;
 }
 
 int parse_command_line_args(int argc, char *argv[], keygen_options_t *options) {
@@ -140,6 +1818,8 @@ int parse_command_line_args(int argc, char *argv[], keygen_options_t *options) {
     memset(options, 0, sizeof(keygen_options_t));
     options->count = 1;
     options->format = OUTPUT_FORMAT_HEX;
+    options->threads = 1;
+    options->mnemonic_words = BIP39_DEFAULT_WORDS;
     
     static struct option long_options[] = {
         {"count", required_argument, 0, 'c'},
@@ -149,13 +1829,43 @@ int parse_command_line_args(int argc, char *argv[], keygen_options_t *options) {
         {"testnet", no_argument, 0, 't'},
         {"verbose", no_argument, 0, 'v'},
         {"quiet", no_argument, 0, 'q'},
+        {"threads", required_argument, 0, 'j'},
+        {"ordered", no_argument, 0, OPT_ORDERED},
+        {"output", required_argument, 0, 'o'},
+        {"io-uring", no_argument, 0, OPT_IO_URING},
+        {"address-type", required_argument, 0, OPT_ADDRESS_TYPE},
+        {"derive", required_argument, 0, OPT_DERIVE},
+        {"range", required_argument, 0, OPT_RANGE},
+        {"xkey", required_argument, 0, OPT_XKEY},
+        {"multisig", required_argument, 0, OPT_MULTISIG},
+        {"seed", required_argument, 0, OPT_SEED},
+        {"serve", required_argument, 0, OPT_SERVE},
+        {"pool-size", required_argument, 0, OPT_POOL_SIZE},
+        {"mnemonic", no_argument, 0, OPT_MNEMONIC},
+        {"words", required_argument, 0, OPT_WORDS},
+        {"passphrase", required_argument, 0, OPT_PASSPHRASE},
+        {"phrase", required_argument, 0, OPT_PHRASE},
+        {"dump", required_argument, 0, OPT_DUMP},
+        {"index", required_argument, 0, OPT_INDEX},
+        {"lookup", required_argument, 0, OPT_LOOKUP},
+        {"input", required_argument, 0, OPT_INPUT},
+        {"validate", required_argument, 0, OPT_VALIDATE},
+        {"sign", required_argument, 0, OPT_SIGN},
+        {"verify", required_argument, 0, OPT_VERIFY},
+        {"schnorr", no_argument, 0, OPT_SCHNORR},
+        {"pipeline", no_argument, 0, OPT_PIPELINE},
+        {"pin", no_argument, 0, OPT_PIN},
+        {"stats", no_argument, 0, OPT_STATS},
+        {"progress", no_argument, 0, OPT_PROGRESS},
+        {"table-bits", required_argument, 0, OPT_TABLE_BITS},
+        {"table-file", required_argument, 0, OPT_TABLE_FILE},
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'V'},
         {0, 0, 0, 0}
     };
     
     int opt;
-    while ((opt = getopt_long(argc, argv, "c:f:aptvqhV", long_options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "c:f:aptvqj:o:hV", long_options, NULL)) != -1) {
         switch (opt) {
             case 'c':
                 options->count = atoi(optarg);
@@ -191,6 +1901,152 @@ int parse_command_line_args(int argc, char *argv[], keygen_options_t *options) {
             case 'q':
                 options->quiet = 1;
                 break;
+            case 'j':
+                options->threads = atoi(optarg);
+                if (options->threads < 0 || options->threads > POOL_MAX_THREADS) {
+                    fprintf(stderr, "Invalid thread count: %s\n", optarg);
+                    return -1;
+                }
+                if (options->threads == 0) {
+                    options->threads = pool_cpu_count();
+                }
+                break;
+            case OPT_ORDERED:
+                options->ordered = 1;
+                break;
+            case 'o':
+                options->output_path = optarg;
+                break;
+            case OPT_IO_URING:
+                options->io_uring = 1;
+                break;
+            case OPT_ADDRESS_TYPE:
+                if (string_equals(optarg, "p2pkh")) {
+                    options->address_type = ADDRESS_TYPE_P2PKH;
+                } else if (string_equals(optarg, "p2sh")) {
+                    options->address_type = ADDRESS_TYPE_P2SH;
+                } else if (string_equals(optarg, "p2wpkh")) {
+                    options->address_type = ADDRESS_TYPE_P2WPKH;
+                } else if (string_equals(optarg, "p2tr")) {
+                    options->address_type = ADDRESS_TYPE_P2TR;
+                } else if (string_equals(optarg, "p2wsh")) {
+                    options->address_type = ADDRESS_TYPE_P2WSH;
+                } else {
+                    fprintf(stderr, "Invalid address type: %s\n", optarg);
+                    return -1;
+                }
+                options->with_address = 1;
+                if (options->address_type != ADDRESS_TYPE_P2PKH) {
+                    options->compressed = 1;
+                }
+                break;
+            case OPT_DERIVE:
+                options->derive_path = optarg;
+                break;
+            case OPT_RANGE: {
+                char *separator;
+                unsigned long start = strtoul(optarg, &separator, 10);
+                unsigned long range_end = *separator == ':' ? strtoul(separator + 1, NULL, 10) : 0;
+                if (*separator != ':' || range_end <= start || range_end > BIP32_HARDENED ||
+                    range_end - start > (unsigned long)INT_MAX) {
+                    fprintf(stderr, "Invalid range: %s\n", optarg);
+                    return -1;
+                }
+                options->range_start = (uint32_t)start;
+                options->range_end = (uint32_t)range_end;
+                break;
+            }
+            case OPT_XKEY:
+                if (options->xkey_count == MULTISIG_MAX_KEYS) {
+                    fprintf(stderr, "Too many extended keys (maximum %d)\n", MULTISIG_MAX_KEYS);
+                    return -1;
+                }
+                options->xkey = optarg;
+                options->xkeys[options->xkey_count++] = optarg;
+                break;
+            case OPT_MULTISIG:
+                options->multisig = atoi(optarg);
+                if (options->multisig < 1 || options->multisig > MULTISIG_MAX_KEYS) {
+                    fprintf(stderr, "Invalid multisig threshold: %s (must be 1-%d)\n", optarg, MULTISIG_MAX_KEYS);
+                    return -1;
+                }
+                break;
+            case OPT_SEED:
+                options->seed = optarg;
+                break;
+            case OPT_SERVE:
+                options->serve_path = optarg;
+                break;
+            case OPT_MNEMONIC:
+                options->mnemonic = 1;
+                break;
+            case OPT_WORDS:
+                options->mnemonic_words = atoi(optarg);
+                if (options->mnemonic_words < BIP39_MIN_WORDS || options->mnemonic_words > BIP39_MAX_WORDS ||
+                    options->mnemonic_words % 3 != 0) {
+                    fprintf(stderr, "Invalid word count: %s\n", optarg);
+                    return -1;
+                }
+                break;
+            case OPT_PASSPHRASE:
+                options->passphrase = optarg;
+                break;
+            case OPT_PHRASE:
+                options->phrase = optarg;
+                break;
+            case OPT_DUMP:
+                options->dump_path = optarg;
+                break;
+            case OPT_INDEX:
+                options->index_path = optarg;
+                break;
+            case OPT_LOOKUP:
+                options->lookup = optarg;
+                break;
+            case OPT_INPUT:
+                options->input_path = optarg;
+                break;
+            case OPT_VALIDATE:
+                options->validate_path = optarg;
+                break;
+            case OPT_SIGN:
+                options->sign_path = optarg;
+                break;
+            case OPT_VERIFY:
+                options->verify_path = optarg;
+                break;
+            case OPT_SCHNORR:
+                options->schnorr = 1;
+                break;
+            case OPT_PIPELINE:
+                options->pipeline = 1;
+                break;
+            case OPT_PIN:
+                options->pin_threads = 1;
+                break;
+            case OPT_STATS:
+                options->stats = 1;
+                break;
+            case OPT_PROGRESS:
+                options->progress = 1;
+                break;
+            case OPT_TABLE_BITS:
+                options->table_bits = (unsigned int)atoi(optarg);
+                if (options->table_bits < EC_MIN_TABLE_BITS || options->table_bits > EC_MAX_TABLE_BITS) {
+                    fprintf(stderr, "Invalid table bits: %s (must be %d-%d)\n", optarg, EC_MIN_TABLE_BITS, EC_MAX_TABLE_BITS);
+                    return -1;
+                }
+                break;
+            case OPT_TABLE_FILE:
+                options->table_path = optarg;
+                break;
+            case OPT_POOL_SIZE:
+                options->pool_size = atoi(optarg);
+                if (options->pool_size <= 0 || options->pool_size > SERVER_MAX_POOL_SIZE) {
+                    fprintf(stderr, "Invalid pool size: %s\n", optarg);
+                    return -1;
+                }
+                break;
             case 'h':
                 print_usage(argv[0]);
                 exit(0);
@@ -203,6 +2059,15 @@ int parse_command_line_args(int argc, char *argv[], keygen_options_t *options) {
         }
     }
     
+    if (options->multisig && options->address_type != ADDRESS_TYPE_P2SH && options->address_type != ADDRESS_TYPE_P2WSH) {
+        fprintf(stderr, "--multisig requires --address-type p2sh or p2wsh\n");
+        return -1;
+    }
+    if (!options->multisig && options->address_type == ADDRESS_TYPE_P2WSH) {
+        fprintf(stderr, "--address-type p2wsh requires --multisig\n");
+        return -1;
+    }
+    
     return 0;
 }
 
@@ -211,12 +2076,44 @@ void print_usage(const char *program_name) {
     printf("Generate Bitcoin private keys and addresses\n\n");
     printf("Options:\n");
     printf("  -c, --count NUM        Generate NUM keys (default: 1)\n");
-    printf("  -f, --format FORMAT    Output format: hex, wif, binary (default: hex)\n");
+    printf("  -f, --format FORMAT    Output format: hex, wif, binary key store (default: hex)\n");
     printf("  -a, --with-address     Include Bitcoin address in output\n");
     printf("  -p, --compressed       Use compressed public key format\n");
     printf("  -t, --testnet          Generate testnet addresses\n");
+    printf("      --address-type T   Address type: p2pkh, p2sh, p2wpkh, p2tr, p2wsh (default: p2pkh)\n");
+    printf("      --derive PATH      Derive child keys below PATH (e.g. m/84'/0'/0'/0)\n");
+    printf("      --range START:END  Child indices to derive, END exclusive (default: 0:COUNT)\n");
+    printf("      --xkey KEY         Extended key (xprv/xpub/tprv/tpub) to derive from; repeat for --multisig\n");
+    printf("      --multisig M       Derive M-of-N multisig addresses from N --xkey cosigners (BIP67 sorted)\n");
+    printf("      --seed HEX         BIP32 seed to derive from\n");
+    printf("      --phrase WORDS     BIP39 mnemonic to derive from\n");
+    printf("      --mnemonic         Generate NUM BIP39 wallets (mnemonic and root key)\n");
+    printf("      --words NUM        Mnemonic length: 12, 15, 18, 21 or 24 words (default: %d)\n", BIP39_DEFAULT_WORDS);
+    printf("      --passphrase TEXT  BIP39 passphrase for --mnemonic and --phrase\n");
+    printf("      --input FILE       Read hex or WIF private keys from FILE (- for stdin) instead of generating\n");
+    printf("      --validate FILE    Check the addresses in FILE (- for stdin) and report invalid lines\n");
+    printf("      --sign FILE        Sign the \"KEY HASH\" lines of FILE (- for stdin) with RFC6979 ECDSA\n");
+    printf("      --schnorr          Sign with BIP340 Schnorr instead of ECDSA\n");
+    printf("      --verify FILE      Check the \"PUBKEY HASH SIGNATURE\" lines of FILE and report invalid lines\n");
+    printf("      --dump FILE        Print the records of a binary key store as text\n");
+    printf("      --index FILE       Build FILE.idx, a hash160 index over a binary key store\n");
+    printf("      --lookup ADDRESS   Find the key for ADDRESS (- reads addresses from stdin) using --index\n");
+    printf("      --serve SOCKET     Serve watch-only xpub addresses on a Unix socket\n");
+    printf("      --pool-size NUM    Addresses kept pre-derived per xpub when serving (default: %d)\n", SERVER_DEFAULT_POOL_SIZE);
     printf("  -v, --verbose          Verbose output\n");
     printf("  -q, --quiet            Suppress error messages\n");
+    printf("  -j, --threads NUM      Generate with NUM worker threads, 0 for all cores (default: 1)\n");
+    printf("      --ordered          Keep output in generation order when using threads\n");
+    printf("      --pipeline         Generate through staged threads (keys, EC, hashing, encoding, output)\n");
+    printf("      --pin              Pin pipeline stage threads to CPUs\n");
+    printf("      --stats            Print a JSON summary of per-stage timings to stderr on exit\n");
+    printf("      --progress         Print key rate and progress to stderr every second\n");
+    printf("      --table-bits NUM   Window size of the precomputed EC table, %d-%d (default: %d)\n",
+           EC_MIN_TABLE_BITS, EC_MAX_TABLE_BITS, EC_DEFAULT_TABLE_BITS);
+    printf("      --table-file FILE  Load the EC table from FILE, writing it there first if missing or stale\n");
+    printf("                         (default: ~/.cache/btc_keygen/secp256k1-BITS.tbl)\n");
+    printf("  -o, --output FILE      Write keys to FILE instead of standard output\n");
+    printf("      --io-uring         Write FILE output through io_uring when available\n");
     printf("  -h, --help             Show this help message\n");
     printf("  -V, --version          Show version information\n\n");
     printf("Examples:\n");
@@ -224,6 +2121,16 @@ void print_usage(const char *program_name) {
     printf("  %s -c 10               Generate 10 keys\n", program_name);
     printf("  %s -f wif -a           Generate WIF format with address\n", program_name);
     printf("  %s -v -p               Verbose output with compressed key\n", program_name);
+    printf("  %s -c 1000000 -j 0     Generate 1000000 keys on all cores\n", program_name);
+    printf("  %s --address-type p2tr Generate a key with its Taproot address\n", program_name);
+    printf("  %s --xkey XPRV --derive \"m/84'/0'/0'/0\" --range 0:1000 --address-type p2wpkh\n", program_name);
+    printf("                         Derive 1000 receive addresses\n");
+    printf("  %s --multisig 2 --xkey XPUB1 --xkey XPUB2 --xkey XPUB3 --derive m/0 --range 0:1000 --address-type p2wsh\n", program_name);
+    printf("                         Derive 1000 2-of-3 multisig P2WSH addresses from three cosigners\n");
+    printf("  %s --mnemonic -c 1000 -j 0 --derive \"m/84'/0'/0'/0/0\" --address-type p2wpkh\n", program_name);
+    printf("                         Create 1000 wallets with their first receive address\n");
+    printf("  %s --index keys.bin --lookup - < deposits.txt\n", program_name);
+    printf("                         Find the keys owning a list of addresses\n");
 }
 
 void print_version(void) {
@@ -0,0 +1,405 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "keyindex.h"
+
+typedef struct {
+    uint64_t key;
+    uint64_t offset;
+} index_entry_t;
+
+static inline uint64_t hash_key(const uint8_t *hash160) {
+    uint64_t key = 0;
+    for (int i = 0; i < 8; i++) {
+        key = (key << 8) | hash160[i];
+    }
+    return key;
+}
+
+static size_t index_file_size(size_t count) {
+    return KEYINDEX_HEADER_SIZE + 2 * (count + 1) * sizeof(uint64_t);
+}
+
+static void radix_sort(index_entry_t *entries, index_entry_t *scratch, size_t count) {
+    index_entry_t *source = entries;
+    index_entry_t *target = scratch;
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t counts[256] = {0};
+        size_t position = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            counts[(source[i].key >> shift) & 0xFF]++;
+        }
+        if (counts[(source[0].key >> shift) & 0xFF] == count) continue;
+
+        for (int d = 0; d < 256; d++) {
+            size_t n = counts[d];
+            counts[d] = position;
+            position += n;
+        }
+        for (size_t i = 0; i < count; i++) {
+            target[counts[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+
+        index_entry_t *swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != entries) {
+        memcpy(entries, source, count * sizeof(index_entry_t));
+    }
+}
+
+static size_t eytzinger_fill(const index_entry_t *sorted, uint64_t *keys, uint64_t *offsets,
+                             size_t i, size_t k, size_t count) {
+    if (k <= count) {
+        i = eytzinger_fill(sorted, keys, offsets, i, 2 * k, count);
+        keys[k] = sorted[i].key;
+        offsets[k] = sorted[i].offset;
+        i = eytzinger_fill(sorted, keys, offsets, i + 1, 2 * k + 1, count);
+    }
+    return i;
+}
+
+static inline size_t eytzinger_next(size_t k, size_t count) {
+    if (2 * k + 1 <= count) {
+        k = 2 * k + 1;
+        while (2 * k <= count) {
+            k *= 2;
+        }
+        return k;
+    }
+    return k >> __builtin_ffsll((long long)~k);
+}
+
+static const uint8_t *address_program(const bitcoin_address_t *address, address_type_t type) {
+    return type == ADDRESS_TYPE_P2SH ? address->data + 1 : address->data;
+}
+
+static size_t program_size(address_type_t type) {
+    return type == ADDRESS_TYPE_P2TR ? KEYINDEX_PROGRAM_SIZE : HASH160_SIZE;
+}
+
+static int append_entries(const keystore_reader_t *store, const keystore_record_t *records, size_t count,
+                          public_key_t *public_keys, bitcoin_address_t *addresses, index_entry_t *entries,
+                          size_t *used) {
+    static const address_type_t types[] = { ADDRESS_TYPE_P2WPKH, ADDRESS_TYPE_P2SH, ADDRESS_TYPE_P2TR };
+    static const uint64_t kinds[] = { KEYINDEX_KIND_COMPRESSED_HASH, KEYINDEX_KIND_SCRIPT_HASH, KEYINDEX_KIND_TAPROOT };
+
+    for (size_t i = 0; i < count; i++) {
+        memcpy(public_keys[i].data, records[i].public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+        public_keys[i].length = COMPRESSED_PUBLIC_KEY_SIZE;
+        entries[*used].key = hash_key(records[i].hash160);
+        entries[*used].offset = (uint64_t)((const uint8_t *)&records[i] - store->data) | KEYINDEX_KIND_KEY_HASH;
+        (*used)++;
+    }
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        if (create_addresses(public_keys, addresses, count, types[t], 0) != 0) return -1;
+        for (size_t i = 0; i < count; i++) {
+            if (kinds[t] == KEYINDEX_KIND_COMPRESSED_HASH && (records[i].flags & KEYSTORE_FLAG_COMPRESSED)) continue;
+            entries[*used].key = hash_key(address_program(&addresses[i], types[t]));
+            entries[*used].offset = (uint64_t)((const uint8_t *)&records[i] - store->data) | kinds[t];
+            (*used)++;
+        }
+    }
+    return 0;
+}
+
+static int collect_entries(keystore_reader_t *store, index_entry_t **entries, size_t *count) {
+    const keystore_header_t *header;
+    const keystore_record_t *records;
+    size_t capacity = 0;
+    int status;
+
+    *entries = NULL;
+    *count = 0;
+
+    public_key_t *public_keys = malloc(KEYSTORE_MAX_BLOCK_RECORDS * sizeof(public_key_t));
+    bitcoin_address_t *addresses = malloc(KEYSTORE_MAX_BLOCK_RECORDS * sizeof(bitcoin_address_t));
+    if (!public_keys || !addresses) {
+        free(public_keys);
+        free(addresses);
+        return -1;
+    }
+
+    while ((status = keystore_next_block(store, &header, &records)) > 0) {
+        size_t needed = *count + (size_t)header->record_count * KEYINDEX_MAX_KINDS;
+        if (needed > capacity) {
+            size_t grown = capacity ? capacity * 2 : 65536;
+            while (grown < needed) {
+                grown *= 2;
+            }
+            index_entry_t *resized = realloc(*entries, grown * sizeof(index_entry_t));
+            if (!resized) {
+                status = -1;
+                break;
+            }
+            *entries = resized;
+            capacity = grown;
+        }
+        if (append_entries(store, records, header->record_count, public_keys, addresses, *entries, count) != 0) {
+            status = -1;
+            break;
+        }
+    }
+
+    free(public_keys);
+    free(addresses);
+    if (status < 0) {
+        free(*entries);
+        *entries = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+int keyindex_path(const char *store_path, char *path, size_t path_size) {
+    if (!store_path || !path) return -1;
+
+    int written = snprintf(path, path_size, "%s%s", store_path, KEYINDEX_SUFFIX);
+    return written < 0 || (size_t)written >= path_size ? -1 : 0;
+}
+
+static int write_index(const char *index_path, const index_entry_t *entries, size_t count,
+                       const keystore_reader_t *store) {
+    int fd = open(index_path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) return -1;
+
+    size_t size = index_file_size(count);
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    uint8_t *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return -1;
+
+    keyindex_header_t *header = (keyindex_header_t *)data;
+    uint64_t *keys = (uint64_t *)(data + KEYINDEX_HEADER_SIZE);
+    uint64_t *offsets = keys + count + 1;
+
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, KEYINDEX_MAGIC, KEYINDEX_MAGIC_SIZE);
+    header->version = KEYINDEX_VERSION;
+    header->header_size = KEYINDEX_HEADER_SIZE;
+    header->entry_count = count;
+    header->store_size = store->size;
+    if (count) {
+        memcpy(header->store_checksum, ((const keystore_header_t *)store->data)->checksum, SHA256_DIGEST_SIZE);
+    }
+    keys[0] = 0;
+    offsets[0] = 0;
+    eytzinger_fill(entries, keys, offsets, 0, 1, count);
+
+    int result = msync(data, size, MS_SYNC) == 0 ? 0 : -1;
+    munmap(data, size);
+    return result;
+}
+
+int keyindex_build(const char *store_path, const char *index_path, size_t *count) {
+    if (!store_path || !index_path) return -1;
+
+    keystore_reader_t store;
+    index_entry_t *entries;
+    size_t entry_count;
+    int result = -1;
+
+    if (keystore_open(&store, store_path) != 0) return -1;
+    if (collect_entries(&store, &entries, &entry_count) != 0) {
+        keystore_close(&store);
+        return -1;
+    }
+
+    index_entry_t *scratch = malloc((entry_count ? entry_count : 1) * sizeof(index_entry_t));
+    if (scratch) {
+        if (entry_count) {
+            radix_sort(entries, scratch, entry_count);
+        }
+        result = write_index(index_path, entries, entry_count, &store);
+    }
+
+    free(scratch);
+    free(entries);
+    keystore_close(&store);
+    if (result == 0 && count) {
+        *count = entry_count;
+    }
+    return result;
+}
+
+int keyindex_open(keyindex_t *index, const char *store_path, const char *index_path) {
+    if (!index || !store_path || !index_path) return -1;
+
+    struct stat st;
+
+    memset(index, 0, sizeof(*index));
+    index->fd = -1;
+    if (keystore_open(&index->store, store_path) != 0) return -1;
+
+    index->fd = open(index_path, O_RDONLY | O_CLOEXEC);
+    if (index->fd < 0 || fstat(index->fd, &st) != 0 || (size_t)st.st_size < KEYINDEX_HEADER_SIZE) {
+        keyindex_close(index);
+        return -1;
+    }
+
+    index->size = (size_t)st.st_size;
+    void *data = mmap(NULL, index->size, PROT_READ, MAP_PRIVATE, index->fd, 0);
+    if (data == MAP_FAILED) {
+        keyindex_close(index);
+        return -1;
+    }
+    index->data = data;
+
+    const keyindex_header_t *header = (const keyindex_header_t *)index->data;
+    if (memcmp(header->magic, KEYINDEX_MAGIC, KEYINDEX_MAGIC_SIZE) != 0 ||
+        header->version != KEYINDEX_VERSION ||
+        header->header_size != KEYINDEX_HEADER_SIZE ||
+        header->entry_count > (index->size - KEYINDEX_HEADER_SIZE) / (2 * sizeof(uint64_t)) ||
+        index_file_size(header->entry_count) != index->size ||
+        header->store_size != index->store.size ||
+        (header->entry_count &&
+         (index->store.size < KEYSTORE_HEADER_SIZE + KEYSTORE_RECORD_SIZE ||
+          memcmp(header->store_checksum, ((const keystore_header_t *)index->store.data)->checksum,
+                 SHA256_DIGEST_SIZE) != 0))) {
+        keyindex_close(index);
+        return -1;
+    }
+
+    index->count = header->entry_count;
+    index->keys = (const uint64_t *)(index->data + KEYINDEX_HEADER_SIZE);
+    index->offsets = index->keys + index->count + 1;
+    madvise(data, index->size, MADV_RANDOM);
+    if (index->store.data) {
+        madvise((void *)index->store.data, index->store.size, MADV_RANDOM);
+    }
+    return 0;
+}
+
+void keyindex_close(keyindex_t *index) {
+    if (!index) return;
+
+    if (index->data) {
+        munmap((void *)index->data, index->size);
+    }
+    if (index->fd >= 0) {
+        close(index->fd);
+    }
+    keystore_close(&index->store);
+    memset(index, 0, sizeof(*index));
+    index->fd = -1;
+}
+
+static int record_matches(const keystore_record_t *record, uint64_t kind, address_type_t type,
+                          const uint8_t *program, int *compressed) {
+    int record_compressed = (record->flags & KEYSTORE_FLAG_COMPRESSED) != 0;
+    address_type_t derived;
+
+    switch (kind) {
+        case KEYINDEX_KIND_KEY_HASH:
+            if (type != ADDRESS_TYPE_P2PKH && !(type == ADDRESS_TYPE_P2WPKH && record_compressed)) return 0;
+            if (memcmp(record->hash160, program, HASH160_SIZE) != 0) return 0;
+            *compressed = record_compressed;
+            return 1;
+        case KEYINDEX_KIND_COMPRESSED_HASH:
+            if (type != ADDRESS_TYPE_P2PKH && type != ADDRESS_TYPE_P2WPKH) return 0;
+            derived = ADDRESS_TYPE_P2WPKH;
+            break;
+        case KEYINDEX_KIND_SCRIPT_HASH:
+            if (type != ADDRESS_TYPE_P2SH) return 0;
+            derived = ADDRESS_TYPE_P2SH;
+            break;
+        case KEYINDEX_KIND_TAPROOT:
+            if (type != ADDRESS_TYPE_P2TR) return 0;
+            derived = ADDRESS_TYPE_P2TR;
+            break;
+        default:
+            return 0;
+    }
+
+    public_key_t public_key;
+    bitcoin_address_t address;
+
+    memcpy(public_key.data, record->public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+    public_key.length = COMPRESSED_PUBLIC_KEY_SIZE;
+    if (create_addresses(&public_key, &address, 1, derived, 0) != 0 ||
+        memcmp(address_program(&address, derived), program, program_size(derived)) != 0) {
+        return 0;
+    }
+    *compressed = 1;
+    return 1;
+}
+
+static const keystore_record_t *match_record(const keyindex_t *index, size_t k, uint64_t key, address_type_t type,
+                                             const uint8_t *program, int *compressed) {
+    while (k != 0 && index->keys[k] == key) {
+        uint64_t offset = index->offsets[k] & ~(uint64_t)KEYINDEX_KIND_MASK;
+        if (offset <= index->store.size - KEYSTORE_RECORD_SIZE) {
+            const keystore_record_t *record = (const keystore_record_t *)(index->store.data + offset);
+            if (record_matches(record, index->offsets[k] & KEYINDEX_KIND_MASK, type, program, compressed)) {
+                return record;
+            }
+        }
+        k = eytzinger_next(k, index->count);
+    }
+    return NULL;
+}
+
+const keystore_record_t *keyindex_lookup(const keyindex_t *index, address_type_t type, const uint8_t *program,
+                                         int *compressed) {
+    if (!index || !program || !compressed || index->count == 0) return NULL;
+
+    uint64_t key = hash_key(program);
+    size_t k = 1;
+
+    while (k <= index->count) {
+        __builtin_prefetch(index->keys + k * KEYINDEX_PREFETCH_STRIDE);
+        k = 2 * k + (index->keys[k] < key);
+    }
+    k >>= __builtin_ffsll((long long)~k);
+
+    return match_record(index, k, key, type, program, compressed);
+}
+
+void keyindex_lookup_batch(const keyindex_t *index, const address_type_t *types, const uint8_t *programs, size_t count,
+                           const keystore_record_t **records, int *compressed) {
+    if (!index || !types || !programs || !records || !compressed) return;
+
+    for (size_t base = 0; base < count; base += KEYINDEX_BATCH_SIZE) {
+        size_t n = count - base < KEYINDEX_BATCH_SIZE ? count - base : KEYINDEX_BATCH_SIZE;
+        uint64_t keys[KEYINDEX_BATCH_SIZE];
+        size_t positions[KEYINDEX_BATCH_SIZE];
+        int active = index->count > 0;
+
+        for (size_t i = 0; i < n; i++) {
+            keys[i] = hash_key(programs + (base + i) * KEYINDEX_PROGRAM_SIZE);
+            positions[i] = 1;
+        }
+
+        while (active) {
+            active = 0;
+            for (size_t i = 0; i < n; i++) {
+                size_t k = positions[i];
+                if (k <= index->count) {
+                    __builtin_prefetch(index->keys + k * KEYINDEX_PREFETCH_STRIDE);
+                    positions[i] = 2 * k + (index->keys[k] < keys[i]);
+                    active = 1;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            size_t k = index->count ? positions[i] >> __builtin_ffsll((long long)~positions[i]) : 0;
+            compressed[base + i] = 0;
+            records[base + i] = match_record(index, k, keys[i], types[base + i],
+                                             programs + (base + i) * KEYINDEX_PROGRAM_SIZE, &compressed[base + i]);
+        }
+    }
+}
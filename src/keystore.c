@@ -0,0 +1,194 @@
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "keystore.h"
+#include "ec.h"
+
+static void block_checksum(const keystore_header_t *header, const keystore_record_t *records, uint8_t *digest) {
+    sha256_ctx_t ctx;
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, (const uint8_t *)header, KEYSTORE_CHECKSUM_OFFSET);
+    sha256_update(&ctx, (const uint8_t *)records, (size_t)header->record_count * KEYSTORE_RECORD_SIZE);
+    sha256_final(&ctx, digest);
+}
+
+size_t keystore_block_size(size_t count) {
+    return KEYSTORE_HEADER_SIZE + count * KEYSTORE_RECORD_SIZE;
+}
+
+int keystore_fill_records(const private_key_t *private_keys, const public_key_t *public_keys, size_t count,
+                          int testnet, keystore_record_t *records) {
+    if (!private_keys || !public_keys || !records) return -1;
+
+    const uint8_t *messages[KEYSTORE_MAX_BLOCK_RECORDS];
+    uint8_t digests[KEYSTORE_MAX_BLOCK_RECORDS * HASH160_SIZE];
+
+    for (size_t offset = 0; offset < count; ) {
+        size_t length = public_keys[offset].length;
+        size_t run = 0;
+
+        if (length != COMPRESSED_PUBLIC_KEY_SIZE && length != PUBLIC_KEY_SIZE) return -1;
+        while (offset + run < count && run < KEYSTORE_MAX_BLOCK_RECORDS && public_keys[offset + run].length == length) {
+            messages[run] = public_keys[offset + run].data;
+            run++;
+        }
+        hash160_batch(messages, length, run, digests);
+
+        for (size_t i = 0; i < run; i++) {
+            const public_key_t *public_key = &public_keys[offset + i];
+            keystore_record_t *record = &records[offset + i];
+
+            memset(record, 0, sizeof(*record));
+            memcpy(record->private_key, private_keys[offset + i].data, PRIVATE_KEY_SIZE);
+            if (length == COMPRESSED_PUBLIC_KEY_SIZE) {
+                memcpy(record->public_key, public_key->data, COMPRESSED_PUBLIC_KEY_SIZE);
+                record->flags = KEYSTORE_FLAG_COMPRESSED;
+            } else {
+                record->public_key[0] = (uint8_t)(0x02 | (public_key->data[PUBLIC_KEY_SIZE - 1] & 1));
+                memcpy(record->public_key + 1, public_key->data + 1, COMPRESSED_PUBLIC_KEY_SIZE - 1);
+            }
+            if (testnet) {
+                record->flags |= KEYSTORE_FLAG_TESTNET;
+            }
+            memcpy(record->hash160, digests + i * HASH160_SIZE, HASH160_SIZE);
+        }
+        offset += run;
+    }
+
+    return 0;
+}
+
+int keystore_record_keys(const keystore_record_t *record, private_key_t *private_key, public_key_t *public_key) {
+    if (!record || !private_key || !public_key) return -1;
+
+    memcpy(private_key->data, record->private_key, PRIVATE_KEY_SIZE);
+    if (record->flags & KEYSTORE_FLAG_COMPRESSED) {
+        memcpy(public_key->data, record->public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+        public_key->length = COMPRESSED_PUBLIC_KEY_SIZE;
+        return 0;
+    }
+
+    ec_point_t point;
+    if (ec_point_parse(&point, record->public_key, COMPRESSED_PUBLIC_KEY_SIZE) != 0) return -1;
+    return ec_point_serialize(&point, public_key->data, &public_key->length, 0);
+}
+
+int keystore_encode_block(const keystore_record_t *records, size_t count, uint8_t *output, size_t output_size,
+                          size_t *length) {
+    if (!records || !output || !length || count == 0 || count > KEYSTORE_MAX_BLOCK_RECORDS) return -1;
+    if (output_size < keystore_block_size(count)) return -1;
+
+    keystore_header_t *header = (keystore_header_t *)output;
+
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, KEYSTORE_MAGIC, KEYSTORE_MAGIC_SIZE);
+    header->version = KEYSTORE_VERSION;
+    header->header_size = KEYSTORE_HEADER_SIZE;
+    header->record_size = KEYSTORE_RECORD_SIZE;
+    header->record_count = (uint32_t)count;
+    memcpy(output + KEYSTORE_HEADER_SIZE, records, count * KEYSTORE_RECORD_SIZE);
+    block_checksum(header, (const keystore_record_t *)(output + KEYSTORE_HEADER_SIZE), header->checksum);
+
+    *length = keystore_block_size(count);
+    return 0;
+}
+
+int keystore_verify_block(const keystore_header_t *header, const keystore_record_t *records) {
+    if (!header || !records) return -1;
+
+    uint8_t digest[SHA256_DIGEST_SIZE];
+
+    if (memcmp(header->magic, KEYSTORE_MAGIC, KEYSTORE_MAGIC_SIZE) != 0 ||
+        header->version != KEYSTORE_VERSION ||
+        header->header_size != KEYSTORE_HEADER_SIZE ||
+        header->record_size != KEYSTORE_RECORD_SIZE ||
+        header->record_count == 0 || header->record_count > KEYSTORE_MAX_BLOCK_RECORDS) {
+        return -1;
+    }
+
+    block_checksum(header, records, digest);
+    return memcmp(digest, header->checksum, SHA256_DIGEST_SIZE) == 0 ? 0 : -1;
+}
+
+int keystore_open(keystore_reader_t *reader, const char *path) {
+    if (!reader || !path) return -1;
+
+    struct stat st;
+
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (reader->fd < 0) return -1;
+
+    if (fstat(reader->fd, &st) != 0) {
+        close(reader->fd);
+        reader->fd = -1;
+        return -1;
+    }
+
+    reader->size = (size_t)st.st_size;
+    if (reader->size > 0) {
+        void *data = mmap(NULL, reader->size, PROT_READ, MAP_PRIVATE, reader->fd, 0);
+        if (data == MAP_FAILED) {
+            close(reader->fd);
+            reader->fd = -1;
+            return -1;
+        }
+        madvise(data, reader->size, MADV_SEQUENTIAL);
+        reader->data = data;
+    }
+
+    return 0;
+}
+
+void keystore_close(keystore_reader_t *reader) {
+    if (!reader) return;
+
+    if (reader->data) {
+        munmap((void *)reader->data, reader->size);
+    }
+    if (reader->fd >= 0) {
+        close(reader->fd);
+    }
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = -1;
+}
+
+int keystore_next_block(keystore_reader_t *reader, const keystore_header_t **header, const keystore_record_t **records) {
+    if (!reader || !header || !records) return -1;
+    if (reader->offset == reader->size) return 0;
+    if (reader->size - reader->offset < KEYSTORE_HEADER_SIZE) return -1;
+
+    const keystore_header_t *block = (const keystore_header_t *)(reader->data + reader->offset);
+    const keystore_record_t *body = (const keystore_record_t *)(reader->data + reader->offset + KEYSTORE_HEADER_SIZE);
+
+    if (block->record_count > KEYSTORE_MAX_BLOCK_RECORDS ||
+        reader->size - reader->offset < keystore_block_size(block->record_count) ||
+        keystore_verify_block(block, body) != 0) {
+        return -1;
+    }
+
+    reader->offset += keystore_block_size(block->record_count);
+    reader->block = block;
+    reader->next_record = 0;
+    *header = block;
+    *records = body;
+    return 1;
+}
+
+int keystore_next_record(keystore_reader_t *reader, const keystore_record_t **record) {
+    if (!reader || !record) return -1;
+
+    while (!reader->block || reader->next_record == reader->block->record_count) {
+        const keystore_header_t *header;
+        const keystore_record_t *records;
+        int result = keystore_next_block(reader, &header, &records);
+        if (result <= 0) return result;
+    }
+
+    const keystore_record_t *records = (const keystore_record_t *)((const uint8_t *)reader->block + KEYSTORE_HEADER_SIZE);
+    *record = &records[reader->next_record++];
+    return 1;
+}
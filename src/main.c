@@ -6,6 +6,10 @@
 #include "crypto.h"
 #include "address.h"
 #include "utils.h"
+#include "server.h"
+#include "stats.h"
+#include "secmem.h"
+#include "ec_table.h"
 
 static volatile int running = 1;
 
@@ -18,14 +22,19 @@ int main(int argc, char *argv[]) {
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
     
-    if (crypto_init() != 0) {
-        fprintf(stderr, "Failed to initialize cryptographic system\n");
+    keygen_options_t options;
+    char table_path[EC_TABLE_PATH_MAX];
+    if (parse_command_line_args(argc, argv, &options) != 0) {
         return 1;
     }
+    secmem_set_quiet(options.quiet);
     
-    keygen_options_t options;
-    if (parse_command_line_args(argc, argv, &options) != 0) {
-        crypto_cleanup();
+    unsigned int table_bits = options.table_bits ? options.table_bits : EC_DEFAULT_TABLE_BITS;
+    if (!options.table_path && ec_table_default_path(table_path, sizeof(table_path), table_bits) == 0) {
+        options.table_path = table_path;
+    }
+    if (crypto_configure(table_bits, options.table_path) != 0 || crypto_init() != 0) {
+        fprintf(stderr, "Failed to initialize cryptographic system\n");
         return 1;
     }
     
@@ -35,7 +44,109 @@ int main(int argc, char *argv[]) {
         return 1;
     }
     
-    if (options.count == 1) {
+    if (options.serve_path) {
+        int result = server_run(&options, &running);
+        crypto_cleanup();
+        return result == 0 ? 0 : 1;
+    }
+    
+    if (options.index_path && !options.lookup) {
+        int result = index_keystore(&options);
+        crypto_cleanup();
+        return result == 0 ? 0 : 1;
+    }
+    
+    int generating = !options.dump_path && !options.lookup && !options.validate_path && !options.input_path &&
+                     !options.sign_path && !options.verify_path && !options.mnemonic && !options.derive_path;
+    options.running = &running;
+    if ((options.stats || options.progress) &&
+        stats_start(options.progress, generating ? (uint64_t)options.count : 0) != 0) {
+        fprintf(stderr, "Failed to start progress reporting\n");
+        crypto_cleanup();
+        return 1;
+    }
+    
+    if (keygen_output_open(&options) != 0) {
+        fprintf(stderr, "Failed to open output: %s\n", options.output_path ? options.output_path : "stdout");
+        crypto_cleanup();
+        return 1;
+    }
+    
+    if (options.dump_path) {
+        if (dump_keystore(&options) != 0) {
+            if (!options.quiet) {
+                fprintf(stderr, "Failed to read key store\n");
+            }
+            keygen_output_close();
+            crypto_cleanup();
+            return 1;
+        }
+    } else if (options.lookup) {
+        if (lookup_addresses(&options) != 0) {
+            if (!options.quiet) {
+                fprintf(stderr, "Failed to look up addresses\n");
+            }
+            keygen_output_close();
+            crypto_cleanup();
+            return 1;
+        }
+    } else if (options.validate_path) {
+        int result = validate_addresses(&options);
+        if (result != 0) {
+            if (result < 0 && !options.quiet) {
+                fprintf(stderr, "Failed to validate addresses\n");
+            }
+            keygen_output_close();
+            crypto_cleanup();
+            return 1;
+        }
+    } else if (options.verify_path) {
+        int result = verify_signatures(&options);
+        if (result != 0) {
+            if (result < 0 && !options.quiet) {
+                fprintf(stderr, "Failed to verify signatures\n");
+            }
+            keygen_output_close();
+            crypto_cleanup();
+            return 1;
+        }
+    } else if (options.sign_path) {
+        if (sign_messages(&options) != 0) {
+            if (!options.quiet) {
+                fprintf(stderr, "Failed to sign messages\n");
+            }
+            keygen_output_close();
+            crypto_cleanup();
+            return 1;
+        }
+    } else if (options.input_path) {
+        if (import_keys(&options) != 0) {
+            if (!options.quiet) {
+                fprintf(stderr, "Failed to import keys\n");
+            }
+            keygen_output_close();
+            crypto_cleanup();
+            return 1;
+        }
+    } else if (options.mnemonic) {
+        if (generate_wallets(&options) != 0) {
+            if (!options.quiet) {
+                fprintf(stderr, "Failed to generate wallets\n");
+            }
+            keygen_output_close();
+            crypto_cleanup();
+            return 1;
+        }
+    } else if (options.derive_path) {
+        if (derive_keys(&options) != 0) {
+            if (!options.quiet) {
+                fprintf(stderr, "Failed to derive keys\n");
+            }
+            keygen_output_close();
+            crypto_cleanup();
+            return 1;
+        }
+    } else if (options.count == 1 && options.format != OUTPUT_FORMAT_BINARY) {
         private_key_t private_key;
         public_key_t public_key;
         bitcoin_address_t address;
@@ -44,17 +155,19 @@ int main(int argc, char *argv[]) {
             if (!options.quiet) {
                 fprintf(stderr, "Failed to generate key pair\n");
             }
+            keygen_output_close();
             crypto_cleanup();
             return 1;
         }
         
         if (options.with_address) {
-            if (create_p2pkh_address(&public_key, &address) != 0) {
+            if (create_addresses(&public_key, &address, 1, options.address_type, options.testnet) != 0) {
                 if (!options.quiet) {
                     fprintf(stderr, "Failed to generate address\n");
                 }
                 secure_zero_memory(&private_key, sizeof(private_key));
                 secure_zero_memory(&public_key, sizeof(public_key));
+                keygen_output_close();
                 crypto_cleanup();
                 return 1;
             }
@@ -70,6 +183,7 @@ int main(int argc, char *argv[]) {
             if (options.with_address) {
                 secure_zero_memory(&address, sizeof(address));
             }
+            keygen_output_close();
             crypto_cleanup();
             return 1;
         }
@@ -84,11 +198,25 @@ int main(int argc, char *argv[]) {
             if (!options.quiet) {
                 fprintf(stderr, "Failed to generate multiple keys\n");
             }
+            keygen_output_close();
             crypto_cleanup();
             return 1;
         }
     }
     
+    if (keygen_output_close() != 0) {
+        if (!options.quiet) {
+            fprintf(stderr, "Failed to write output\n");
+        }
+        crypto_cleanup();
+        return 1;
+    }
+    
+    stats_stop();
+    if (options.stats) {
+        stats_report(stderr, !running);
+    }
+    
     crypto_cleanup();
-    return 0;
+    return running ? 0 : 130;
 }
\ No newline at end of file
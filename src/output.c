@@ -0,0 +1,412 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include "output.h"
+#include "crypto.h"
+#include "secmem.h"
+#include "stats.h"
+
+typedef struct {
+    char *data;
+    size_t length;
+    size_t done;
+    off_t offset;
+    int busy;
+} output_slot_t;
+
+struct output_uring_s {
+    int ring_fd;
+    void *sq_ring;
+    void *cq_ring;
+    size_t sq_ring_size;
+    size_t cq_ring_size;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+    output_slot_t slots[OUTPUT_URING_DEPTH];
+    size_t in_flight;
+};
+
+static void uring_destroy(output_uring_t *ring) {
+    if (!ring) return;
+    if (ring->sqes && ring->sqes != MAP_FAILED) munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring && ring->cq_ring != MAP_FAILED && ring->cq_ring != ring->sq_ring) munmap(ring->cq_ring, ring->cq_ring_size);
+    if (ring->sq_ring && ring->sq_ring != MAP_FAILED) munmap(ring->sq_ring, ring->sq_ring_size);
+    if (ring->ring_fd >= 0) close(ring->ring_fd);
+    for (int i = 0; i < OUTPUT_URING_DEPTH; i++) {
+        secmem_unmap(ring->slots[i].data, OUTPUT_BUFFER_SIZE);
+    }
+    free(ring);
+}
+
+static output_uring_t *uring_create(void) {
+    struct io_uring_params params;
+    output_uring_t *ring = calloc(1, sizeof(output_uring_t));
+    if (!ring) return NULL;
+
+    memset(&params, 0, sizeof(params));
+    ring->ring_fd = (int)syscall(__NR_io_uring_setup, OUTPUT_URING_DEPTH, &params);
+    if (ring->ring_fd < 0) {
+        free(ring);
+        return NULL;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_ring_size > ring->sq_ring_size) ring->sq_ring_size = ring->cq_ring_size;
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring->ring_fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        uring_destroy(ring);
+        return NULL;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring->ring_fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            uring_destroy(ring);
+            return NULL;
+        }
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->ring_fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        uring_destroy(ring);
+        return NULL;
+    }
+
+    ring->sq_head = (unsigned *)((char *)ring->sq_ring + params.sq_off.head);
+    ring->sq_tail = (unsigned *)((char *)ring->sq_ring + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)((char *)ring->sq_ring + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)((char *)ring->sq_ring + params.sq_off.array);
+    ring->cq_head = (unsigned *)((char *)ring->cq_ring + params.cq_off.head);
+    ring->cq_tail = (unsigned *)((char *)ring->cq_ring + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)((char *)ring->cq_ring + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)((char *)ring->cq_ring + params.cq_off.cqes);
+
+    for (int i = 0; i < OUTPUT_URING_DEPTH; i++) {
+        ring->slots[i].data = secmem_map(OUTPUT_BUFFER_SIZE);
+        if (!ring->slots[i].data) {
+            uring_destroy(ring);
+            return NULL;
+        }
+    }
+
+    return ring;
+}
+
+static int uring_submit(output_uring_t *ring, int fd, unsigned slot_index) {
+    output_slot_t *slot = &ring->slots[slot_index];
+    unsigned tail = *ring->sq_tail;
+    unsigned index = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)(slot->data + slot->done);
+    sqe->len = (uint32_t)(slot->length - slot->done);
+    sqe->off = (uint64_t)(slot->offset + (off_t)slot->done);
+    sqe->user_data = slot_index;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    for (;;) {
+        long submitted = syscall(__NR_io_uring_enter, ring->ring_fd, 1, 0, 0, NULL, 0);
+        if (submitted >= 0) break;
+        if (errno != EINTR) return -1;
+    }
+    return 0;
+}
+
+static void uring_release(output_uring_t *ring, output_slot_t *slot) {
+    secure_zero_memory(slot->data, slot->length);
+    slot->busy = 0;
+    ring->in_flight--;
+}
+
+static int uring_reap(output_uring_t *ring, int fd, int wait) {
+    int result = 0;
+
+    if (wait) {
+        for (;;) {
+            long entered = syscall(__NR_io_uring_enter, ring->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+            if (entered >= 0) break;
+            if (errno != EINTR) return -1;
+        }
+    }
+
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+        output_slot_t *slot = &ring->slots[cqe->user_data];
+        int res = cqe->res;
+        head++;
+
+        if (res <= 0) {
+            result = -1;
+        } else {
+            slot->done += (size_t)res;
+            if (slot->done < slot->length) {
+                if (uring_submit(ring, fd, (unsigned)cqe->user_data) == 0) continue;
+                result = -1;
+            }
+        }
+        uring_release(ring, slot);
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return result;
+}
+
+static int uring_drain(output_t *out) {
+    int result = 0;
+    while (out->uring->in_flight > 0) {
+        size_t in_flight = out->uring->in_flight;
+        if (uring_reap(out->uring, out->fd, 1) != 0) {
+            result = -1;
+            if (out->uring->in_flight == in_flight) break;
+        }
+    }
+    return result;
+}
+
+static int uring_acquire(output_uring_t *ring, int fd, int *result) {
+    for (;;) {
+        for (int i = 0; i < OUTPUT_URING_DEPTH; i++) {
+            if (!ring->slots[i].busy) return i;
+        }
+
+        size_t in_flight = ring->in_flight;
+        if (uring_reap(ring, fd, 1) != 0) {
+            *result = -1;
+            if (ring->in_flight == in_flight) return -1;
+        }
+    }
+}
+
+static int write_all(output_t *out, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t written = out->uring ? pwrite(out->fd, data, length, out->offset)
+                                     : write(out->fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        data += written;
+        length -= (size_t)written;
+        out->offset += written;
+    }
+    return 0;
+}
+
+static int writev_all(output_t *out, struct iovec *iov, int count) {
+    while (count > 0) {
+        ssize_t written = out->uring ? pwritev(out->fd, iov, count, out->offset)
+                                     : writev(out->fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        out->offset += written;
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+    return 0;
+}
+
+int output_open(output_t *out, const char *path, output_backend_t backend) {
+    if (!out) return -1;
+
+    memset(out, 0, sizeof(output_t));
+    out->fd = STDOUT_FILENO;
+    out->backend = OUTPUT_BACKEND_WRITE;
+
+    if (path) {
+        out->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (out->fd < 0) return -1;
+        out->owns_fd = 1;
+
+        if (backend == OUTPUT_BACKEND_IO_URING) {
+            out->uring = uring_create();
+            if (out->uring) {
+                out->backend = OUTPUT_BACKEND_IO_URING;
+            }
+        }
+    }
+
+    pthread_mutex_init(&out->lock, NULL);
+    return 0;
+}
+
+int output_close(output_t *out) {
+    if (!out) return -1;
+
+    int result = out->error ? -1 : 0;
+    if (out->uring) {
+        if (uring_drain(out) != 0) result = -1;
+        uring_destroy(out->uring);
+        out->uring = NULL;
+    }
+    if (out->owns_fd && close(out->fd) != 0) {
+        result = -1;
+    }
+    pthread_mutex_destroy(&out->lock);
+    out->fd = -1;
+    return result;
+}
+
+int output_buffer_init(output_buffer_t *buffer, size_t capacity) {
+    if (!buffer || capacity == 0) return -1;
+
+    buffer->data = secmem_map(capacity);
+    buffer->used = 0;
+    buffer->capacity = buffer->data ? capacity : 0;
+    return buffer->data ? 0 : -1;
+}
+
+void output_buffer_free(output_buffer_t *buffer) {
+    if (!buffer) return;
+
+    secmem_unmap(buffer->data, buffer->capacity);
+    buffer->data = NULL;
+    buffer->used = 0;
+    buffer->capacity = 0;
+}
+
+int output_flush(output_t *out, output_buffer_t *buffer) {
+    if (!out || !buffer) return -1;
+    if (buffer->used == 0) return 0;
+
+    int result = 0;
+    uint64_t started = stats_begin();
+    stats_count(STATS_COUNTER_BYTES, buffer->used);
+    pthread_mutex_lock(&out->lock);
+
+    if (out->uring && buffer->capacity == OUTPUT_BUFFER_SIZE) {
+        output_uring_t *ring = out->uring;
+        int slot_index = uring_acquire(ring, out->fd, &result);
+
+        if (slot_index < 0) {
+            secure_zero_memory(buffer->data, buffer->used);
+            buffer->used = 0;
+        } else {
+            output_slot_t *slot = &ring->slots[slot_index];
+            char *spare = slot->data;
+            slot->data = buffer->data;
+            slot->length = buffer->used;
+            slot->done = 0;
+            slot->offset = out->offset;
+            slot->busy = 1;
+            out->offset += (off_t)buffer->used;
+            buffer->data = spare;
+            buffer->used = 0;
+
+            ring->in_flight++;
+            if (uring_submit(ring, out->fd, (unsigned)slot_index) != 0) {
+                uring_release(ring, slot);
+                result = -1;
+            }
+            if (uring_reap(ring, out->fd, 0) != 0) {
+                result = -1;
+            }
+        }
+    } else {
+        if (out->uring && uring_drain(out) != 0) {
+            result = -1;
+        }
+        if (write_all(out, buffer->data, buffer->used) != 0) {
+            result = -1;
+        }
+        secure_zero_memory(buffer->data, buffer->used);
+        buffer->used = 0;
+    }
+
+    if (result != 0) {
+        out->error = 1;
+    }
+    pthread_mutex_unlock(&out->lock);
+    stats_end(STATS_STAGE_WRITE, started);
+    return result;
+}
+
+int output_write(output_t *out, const void *data, size_t length) {
+    if (!out || !data) return -1;
+
+    int result = 0;
+    uint64_t started = stats_begin();
+    stats_count(STATS_COUNTER_BYTES, length);
+    pthread_mutex_lock(&out->lock);
+    if (out->uring && uring_drain(out) != 0) {
+        result = -1;
+    }
+    if (write_all(out, (const char *)data, length) != 0) {
+        result = -1;
+    }
+    if (result != 0) {
+        out->error = 1;
+    }
+    pthread_mutex_unlock(&out->lock);
+    stats_end(STATS_STAGE_WRITE, started);
+    return result;
+}
+
+int output_writev(output_t *out, const struct iovec *iov, int count) {
+    if (!out || !iov || count < 0) return -1;
+
+    struct iovec local[OUTPUT_IOV_MAX];
+    int result = 0;
+    uint64_t started = stats_begin();
+
+    if (started) {
+        for (int i = 0; i < count; i++) {
+            stats_add(STATS_COUNTER_BYTES, iov[i].iov_len);
+        }
+    }
+    pthread_mutex_lock(&out->lock);
+    if (out->uring && uring_drain(out) != 0) {
+        result = -1;
+    }
+    while (count > 0) {
+        int batch = count < OUTPUT_IOV_MAX ? count : OUTPUT_IOV_MAX;
+        memcpy(local, iov, sizeof(struct iovec) * (size_t)batch);
+        if (writev_all(out, local, batch) != 0) {
+            result = -1;
+            break;
+        }
+        iov += batch;
+        count -= batch;
+    }
+    if (result != 0) {
+        out->error = 1;
+    }
+    pthread_mutex_unlock(&out->lock);
+    stats_end(STATS_STAGE_WRITE, started);
+    return result;
+}
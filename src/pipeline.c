@@ -0,0 +1,359 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "pipeline.h"
+#include "ring.h"
+#include "crypto.h"
+#include "address.h"
+#include "keystore.h"
+#include "pool.h"
+#include "secmem.h"
+#include "stats.h"
+#include "utils.h"
+
+typedef struct {
+    int first;
+    int count;
+    int generated;
+    int with_address;
+    int failed;
+    size_t length;
+    private_key_t private_keys[KEYGEN_BLOCK_SIZE];
+    public_key_t public_keys[KEYGEN_BLOCK_SIZE];
+    int key_numbers[KEYGEN_BLOCK_SIZE];
+    bitcoin_address_t addresses[KEYGEN_BLOCK_SIZE];
+    keystore_record_t records[KEYGEN_BLOCK_SIZE];
+    char address_strings[KEYGEN_BLOCK_SIZE][MAX_ADDRESS_STRING_SIZE];
+    char output[KEYGEN_BLOCK_SIZE * KEYGEN_RECORD_MAX];
+} pipeline_batch_t;
+
+typedef struct pipeline_s pipeline_t;
+
+typedef struct {
+    pipeline_t *pipeline;
+    int lane;
+    int cpu;
+    pthread_t thread;
+} pipeline_stage_t;
+
+struct pipeline_s {
+    const keygen_options_t *options;
+    output_t *out;
+    int count;
+    int lanes;
+    int cpus;
+    pipeline_batch_t *batches;
+    size_t batch_count;
+    ring_t free_batches;
+    ring_t *generated;
+    ring_t *derived;
+    ring_t hashed;
+    ring_t encoded;
+    int failed;
+};
+
+static void pin_stage(const pipeline_stage_t *stage) {
+    if (!stage->pipeline->options->pin_threads) return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(stage->cpu % stage->pipeline->cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static void *generate_stage(void *arg) {
+    pipeline_stage_t *stage = arg;
+    pipeline_t *pipeline = stage->pipeline;
+    const keygen_options_t *options = pipeline->options;
+    size_t blocks = ((size_t)pipeline->count + KEYGEN_BLOCK_SIZE - 1) / KEYGEN_BLOCK_SIZE;
+
+    pin_stage(stage);
+    for (size_t block = 0; block < blocks && !__atomic_load_n(&pipeline->failed, __ATOMIC_RELAXED); block++) {
+        if (options->running && !*options->running) break;
+        pipeline_batch_t *batch = ring_pop(&pipeline->free_batches);
+        int first = (int)block * KEYGEN_BLOCK_SIZE;
+
+        batch->first = first;
+        batch->count = pipeline->count - first < KEYGEN_BLOCK_SIZE ? pipeline->count - first : KEYGEN_BLOCK_SIZE;
+        batch->with_address = options->with_address;
+        batch->failed = 0;
+        batch->length = 0;
+        batch->generated = generate_private_keys(batch->private_keys, batch->key_numbers, first, batch->count, options);
+        if (batch->generated < 0) {
+            batch->generated = 0;
+            batch->failed = 1;
+        }
+        ring_push(&pipeline->generated[block % (size_t)pipeline->lanes], batch);
+    }
+
+    for (int lane = 0; lane < pipeline->lanes; lane++) {
+        ring_push(&pipeline->generated[lane], NULL);
+    }
+    return NULL;
+}
+
+static void *derive_stage(void *arg) {
+    pipeline_stage_t *stage = arg;
+    pipeline_t *pipeline = stage->pipeline;
+    const keygen_options_t *options = pipeline->options;
+    pipeline_batch_t *batch;
+
+    pin_stage(stage);
+    while ((batch = ring_pop(&pipeline->generated[stage->lane])) != NULL) {
+        uint64_t started = stats_begin();
+        if (!batch->failed && batch->generated > 0 &&
+            derive_public_keys_batch(batch->private_keys, batch->public_keys, (size_t)batch->generated,
+                                     options->compressed) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to derive public keys for key pairs %d-%d\n",
+                        batch->first + 1, batch->first + batch->count);
+            }
+            batch->failed = 1;
+        }
+        stats_end(STATS_STAGE_DERIVE, started);
+        ring_push(&pipeline->derived[stage->lane], batch);
+    }
+
+    ring_push(&pipeline->derived[stage->lane], NULL);
+    return NULL;
+}
+
+static void *hash_stage(void *arg) {
+    pipeline_stage_t *stage = arg;
+    pipeline_t *pipeline = stage->pipeline;
+    const keygen_options_t *options = pipeline->options;
+    pipeline_batch_t *batch;
+
+    pin_stage(stage);
+    for (size_t block = 0; (batch = ring_pop(&pipeline->derived[block % (size_t)pipeline->lanes])) != NULL; block++) {
+        size_t generated = (size_t)batch->generated;
+
+        if (batch->failed || generated == 0) {
+            ring_push(&pipeline->hashed, batch);
+            continue;
+        }
+        uint64_t started = stats_begin();
+        if (options->format == OUTPUT_FORMAT_BINARY) {
+            if (keystore_fill_records(batch->private_keys, batch->public_keys, generated, options->testnet,
+                                      batch->records) != 0) {
+                batch->failed = 1;
+            }
+        } else if (batch->with_address &&
+                   create_addresses(batch->public_keys, batch->addresses, generated, options->address_type,
+                                    options->testnet) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to generate addresses for key pairs %d-%d\n",
+                        batch->key_numbers[0], batch->key_numbers[generated - 1]);
+            }
+            batch->with_address = 0;
+        }
+        stats_end(STATS_STAGE_HASH, started);
+        ring_push(&pipeline->hashed, batch);
+    }
+
+    ring_push(&pipeline->hashed, NULL);
+    return NULL;
+}
+
+static void encode_batch(const keygen_options_t *options, pipeline_batch_t *batch) {
+    size_t generated = (size_t)batch->generated;
+    size_t capacity = sizeof(batch->output);
+
+    if (options->format == OUTPUT_FORMAT_BINARY) {
+        if (keystore_encode_block(batch->records, generated, (uint8_t *)batch->output, capacity, &batch->length) != 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to encode key pairs %d-%d\n",
+                        batch->key_numbers[0], batch->key_numbers[generated - 1]);
+            }
+            batch->length = 0;
+            batch->failed = 1;
+        }
+        return;
+    }
+
+    if (batch->with_address &&
+        encode_addresses(batch->addresses, generated, options->address_type, options->testnet,
+                         batch->address_strings[0], MAX_ADDRESS_STRING_SIZE) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to generate addresses for key pairs %d-%d\n",
+                    batch->key_numbers[0], batch->key_numbers[generated - 1]);
+        }
+        batch->with_address = 0;
+    }
+
+    for (size_t i = 0; i < generated; i++) {
+        int written = format_key_record(&batch->private_keys[i], &batch->public_keys[i],
+                                        batch->with_address ? batch->address_strings[i] : NULL, options,
+                                        batch->output + batch->length, capacity - batch->length);
+        if (written < 0) {
+            if (!options->quiet) {
+                fprintf(stderr, "Failed to print key information for key pair %d\n", batch->key_numbers[i]);
+            }
+            continue;
+        }
+        batch->length += (size_t)written;
+    }
+}
+
+static void *encode_stage(void *arg) {
+    pipeline_stage_t *stage = arg;
+    pipeline_t *pipeline = stage->pipeline;
+    pipeline_batch_t *batch;
+
+    pin_stage(stage);
+    while ((batch = ring_pop(&pipeline->hashed)) != NULL) {
+        if (!batch->failed && batch->generated > 0) {
+            uint64_t started = stats_begin();
+            encode_batch(pipeline->options, batch);
+            stats_end(STATS_STAGE_ENCODE, started);
+        }
+        ring_push(&pipeline->encoded, batch);
+    }
+
+    ring_push(&pipeline->encoded, NULL);
+    return NULL;
+}
+
+static void retire_batch(pipeline_batch_t *batch) {
+    secure_zero_memory(batch->output, batch->length);
+    secure_zero_memory(batch, offsetof(pipeline_batch_t, output));
+}
+
+static void write_stage(pipeline_stage_t *stage) {
+    pipeline_t *pipeline = stage->pipeline;
+    pipeline_batch_t *batch;
+
+    pin_stage(stage);
+    while ((batch = ring_pop(&pipeline->encoded)) != NULL) {
+        if (batch->failed ||
+            (batch->length > 0 && output_write(pipeline->out, batch->output, batch->length) != 0)) {
+            __atomic_store_n(&pipeline->failed, 1, __ATOMIC_RELAXED);
+        }
+
+        retire_batch(batch);
+        ring_push(&pipeline->free_batches, batch);
+    }
+}
+
+static size_t ring_capacity(size_t count) {
+    size_t capacity = 2;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static void pipeline_free(pipeline_t *pipeline) {
+    for (int lane = 0; lane < pipeline->lanes; lane++) {
+        if (pipeline->generated) ring_free(&pipeline->generated[lane]);
+        if (pipeline->derived) ring_free(&pipeline->derived[lane]);
+    }
+    free(pipeline->generated);
+    free(pipeline->derived);
+    ring_free(&pipeline->free_batches);
+    ring_free(&pipeline->hashed);
+    ring_free(&pipeline->encoded);
+    secmem_unmap(pipeline->batches, pipeline->batch_count * sizeof(pipeline_batch_t));
+}
+
+static int pipeline_init(pipeline_t *pipeline, int count, const keygen_options_t *options, output_t *out) {
+    memset(pipeline, 0, sizeof(*pipeline));
+    pipeline->options = options;
+    pipeline->out = out;
+    pipeline->count = count;
+    pipeline->cpus = pool_cpu_count();
+    pipeline->lanes = options->threads > 0 ? options->threads : pipeline->cpus;
+    if (pipeline->lanes > POOL_MAX_THREADS) {
+        pipeline->lanes = POOL_MAX_THREADS;
+    }
+    pipeline->batch_count = (size_t)(pipeline->lanes + PIPELINE_SHARED_STAGES) * PIPELINE_BATCHES_PER_LANE;
+
+    pipeline->batches = secmem_map(pipeline->batch_count * sizeof(pipeline_batch_t));
+    pipeline->generated = calloc((size_t)pipeline->lanes, sizeof(ring_t));
+    pipeline->derived = calloc((size_t)pipeline->lanes, sizeof(ring_t));
+    if (!pipeline->batches || !pipeline->generated || !pipeline->derived ||
+        ring_init(&pipeline->free_batches, ring_capacity(pipeline->batch_count)) != 0 ||
+        ring_init(&pipeline->hashed, PIPELINE_RING_SIZE) != 0 ||
+        ring_init(&pipeline->encoded, PIPELINE_RING_SIZE) != 0) {
+        pipeline_free(pipeline);
+        return -1;
+    }
+    for (int lane = 0; lane < pipeline->lanes; lane++) {
+        if (ring_init(&pipeline->generated[lane], PIPELINE_RING_SIZE) != 0 ||
+            ring_init(&pipeline->derived[lane], PIPELINE_RING_SIZE) != 0) {
+            pipeline_free(pipeline);
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < pipeline->batch_count; i++) {
+        ring_push(&pipeline->free_batches, &pipeline->batches[i]);
+    }
+    return 0;
+}
+
+int pipeline_run(int count, const keygen_options_t *options, output_t *out) {
+    if (count <= 0 || !options || !out) return -1;
+
+    pipeline_t pipeline;
+    if (pipeline_init(&pipeline, count, options, out) != 0) return -1;
+
+    int stage_count = pipeline.lanes + PIPELINE_SHARED_STAGES;
+    pipeline_stage_t *stages = calloc((size_t)stage_count, sizeof(pipeline_stage_t));
+    if (!stages) {
+        pipeline_free(&pipeline);
+        return -1;
+    }
+    for (int i = 0; i < stage_count; i++) {
+        stages[i].pipeline = &pipeline;
+        stages[i].lane = i - 1;
+        stages[i].cpu = i;
+    }
+
+    pipeline_stage_t *encoder = &stages[stage_count - 2];
+    pipeline_stage_t *hasher = &stages[stage_count - 3];
+    int encoding = pthread_create(&encoder->thread, NULL, encode_stage, encoder) == 0;
+    int hashing = encoding && pthread_create(&hasher->thread, NULL, hash_stage, hasher) == 0;
+    int lanes = 0;
+    int generating = 0;
+    int result = 0;
+
+    while (hashing && lanes < pipeline.lanes &&
+           pthread_create(&stages[1 + lanes].thread, NULL, derive_stage, &stages[1 + lanes]) == 0) {
+        lanes++;
+    }
+    if (lanes == pipeline.lanes) {
+        generating = pthread_create(&stages[0].thread, NULL, generate_stage, &stages[0]) == 0;
+    }
+
+    if (!generating) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to start pipeline threads\n");
+        }
+        result = -1;
+        for (int lane = 0; lane < pipeline.lanes; lane++) {
+            ring_push(lane < lanes ? &pipeline.generated[lane] : &pipeline.derived[lane], NULL);
+        }
+        if (!hashing) ring_push(&pipeline.hashed, NULL);
+        if (!encoding) ring_push(&pipeline.encoded, NULL);
+    }
+
+    write_stage(&stages[stage_count - 1]);
+
+    if (generating) pthread_join(stages[0].thread, NULL);
+    for (int lane = 0; lane < lanes; lane++) {
+        pthread_join(stages[1 + lane].thread, NULL);
+    }
+    if (hashing) pthread_join(hasher->thread, NULL);
+    if (encoding) pthread_join(encoder->thread, NULL);
+    if (__atomic_load_n(&pipeline.failed, __ATOMIC_RELAXED)) {
+        result = -1;
+    }
+
+    free(stages);
+    pipeline_free(&pipeline);
+    return result;
+}
@@ -0,0 +1,161 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "pool.h"
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t front;
+    size_t back;
+} pool_deque_t;
+
+typedef struct pool_s pool_t;
+
+typedef struct {
+    pool_t *pool;
+    int id;
+    pthread_t thread;
+} pool_worker_t;
+
+struct pool_s {
+    int threads;
+    size_t task_count;
+    pool_task_fn fn;
+    void *context;
+    pool_deque_t *deques;
+    pool_worker_t *workers;
+    pthread_mutex_t status_lock;
+    int failed;
+};
+
+static size_t deque_task(const pool_t *pool, int owner, size_t slot) {
+    return (size_t)owner + slot * (size_t)pool->threads;
+}
+
+static int deque_pop(pool_t *pool, int owner, size_t *task) {
+    pool_deque_t *deque = &pool->deques[owner];
+    int found = 0;
+
+    pthread_mutex_lock(&deque->lock);
+    if (deque->front < deque->back) {
+        *task = deque_task(pool, owner, deque->front++);
+        found = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static int deque_steal(pool_t *pool, int victim, size_t *task) {
+    pool_deque_t *deque = &pool->deques[victim];
+    int found = 0;
+
+    pthread_mutex_lock(&deque->lock);
+    if (deque->front < deque->back) {
+        *task = deque_task(pool, victim, --deque->back);
+        found = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static int next_task(pool_t *pool, int id, size_t *task) {
+    if (deque_pop(pool, id, task)) return 1;
+
+    for (int i = 1; i < pool->threads; i++) {
+        int victim = (id + i) % pool->threads;
+        if (deque_steal(pool, victim, task)) return 1;
+    }
+    return 0;
+}
+
+static void *worker_main(void *arg) {
+    pool_worker_t *worker = (pool_worker_t *)arg;
+    pool_t *pool = worker->pool;
+    size_t task;
+
+    while (next_task(pool, worker->id, &task)) {
+        if (pool->fn(task, worker->id, pool->context) != 0) {
+            pthread_mutex_lock(&pool->status_lock);
+            pool->failed = 1;
+            pthread_mutex_unlock(&pool->status_lock);
+        }
+    }
+    return NULL;
+}
+
+int pool_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1) return 1;
+    if (count > POOL_MAX_THREADS) return POOL_MAX_THREADS;
+    return (int)count;
+}
+
+int pool_run(int threads, size_t task_count, pool_task_fn fn, void *context) {
+    if (!fn) return -1;
+    if (threads <= 0) {
+        threads = pool_cpu_count();
+    }
+    if (threads > POOL_MAX_THREADS) {
+        threads = POOL_MAX_THREADS;
+    }
+    if ((size_t)threads > task_count) {
+        threads = task_count > 0 ? (int)task_count : 1;
+    }
+
+    if (threads == 1) {
+        int result = 0;
+        for (size_t task = 0; task < task_count; task++) {
+            if (fn(task, 0, context) != 0) {
+                result = -1;
+            }
+        }
+        return result;
+    }
+
+    pool_t pool;
+    memset(&pool, 0, sizeof(pool));
+    pool.threads = threads;
+    pool.task_count = task_count;
+    pool.fn = fn;
+    pool.context = context;
+    pool.deques = calloc((size_t)threads, sizeof(pool_deque_t));
+    pool.workers = calloc((size_t)threads, sizeof(pool_worker_t));
+    if (!pool.deques || !pool.workers) {
+        free(pool.deques);
+        free(pool.workers);
+        return -1;
+    }
+    pthread_mutex_init(&pool.status_lock, NULL);
+
+    for (int i = 0; i < threads; i++) {
+        pthread_mutex_init(&pool.deques[i].lock, NULL);
+        pool.deques[i].front = 0;
+        pool.deques[i].back = (task_count - (size_t)i + (size_t)threads - 1) / (size_t)threads;
+        pool.workers[i].pool = &pool;
+        pool.workers[i].id = i;
+    }
+
+    int started = 0;
+    for (int i = 1; i < threads; i++) {
+        if (pthread_create(&pool.workers[i].thread, NULL, worker_main, &pool.workers[i]) != 0) {
+            break;
+        }
+        started = i;
+    }
+
+    worker_main(&pool.workers[0]);
+
+    for (int i = 1; i <= started; i++) {
+        pthread_join(pool.workers[i].thread, NULL);
+    }
+
+    for (int i = 0; i < threads; i++) {
+        pthread_mutex_destroy(&pool.deques[i].lock);
+    }
+    pthread_mutex_destroy(&pool.status_lock);
+    free(pool.deques);
+    free(pool.workers);
+
+    return pool.failed ? -1 : 0;
+}
@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include "ring.h"
+#include "cpu.h"
+
+static void ring_wait(unsigned *spins) {
+    if (++*spins < RING_SPIN_LIMIT) {
+#ifdef CPU_X86
+        __builtin_ia32_pause();
+#else
+        __asm__ __volatile__("" : : : "memory");
+#endif
+    } else {
+        *spins = 0;
+        sched_yield();
+    }
+}
+
+int ring_init(ring_t *ring, size_t capacity) {
+    if (!ring || capacity < 2 || (capacity & (capacity - 1)) != 0) return -1;
+
+    memset(ring, 0, sizeof(*ring));
+    ring->slots = calloc(capacity, sizeof(void *));
+    if (!ring->slots) return -1;
+    ring->mask = capacity - 1;
+    return 0;
+}
+
+void ring_free(ring_t *ring) {
+    if (!ring) return;
+
+    free(ring->slots);
+    memset(ring, 0, sizeof(*ring));
+}
+
+int ring_try_push(ring_t *ring, void *item) {
+    size_t head = ring->head;
+
+    if (head - ring->cached_tail > ring->mask) {
+        ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head - ring->cached_tail > ring->mask) return 0;
+    }
+
+    ring->slots[head & ring->mask] = item;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+int ring_try_pop(ring_t *ring, void **item) {
+    size_t tail = ring->tail;
+
+    if (tail == ring->cached_head) {
+        ring->cached_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        if (tail == ring->cached_head) return 0;
+    }
+
+    *item = ring->slots[tail & ring->mask];
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+void ring_push(ring_t *ring, void *item) {
+    unsigned spins = 0;
+
+    while (!ring_try_push(ring, item)) {
+        ring_wait(&spins);
+    }
+}
+
+void *ring_pop(ring_t *ring) {
+    unsigned spins = 0;
+    void *item;
+
+    while (!ring_try_pop(ring, &item)) {
+        ring_wait(&spins);
+    }
+    return item;
+}
@@ -0,0 +1,423 @@
+#include <string.h>
+#include <pthread.h>
+#include "ripemd160.h"
+#include "sha256.h"
+#include "cpu.h"
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+typedef void (*ripemd160_lanes_fn)(uint32_t *state, const uint8_t *const *blocks);
+
+static const uint8_t ripemd160_rl[80] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+    3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+    1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+    4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+};
+
+static const uint8_t ripemd160_rr[80] = {
+    5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+    6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+    15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+    8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+    12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+};
+
+static const uint8_t ripemd160_sl[80] = {
+    11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+    7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+    11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+    11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+    9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+};
+
+static const uint8_t ripemd160_sr[80] = {
+    8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+    9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+    9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+    15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+    8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+};
+
+static const uint32_t ripemd160_kl[5] = { 0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e };
+static const uint32_t ripemd160_kr[5] = { 0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000 };
+static const uint32_t ripemd160_iv[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+static pthread_once_t ripemd160_once = PTHREAD_ONCE_INIT;
+static ripemd160_impl_t active_impl = RIPEMD160_IMPL_SCALAR;
+
+#define V_F1(x, y, z) V_XOR(V_XOR(x, y), z)
+#define V_F2(x, y, z) V_OR(V_AND(x, y), V_ANDNOT(x, z))
+#define V_F3(x, y, z) V_XOR(V_OR(x, V_NOT(y)), z)
+#define V_F4(x, y, z) V_OR(V_AND(x, z), V_ANDNOT(z, y))
+#define V_F5(x, y, z) V_XOR(x, V_OR(y, V_NOT(z)))
+#define V_NOT(x) V_XOR(x, V_SET1(0xffffffffU))
+
+#define RIPEMD160_ROUND(FL, FR, round) \
+    for (int j = (round) * 16; j < (round) * 16 + 16; j++) { \
+        V t = V_ADD(V_ROL(V_ADD(V_ADD(al, FL(bl, cl, dl)), V_ADD(x[ripemd160_rl[j]], V_SET1(ripemd160_kl[round]))), ripemd160_sl[j]), el); \
+        al = el; el = dl; dl = V_ROL(cl, 10); cl = bl; bl = t; \
+        t = V_ADD(V_ROL(V_ADD(V_ADD(ar, FR(br, cr, dr)), V_ADD(x[ripemd160_rr[j]], V_SET1(ripemd160_kr[round]))), ripemd160_sr[j]), er); \
+        ar = er; er = dr; dr = V_ROL(cr, 10); cr = br; br = t; \
+    }
+
+#define RIPEMD160_COMPRESS(lanes) \
+    do { \
+        V h0 = V_LOAD(state), h1 = V_LOAD(state + (lanes)), h2 = V_LOAD(state + 2 * (lanes)); \
+        V h3 = V_LOAD(state + 3 * (lanes)), h4 = V_LOAD(state + 4 * (lanes)); \
+        V al = h0, bl = h1, cl = h2, dl = h3, el = h4; \
+        V ar = h0, br = h1, cr = h2, dr = h3, er = h4; \
+        RIPEMD160_ROUND(V_F1, V_F5, 0) \
+        RIPEMD160_ROUND(V_F2, V_F4, 1) \
+        RIPEMD160_ROUND(V_F3, V_F3, 2) \
+        RIPEMD160_ROUND(V_F4, V_F2, 3) \
+        RIPEMD160_ROUND(V_F5, V_F1, 4) \
+        V t = V_ADD(V_ADD(h1, cl), dr); \
+        V_STORE(state + (lanes), V_ADD(V_ADD(h2, dl), er)); \
+        V_STORE(state + 2 * (lanes), V_ADD(V_ADD(h3, el), ar)); \
+        V_STORE(state + 3 * (lanes), V_ADD(V_ADD(h4, al), br)); \
+        V_STORE(state + 4 * (lanes), V_ADD(V_ADD(h0, bl), cr)); \
+        V_STORE(state, t); \
+    } while (0)
+
+static uint32_t load_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void store_le32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+#define V uint32_t
+#define V_ADD(a, b) ((a) + (b))
+#define V_XOR(a, b) ((a) ^ (b))
+#define V_AND(a, b) ((a) & (b))
+#define V_OR(a, b) ((a) | (b))
+#define V_ANDNOT(a, b) (~(a) & (b))
+#define V_ROL(a, n) (((a) << (n)) | ((a) >> (32 - (n))))
+#define V_SET1(k) ((uint32_t)(k))
+#define V_LOAD(p) (*(p))
+#define V_STORE(p, v) (*(p) = (v))
+
+static void lanes1_scalar(uint32_t *state, const uint8_t *const *blocks) {
+    uint32_t x[16];
+    for (int i = 0; i < 16; i++) {
+        x[i] = load_le32(blocks[0] + i * 4);
+    }
+    RIPEMD160_COMPRESS(1);
+}
+
+#undef V
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_OR
+#undef V_ANDNOT
+#undef V_ROL
+#undef V_SET1
+#undef V_LOAD
+#undef V_STORE
+
+#ifdef CPU_X86_64
+#define V __m128i
+#define V_ADD(a, b) _mm_add_epi32(a, b)
+#define V_XOR(a, b) _mm_xor_si128(a, b)
+#define V_AND(a, b) _mm_and_si128(a, b)
+#define V_OR(a, b) _mm_or_si128(a, b)
+#define V_ANDNOT(a, b) _mm_andnot_si128(a, b)
+#define V_ROL(a, n) _mm_or_si128(_mm_slli_epi32(a, n), _mm_srli_epi32(a, 32 - (n)))
+#define V_SET1(k) _mm_set1_epi32((int)(k))
+#define V_LOAD(p) _mm_loadu_si128((const __m128i *)(p))
+#define V_STORE(p, v) _mm_storeu_si128((__m128i *)(p), v)
+
+static void lanes4_sse2(uint32_t *state, const uint8_t *const *blocks) {
+    __m128i x[16];
+    for (int offset = 0; offset < 16; offset += 4) {
+        __m128i r0 = _mm_loadu_si128((const __m128i *)(blocks[0] + offset * 4));
+        __m128i r1 = _mm_loadu_si128((const __m128i *)(blocks[1] + offset * 4));
+        __m128i r2 = _mm_loadu_si128((const __m128i *)(blocks[2] + offset * 4));
+        __m128i r3 = _mm_loadu_si128((const __m128i *)(blocks[3] + offset * 4));
+        __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+        __m128i t1 = _mm_unpackhi_epi32(r0, r1);
+        __m128i t2 = _mm_unpacklo_epi32(r2, r3);
+        __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+        x[offset] = _mm_unpacklo_epi64(t0, t2);
+        x[offset + 1] = _mm_unpackhi_epi64(t0, t2);
+        x[offset + 2] = _mm_unpacklo_epi64(t1, t3);
+        x[offset + 3] = _mm_unpackhi_epi64(t1, t3);
+    }
+    RIPEMD160_COMPRESS(4);
+}
+
+#undef V
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_OR
+#undef V_ANDNOT
+#undef V_ROL
+#undef V_SET1
+#undef V_LOAD
+#undef V_STORE
+#endif
+
+#ifdef CPU_X86
+__attribute__((target("avx2")))
+static void load_columns8(__m256i *columns, const uint8_t *const *blocks, size_t offset) {
+    __m256i r[8], t[8], u[8];
+
+    for (int l = 0; l < 8; l++) {
+        r[l] = _mm256_loadu_si256((const __m256i *)(blocks[l] + offset));
+    }
+    for (int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; i++) {
+        columns[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        columns[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+}
+
+#define V __m256i
+#define V_ADD(a, b) _mm256_add_epi32(a, b)
+#define V_XOR(a, b) _mm256_xor_si256(a, b)
+#define V_AND(a, b) _mm256_and_si256(a, b)
+#define V_OR(a, b) _mm256_or_si256(a, b)
+#define V_ANDNOT(a, b) _mm256_andnot_si256(a, b)
+#define V_ROL(a, n) _mm256_or_si256(_mm256_slli_epi32(a, n), _mm256_srli_epi32(a, 32 - (n)))
+#define V_SET1(k) _mm256_set1_epi32((int)(k))
+#define V_LOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+#define V_STORE(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+
+__attribute__((target("avx2")))
+static void lanes8_avx2(uint32_t *state, const uint8_t *const *blocks) {
+    __m256i x[16];
+    load_columns8(x, blocks, 0);
+    load_columns8(x + 8, blocks, 32);
+    RIPEMD160_COMPRESS(8);
+}
+
+#undef V
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_OR
+#undef V_ANDNOT
+#undef V_ROL
+#undef V_SET1
+#undef V_LOAD
+#undef V_STORE
+
+#define V __m512i
+#define V_ADD(a, b) _mm512_add_epi32(a, b)
+#define V_XOR(a, b) _mm512_xor_si512(a, b)
+#define V_AND(a, b) _mm512_and_si512(a, b)
+#define V_OR(a, b) _mm512_or_si512(a, b)
+#define V_ANDNOT(a, b) _mm512_andnot_si512(a, b)
+#define V_ROL(a, n) _mm512_rolv_epi32(a, _mm512_set1_epi32(n))
+#define V_SET1(k) _mm512_set1_epi32((int)(k))
+#define V_LOAD(p) _mm512_loadu_si512((const void *)(p))
+#define V_STORE(p, v) _mm512_storeu_si512((void *)(p), v)
+
+__attribute__((target("avx512f,avx2")))
+static void lanes16_avx512(uint32_t *state, const uint8_t *const *blocks) {
+    __m512i x[16];
+    __m256i low[16], high[16];
+
+    load_columns8(low, blocks, 0);
+    load_columns8(low + 8, blocks, 32);
+    load_columns8(high, blocks + 8, 0);
+    load_columns8(high + 8, blocks + 8, 32);
+    for (int t = 0; t < 16; t++) {
+        x[t] = _mm512_inserti64x4(_mm512_castsi256_si512(low[t]), high[t], 1);
+    }
+    RIPEMD160_COMPRESS(16);
+}
+
+#undef V
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_OR
+#undef V_ANDNOT
+#undef V_ROL
+#undef V_SET1
+#undef V_LOAD
+#undef V_STORE
+#endif
+
+static void ripemd160_detect(void) {
+    if (ripemd160_supported(RIPEMD160_IMPL_AVX512)) {
+        active_impl = RIPEMD160_IMPL_AVX512;
+    } else if (ripemd160_supported(RIPEMD160_IMPL_AVX2)) {
+        active_impl = RIPEMD160_IMPL_AVX2;
+    } else if (ripemd160_supported(RIPEMD160_IMPL_SSE2)) {
+        active_impl = RIPEMD160_IMPL_SSE2;
+    } else {
+        active_impl = RIPEMD160_IMPL_SCALAR;
+    }
+}
+
+static void ripemd160_ensure(void) {
+    pthread_once(&ripemd160_once, ripemd160_detect);
+}
+
+int ripemd160_supported(ripemd160_impl_t impl) {
+    switch (impl) {
+        case RIPEMD160_IMPL_AUTO:
+        case RIPEMD160_IMPL_SCALAR:
+            return 1;
+        case RIPEMD160_IMPL_SSE2:
+#ifdef CPU_X86_64
+            return 1;
+#else
+            return 0;
+#endif
+        case RIPEMD160_IMPL_AVX2:
+            return cpu_has(CPU_FEATURE_AVX2);
+        case RIPEMD160_IMPL_AVX512:
+            return cpu_has(CPU_FEATURE_AVX512F) && cpu_has(CPU_FEATURE_AVX2);
+    }
+    return 0;
+}
+
+int ripemd160_select(ripemd160_impl_t impl) {
+    ripemd160_ensure();
+    if (impl == RIPEMD160_IMPL_AUTO) {
+        ripemd160_detect();
+        return 0;
+    }
+    if (!ripemd160_supported(impl)) return -1;
+
+    active_impl = impl;
+    return 0;
+}
+
+ripemd160_impl_t ripemd160_active(void) {
+    ripemd160_ensure();
+    return active_impl;
+}
+
+const char *ripemd160_impl_name(ripemd160_impl_t impl) {
+    switch (impl) {
+        case RIPEMD160_IMPL_AUTO:
+            return "auto";
+        case RIPEMD160_IMPL_SCALAR:
+            return "scalar";
+        case RIPEMD160_IMPL_SSE2:
+            return "sse2";
+        case RIPEMD160_IMPL_AVX2:
+            return "avx2";
+        case RIPEMD160_IMPL_AVX512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+static void ripemd160_lanes(const uint8_t *const *messages, size_t length, uint8_t *digests,
+                            size_t lanes, ripemd160_lanes_fn kernel) {
+    uint32_t state[5 * RIPEMD160_MAX_LANES];
+    uint8_t tail[RIPEMD160_MAX_LANES][2 * RIPEMD160_BLOCK_SIZE];
+    const uint8_t *blocks[RIPEMD160_MAX_LANES];
+    size_t full = length / RIPEMD160_BLOCK_SIZE;
+    size_t total = (length + 8) / RIPEMD160_BLOCK_SIZE + 1;
+    size_t remainder = length - full * RIPEMD160_BLOCK_SIZE;
+    uint64_t bits = (uint64_t)length * 8;
+
+    for (size_t l = 0; l < lanes; l++) {
+        uint8_t *pad = tail[l];
+        memset(pad, 0, sizeof(tail[l]));
+        memcpy(pad, messages[l] + full * RIPEMD160_BLOCK_SIZE, remainder);
+        pad[remainder] = 0x80;
+        for (int i = 0; i < 8; i++) {
+            pad[(total - full) * RIPEMD160_BLOCK_SIZE - 8 + i] = (uint8_t)(bits >> (8 * i));
+        }
+        for (int i = 0; i < 5; i++) {
+            state[i * lanes + l] = ripemd160_iv[i];
+        }
+    }
+
+    for (size_t b = 0; b < total; b++) {
+        for (size_t l = 0; l < lanes; l++) {
+            blocks[l] = b < full ? messages[l] + b * RIPEMD160_BLOCK_SIZE : tail[l] + (b - full) * RIPEMD160_BLOCK_SIZE;
+        }
+        kernel(state, blocks);
+    }
+
+    for (size_t l = 0; l < lanes; l++) {
+        for (int i = 0; i < 5; i++) {
+            store_le32(digests + l * RIPEMD160_DIGEST_SIZE + i * 4, state[i * lanes + l]);
+        }
+    }
+}
+
+void ripemd160(const uint8_t *data, size_t length, uint8_t *digest) {
+    ripemd160_lanes(&data, length, digest, 1, lanes1_scalar);
+}
+
+void ripemd160_batch(const uint8_t *const *messages, size_t length, size_t count, uint8_t *digests) {
+    static const struct {
+        ripemd160_impl_t impl;
+        size_t lanes;
+        ripemd160_lanes_fn kernel;
+    } kernels[] = {
+#ifdef CPU_X86
+        { RIPEMD160_IMPL_AVX512, 16, lanes16_avx512 },
+        { RIPEMD160_IMPL_AVX2, 8, lanes8_avx2 },
+#endif
+#ifdef CPU_X86_64
+        { RIPEMD160_IMPL_SSE2, 4, lanes4_sse2 },
+#endif
+        { RIPEMD160_IMPL_SCALAR, 1, lanes1_scalar }
+    };
+
+    ripemd160_ensure();
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (kernels[k].impl > active_impl) continue;
+        while (count >= kernels[k].lanes) {
+            ripemd160_lanes(messages, length, digests, kernels[k].lanes, kernels[k].kernel);
+            messages += kernels[k].lanes;
+            digests += kernels[k].lanes * RIPEMD160_DIGEST_SIZE;
+            count -= kernels[k].lanes;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        ripemd160(messages[i], length, digests + i * RIPEMD160_DIGEST_SIZE);
+    }
+}
+
+void hash160(const uint8_t *data, size_t length, uint8_t *digest) {
+    uint8_t inner[SHA256_DIGEST_SIZE];
+    sha256(data, length, inner);
+    ripemd160(inner, sizeof(inner), digest);
+    memset(inner, 0, sizeof(inner));
+}
+
+void hash160_batch(const uint8_t *const *messages, size_t length, size_t count, uint8_t *digests) {
+    const uint8_t *inners[RIPEMD160_MAX_LANES * 4];
+    uint8_t inner[RIPEMD160_MAX_LANES * 4 * SHA256_DIGEST_SIZE];
+    size_t chunk = RIPEMD160_MAX_LANES * 4;
+
+    for (size_t base = 0; base < count; base += chunk) {
+        size_t n = count - base < chunk ? count - base : chunk;
+        sha256_batch(messages + base, length, n, inner);
+        for (size_t i = 0; i < n; i++) {
+            inners[i] = inner + i * SHA256_DIGEST_SIZE;
+        }
+        ripemd160_batch(inners, SHA256_DIGEST_SIZE, n, digests + base * RIPEMD160_DIGEST_SIZE);
+    }
+    memset(inner, 0, sizeof(inner));
+}
@@ -0,0 +1,191 @@
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/random.h>
+#include "rng.h"
+#include "scalar.h"
+#include "stats.h"
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+#define QUARTERROUND(a, b, c, d) \
+    a += b; d ^= a; d = ROTL32(d, 16); \
+    c += d; b ^= c; b = ROTL32(b, 12); \
+    a += b; d ^= a; d = ROTL32(d, 8); \
+    c += d; b ^= c; b = ROTL32(b, 7)
+
+typedef struct {
+    uint8_t key[RNG_KEY_SIZE];
+    uint8_t buffer[RNG_BUFFER_SIZE];
+    size_t available;
+    uint64_t since_reseed;
+    unsigned long generation;
+    int seeded;
+} rng_state_t;
+
+static __thread rng_state_t rng_state;
+static pthread_once_t rng_once = PTHREAD_ONCE_INIT;
+static pthread_key_t rng_thread_key;
+static int rng_once_result = -1;
+static volatile unsigned long rng_fork_generation = 0;
+
+static uint32_t load_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void store_le32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void chacha20_blocks(uint8_t *output, const uint8_t *key, uint32_t counter, size_t blocks) {
+    uint32_t input[16];
+
+    input[0] = 0x61707865;
+    input[1] = 0x3320646e;
+    input[2] = 0x79622d32;
+    input[3] = 0x6b206574;
+    for (int i = 0; i < 8; i++) {
+        input[4 + i] = load_le32(key + i * 4);
+    }
+    input[13] = input[14] = input[15] = 0;
+
+    for (size_t block = 0; block < blocks; block++) {
+        uint32_t x[16];
+
+        input[12] = counter + (uint32_t)block;
+        memcpy(x, input, sizeof(x));
+        for (int round = 0; round < 10; round++) {
+            QUARTERROUND(x[0], x[4], x[8], x[12]);
+            QUARTERROUND(x[1], x[5], x[9], x[13]);
+            QUARTERROUND(x[2], x[6], x[10], x[14]);
+            QUARTERROUND(x[3], x[7], x[11], x[15]);
+            QUARTERROUND(x[0], x[5], x[10], x[15]);
+            QUARTERROUND(x[1], x[6], x[11], x[12]);
+            QUARTERROUND(x[2], x[7], x[8], x[13]);
+            QUARTERROUND(x[3], x[4], x[9], x[14]);
+        }
+        for (int i = 0; i < 16; i++) {
+            store_le32(output + block * 64 + i * 4, x[i] + input[i]);
+        }
+        memset(x, 0, sizeof(x));
+    }
+    memset(input, 0, sizeof(input));
+}
+
+static int os_random(uint8_t *output, size_t length) {
+    while (length > 0) {
+        ssize_t got = getrandom(output, length, 0);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        output += got;
+        length -= (size_t)got;
+    }
+    return 0;
+}
+
+static void rng_thread_exit(void *arg) {
+    rng_state_t *state = (rng_state_t *)arg;
+    memset(state, 0, sizeof(*state));
+    __asm__ __volatile__("" : : "r"(state) : "memory");
+}
+
+static void rng_fork_child(void) {
+    __atomic_add_fetch(&rng_fork_generation, 1, __ATOMIC_SEQ_CST);
+}
+
+static void rng_global_init(void) {
+    if (pthread_key_create(&rng_thread_key, rng_thread_exit) != 0) return;
+    if (pthread_atfork(NULL, NULL, rng_fork_child) != 0) return;
+    rng_once_result = 0;
+}
+
+static void rng_refill(rng_state_t *state) {
+    chacha20_blocks(state->buffer, state->key, 0, RNG_BUFFER_BLOCKS);
+    memcpy(state->key, state->buffer, RNG_KEY_SIZE);
+    memset(state->buffer, 0, RNG_KEY_SIZE);
+    state->available = RNG_BUFFER_SIZE - RNG_KEY_SIZE;
+}
+
+static int rng_seed_state(rng_state_t *state) {
+    uint8_t seed[RNG_KEY_SIZE];
+
+    if (os_random(seed, sizeof(seed)) != 0) return -1;
+    for (int i = 0; i < RNG_KEY_SIZE; i++) {
+        state->key[i] ^= seed[i];
+    }
+    memset(seed, 0, sizeof(seed));
+    __asm__ __volatile__("" : : "r"(seed) : "memory");
+
+    if (!state->seeded) {
+        pthread_setspecific(rng_thread_key, state);
+        state->seeded = 1;
+    }
+    state->generation = __atomic_load_n(&rng_fork_generation, __ATOMIC_SEQ_CST);
+    state->since_reseed = 0;
+    rng_refill(state);
+    return 0;
+}
+
+int rng_init(void) {
+    pthread_once(&rng_once, rng_global_init);
+    if (rng_once_result != 0) return -1;
+    return rng_seed_state(&rng_state);
+}
+
+void rng_cleanup(void) {
+    rng_thread_exit(&rng_state);
+}
+
+int rng_reseed(void) {
+    if (rng_once_result != 0) return -1;
+    return rng_seed_state(&rng_state);
+}
+
+int rng_bytes(uint8_t *output, size_t length) {
+    rng_state_t *state = &rng_state;
+
+    if (!output) return -1;
+    if (rng_once_result != 0) return -1;
+
+    if (!state->seeded ||
+        state->generation != __atomic_load_n(&rng_fork_generation, __ATOMIC_SEQ_CST) ||
+        state->since_reseed >= RNG_RESEED_INTERVAL) {
+        if (rng_seed_state(state) != 0) return -1;
+    }
+
+    while (length > 0) {
+        if (state->available == 0) {
+            rng_refill(state);
+        }
+        size_t take = length < state->available ? length : state->available;
+        uint8_t *source = state->buffer + RNG_BUFFER_SIZE - state->available;
+        memcpy(output, source, take);
+        memset(source, 0, take);
+        state->available -= take;
+        state->since_reseed += take;
+        output += take;
+        length -= take;
+    }
+
+    return 0;
+}
+
+int rng_scalars(uint8_t *scalars, size_t count) {
+    if (!scalars) return -1;
+
+    if (rng_bytes(scalars, count * SCALAR_SIZE) != 0) return -1;
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t *scalar = scalars + i * SCALAR_SIZE;
+        while (!scalar_is_valid_b32(scalar)) {
+            stats_count(STATS_COUNTER_REJECTED, 1);
+            if (rng_bytes(scalar, SCALAR_SIZE) != 0) return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,280 @@
+#include <string.h>
+#include "scalar.h"
+
+typedef unsigned __int128 uint128_t;
+
+static const uint64_t order_limbs[4] = {
+    0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL
+};
+
+static uint64_t load_be64(const uint8_t *p) {
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) |
+           ((uint64_t)p[3] << 32) | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+           ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+int scalar_is_valid_b32(const uint8_t *scalar) {
+    uint64_t borrow = 0;
+    uint64_t any = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint64_t limb = load_be64(scalar + (3 - i) * 8);
+        uint128_t diff = (uint128_t)limb - order_limbs[i] - borrow;
+        borrow = (uint64_t)(diff >> 64) & 1;
+        any |= limb;
+    }
+
+    return (int)(borrow & ((any | (0 - any)) >> 63));
+}
+
+static void store_be64(uint8_t *p, uint64_t v) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+int scalar_add_b32(uint8_t *result, const uint8_t *a, const uint8_t *b) {
+    uint64_t sum[4], reduced[4];
+    uint64_t carry = 0, borrow = 0, any = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint128_t t = (uint128_t)load_be64(a + (3 - i) * 8) + load_be64(b + (3 - i) * 8) + carry;
+        sum[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+    for (int i = 0; i < 4; i++) {
+        uint128_t diff = (uint128_t)sum[i] - order_limbs[i] - borrow;
+        reduced[i] = (uint64_t)diff;
+        borrow = (uint64_t)(diff >> 64) & 1;
+    }
+
+    uint64_t keep = 0 - (borrow & (carry ^ 1));
+    for (int i = 0; i < 4; i++) {
+        uint64_t limb = (sum[i] & keep) | (reduced[i] & ~keep);
+        store_be64(result + (3 - i) * 8, limb);
+        any |= limb;
+    }
+
+    return any ? 0 : -1;
+}
+
+static const uint64_t order_complement[3] = {
+    0x402DA1732FC9BEBFULL, 0x4551231950B75FC4ULL, 0x1ULL
+};
+
+static const uint64_t order_half[4] = {
+    0xDFE92F46681B20A0ULL, 0x5D576E7357A4501DULL, 0xFFFFFFFFFFFFFFFFULL, 0x7FFFFFFFFFFFFFFFULL
+};
+
+static const scalar_t glv_lambda = {{
+    0xDF02967C1B23BD72ULL, 0x122E22EA20816678ULL, 0xA5261C028812645AULL, 0x5363AD4CC05C30E0ULL
+}};
+
+static const scalar_t glv_minus_b1 = {{
+    0x6F547FA90ABFE4C3ULL, 0xE4437ED6010E8828ULL, 0x0ULL, 0x0ULL
+}};
+
+static const scalar_t glv_minus_b2 = {{
+    0xD765CDA83DB1562CULL, 0x8A280AC50774346DULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL
+}};
+
+static const scalar_t glv_g1 = {{
+    0xE893209A45DBB031ULL, 0x3DAA8A1471E8CA7FULL, 0xE86C90E49284EB15ULL, 0x3086D221A7D46BCDULL
+}};
+
+static const scalar_t glv_g2 = {{
+    0x1571B4AE8AC47F71ULL, 0x221208AC9DF506C6ULL, 0x6F547FA90ABFE4C4ULL, 0xE4437ED6010E8828ULL
+}};
+
+static uint64_t scalar_reduce_once(uint64_t *d, uint64_t carry) {
+    uint64_t reduced[4];
+    uint64_t borrow = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint128_t diff = (uint128_t)d[i] - order_limbs[i] - borrow;
+        reduced[i] = (uint64_t)diff;
+        borrow = (uint64_t)(diff >> 64) & 1;
+    }
+
+    uint64_t overflow = carry | (borrow ^ 1);
+    uint64_t keep = overflow - 1;
+    for (int i = 0; i < 4; i++) {
+        d[i] = (d[i] & keep) | (reduced[i] & ~keep);
+    }
+    return overflow;
+}
+
+int scalar_set_b32(scalar_t *r, const uint8_t *b32) {
+    for (int i = 0; i < 4; i++) {
+        r->d[i] = load_be64(b32 + (3 - i) * 8);
+    }
+    return (int)scalar_reduce_once(r->d, 0);
+}
+
+void scalar_get_b32(uint8_t *b32, const scalar_t *a) {
+    for (int i = 0; i < 4; i++) {
+        store_be64(b32 + (3 - i) * 8, a->d[i]);
+    }
+}
+
+int scalar_is_zero(const scalar_t *a) {
+    return (a->d[0] | a->d[1] | a->d[2] | a->d[3]) == 0;
+}
+
+int scalar_is_high(const scalar_t *a) {
+    uint64_t borrow = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint128_t diff = (uint128_t)order_half[i] - a->d[i] - borrow;
+        borrow = (uint64_t)(diff >> 64) & 1;
+    }
+    return (int)borrow;
+}
+
+void scalar_add(scalar_t *r, const scalar_t *a, const scalar_t *b) {
+    uint128_t t = 0;
+
+    for (int i = 0; i < 4; i++) {
+        t += (uint128_t)a->d[i] + b->d[i];
+        r->d[i] = (uint64_t)t;
+        t >>= 64;
+    }
+    scalar_reduce_once(r->d, (uint64_t)t);
+}
+
+void scalar_negate(scalar_t *r, const scalar_t *a) {
+    uint64_t nonzero = (uint64_t)0 - (uint64_t)!scalar_is_zero(a);
+    uint64_t borrow = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint128_t diff = (uint128_t)order_limbs[i] - a->d[i] - borrow;
+        r->d[i] = (uint64_t)diff & nonzero;
+        borrow = (uint64_t)(diff >> 64) & 1;
+    }
+}
+
+static void scalar_mul_512(uint64_t *l, const scalar_t *a, const scalar_t *b) {
+    for (int i = 0; i < 8; i++) {
+        l[i] = 0;
+    }
+    for (int i = 0; i < 4; i++) {
+        uint128_t carry = 0;
+        for (int j = 0; j < 4; j++) {
+            carry += (uint128_t)a->d[i] * b->d[j] + l[i + j];
+            l[i + j] = (uint64_t)carry;
+            carry >>= 64;
+        }
+        l[i + 4] = (uint64_t)carry;
+    }
+}
+
+static void scalar_fold(uint64_t *l, int high) {
+    uint64_t t[8] = {l[0], l[1], l[2], l[3], 0, 0, 0, 0};
+
+    for (int i = 0; i < high; i++) {
+        uint128_t carry = 0;
+        for (int j = 0; j < 3; j++) {
+            carry += (uint128_t)l[i + 4] * order_complement[j] + t[i + j];
+            t[i + j] = (uint64_t)carry;
+            carry >>= 64;
+        }
+        for (int k = i + 3; k < high + 4; k++) {
+            carry += t[k];
+            t[k] = (uint64_t)carry;
+            carry >>= 64;
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        l[i] = t[i];
+    }
+}
+
+static void scalar_reduce_512(scalar_t *r, uint64_t *l) {
+    scalar_fold(l, 4);
+    scalar_fold(l, 3);
+    scalar_fold(l, 1);
+    scalar_fold(l, 1);
+    for (int i = 0; i < 4; i++) {
+        r->d[i] = l[i];
+    }
+    scalar_reduce_once(r->d, l[4]);
+}
+
+void scalar_mul(scalar_t *r, const scalar_t *a, const scalar_t *b) {
+    uint64_t l[8];
+
+    scalar_mul_512(l, a, b);
+    scalar_reduce_512(r, l);
+}
+
+void scalar_inverse(scalar_t *r, const scalar_t *a) {
+    static const uint64_t exponent[4] = {
+        0xBFD25E8CD036413FULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL
+    };
+    scalar_t powers[16];
+    scalar_t t;
+
+    memset(&powers[0], 0, sizeof(powers[0]));
+    powers[0].d[0] = 1;
+    for (int i = 1; i < 16; i++) {
+        scalar_mul(&powers[i], &powers[i - 1], a);
+    }
+
+    t = powers[0];
+    for (int nibble = 63; nibble >= 0; nibble--) {
+        unsigned int digit = (unsigned int)(exponent[nibble / 16] >> ((nibble % 16) * 4)) & 15;
+        for (int i = 0; i < 4; i++) {
+            scalar_mul(&t, &t, &t);
+        }
+        scalar_mul(&t, &t, &powers[digit]);
+    }
+    *r = t;
+    memset(powers, 0, sizeof(powers));
+    memset(&t, 0, sizeof(t));
+}
+
+int scalar_inverse_batch(scalar_t *r, const scalar_t *a, size_t count) {
+    scalar_t inv;
+
+    if (count == 0) return 0;
+    r[0] = a[0];
+    for (size_t i = 1; i < count; i++) {
+        scalar_mul(&r[i], &r[i - 1], &a[i]);
+    }
+    if (scalar_is_zero(&r[count - 1])) return -1;
+
+    scalar_inverse(&inv, &r[count - 1]);
+    for (size_t i = count; i-- > 1;) {
+        scalar_mul(&r[i], &inv, &r[i - 1]);
+        scalar_mul(&inv, &inv, &a[i]);
+    }
+    r[0] = inv;
+    memset(&inv, 0, sizeof(inv));
+    return 0;
+}
+
+static void scalar_mul_shift_384(scalar_t *r, const scalar_t *a, const scalar_t *b) {
+    uint64_t l[8];
+    uint128_t t;
+
+    scalar_mul_512(l, a, b);
+    t = (uint128_t)l[6] + (l[5] >> 63);
+    r->d[0] = (uint64_t)t;
+    r->d[1] = l[7] + (uint64_t)(t >> 64);
+    r->d[2] = 0;
+    r->d[3] = 0;
+}
+
+void scalar_split_lambda(scalar_t *r1, scalar_t *r2, const scalar_t *k) {
+    scalar_t c1, c2;
+
+    scalar_mul_shift_384(&c1, k, &glv_g1);
+    scalar_mul_shift_384(&c2, k, &glv_g2);
+    scalar_mul(&c1, &c1, &glv_minus_b1);
+    scalar_mul(&c2, &c2, &glv_minus_b2);
+    scalar_add(r2, &c1, &c2);
+    scalar_mul(r1, r2, &glv_lambda);
+    scalar_negate(r1, r1);
+    scalar_add(r1, r1, k);
+}
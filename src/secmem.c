@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "secmem.h"
+#include "crypto.h"
+
+static int lock_quiet = 0;
+static int lock_warned = 0;
+
+void secmem_set_quiet(int quiet) {
+    lock_quiet = quiet;
+}
+
+static void lock_pages(void *data, size_t length) {
+    if (mlock(data, length) == 0) return;
+
+    int error = errno;
+    if (!lock_quiet && !__atomic_exchange_n(&lock_warned, 1, __ATOMIC_RELAXED)) {
+        fprintf(stderr, "Warning: could not lock key memory (%s); it may be swapped out, raise RLIMIT_MEMLOCK (ulimit -l)\n",
+                strerror(error));
+    }
+}
+
+static size_t page_size(void) {
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? (size_t)size : 4096;
+}
+
+static size_t mapped_size(size_t size) {
+    size_t page = page_size();
+    return (size + page - 1) & ~(page - 1);
+}
+
+void *secmem_map(size_t size) {
+    if (size == 0) return NULL;
+
+    size_t page = page_size();
+    size_t length = mapped_size(size);
+    uint8_t *mapping = mmap(NULL, length + 2 * page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) return NULL;
+
+    uint8_t *data = mapping + page;
+    if (mprotect(data, length, PROT_READ | PROT_WRITE) != 0) {
+        munmap(mapping, length + 2 * page);
+        return NULL;
+    }
+    madvise(data, length, MADV_DONTDUMP);
+#ifdef MADV_WIPEONFORK
+    madvise(data, length, MADV_WIPEONFORK);
+#endif
+    lock_pages(data, length);
+    return data;
+}
+
+void secmem_unmap(void *data, size_t size) {
+    if (!data || size == 0) return;
+
+    size_t page = page_size();
+    size_t length = mapped_size(size);
+
+    secure_zero_memory(data, length);
+    munlock(data, length);
+    munmap((uint8_t *)data - page, length + 2 * page);
+}
+
+int secmem_arena_init(secmem_arena_t *arena, size_t size) {
+    if (!arena || size == 0) return -1;
+
+    memset(arena, 0, sizeof(*arena));
+    arena->data = secmem_map(size);
+    if (!arena->data) return -1;
+    arena->size = mapped_size(size);
+    return 0;
+}
+
+void secmem_arena_free(secmem_arena_t *arena) {
+    if (!arena) return;
+
+    secmem_unmap(arena->data, arena->size);
+    memset(arena, 0, sizeof(*arena));
+}
+
+void *secmem_alloc(secmem_arena_t *arena, size_t size) {
+    if (!arena || !arena->data) return NULL;
+
+    size_t offset = (arena->used + SECMEM_ALIGNMENT - 1) & ~(size_t)(SECMEM_ALIGNMENT - 1);
+    if (offset > arena->size || size > arena->size - offset) return NULL;
+
+    arena->used = offset + size;
+    return arena->data + offset;
+}
+
+void secmem_reset(secmem_arena_t *arena) {
+    if (!arena || !arena->data) return;
+
+    secure_zero_memory(arena->data, arena->used);
+    arena->used = 0;
+}
@@ -0,0 +1,502 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "server.h"
+#include "bip32.h"
+#include "address.h"
+#include "utils.h"
+
+typedef struct {
+    bip32_node_t chain;
+    char key[BIP32_XKEY_STRING_SIZE];
+    char (*addresses)[MAX_ADDRESS_STRING_SIZE];
+    size_t head;
+    size_t count;
+    uint32_t next_index;
+    int exhausted;
+} server_wallet_t;
+
+typedef struct {
+    int fd;
+    uint8_t buffer[4 + SERVER_MAX_FRAME];
+    size_t used;
+} server_client_t;
+
+typedef struct {
+    const keygen_options_t *options;
+    uint32_t chain[BIP32_MAX_PATH_DEPTH];
+    size_t chain_depth;
+    size_t pool_size;
+    size_t refill_batch;
+    size_t cursor;
+    server_wallet_t *wallets[SERVER_MAX_WALLETS];
+    size_t wallet_count;
+    pthread_mutex_t lock;
+    pthread_cond_t refill;
+    pthread_cond_t filled;
+    int stopping;
+} server_t;
+
+static uint32_t read_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void write_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static int write_full(int fd, const uint8_t *data, size_t length) {
+    while (length > 0) {
+        ssize_t written = send(fd, data, length, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return -1;
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+static int read_full(int fd, uint8_t *data, size_t length) {
+    while (length > 0) {
+        ssize_t got = recv(fd, data, length, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return -1;
+        data += got;
+        length -= (size_t)got;
+    }
+    return 0;
+}
+
+static int send_frame(int fd, const uint8_t *body, size_t length) {
+    uint8_t frame[4 + SERVER_MAX_FRAME];
+
+    if (length > SERVER_MAX_FRAME) return -1;
+    write_be32(frame, (uint32_t)length);
+    memcpy(frame + 4, body, length);
+    return write_full(fd, frame, 4 + length);
+}
+
+static int receive_frame(int fd, uint8_t *body, size_t body_size, size_t *length) {
+    uint8_t header[4];
+
+    if (read_full(fd, header, sizeof(header)) != 0) return -1;
+    *length = read_be32(header);
+    if (*length == 0 || *length > body_size) return -1;
+    return read_full(fd, body, *length);
+}
+
+static int derive_addresses(const server_t *server, const bip32_node_t *chain, uint32_t start, size_t count,
+                            char (*output)[MAX_ADDRESS_STRING_SIZE]) {
+    bip32_node_t children[KEYGEN_BLOCK_SIZE];
+    public_key_t public_keys[KEYGEN_BLOCK_SIZE];
+    bitcoin_address_t addresses[KEYGEN_BLOCK_SIZE];
+    int result = -1;
+
+    if (count > KEYGEN_BLOCK_SIZE) return -1;
+
+    if (bip32_derive_children(chain, start, count, children) == 0) {
+        for (size_t i = 0; i < count; i++) {
+            memcpy(public_keys[i].data, children[i].public_key, COMPRESSED_PUBLIC_KEY_SIZE);
+            public_keys[i].length = COMPRESSED_PUBLIC_KEY_SIZE;
+        }
+        if (create_addresses(public_keys, addresses, count, server->options->address_type, chain->testnet) == 0 &&
+            encode_addresses(addresses, count, server->options->address_type, chain->testnet,
+                             output[0], MAX_ADDRESS_STRING_SIZE) == 0) {
+            result = 0;
+        }
+    }
+
+    secure_zero_memory(children, sizeof(bip32_node_t) * count);
+    return result;
+}
+
+static server_wallet_t *wallet_needing_refill(server_t *server) {
+    for (size_t i = 0; i < server->wallet_count; i++) {
+        size_t slot = (server->cursor + i) % server->wallet_count;
+        server_wallet_t *wallet = server->wallets[slot];
+        if (!wallet->exhausted && server->pool_size - wallet->count >= server->refill_batch) {
+            server->cursor = slot + 1;
+            return wallet;
+        }
+    }
+    return NULL;
+}
+
+static void *refill_main(void *arg) {
+    server_t *server = arg;
+    char (*batch)[MAX_ADDRESS_STRING_SIZE] = malloc(sizeof(*batch) * KEYGEN_BLOCK_SIZE);
+
+    pthread_mutex_lock(&server->lock);
+    while (!server->stopping) {
+        server_wallet_t *wallet = wallet_needing_refill(server);
+        if (!wallet) {
+            pthread_cond_wait(&server->refill, &server->lock);
+            continue;
+        }
+
+        uint64_t start = (uint64_t)wallet->next_index + wallet->count;
+        size_t count = server->pool_size - wallet->count;
+        if (count > KEYGEN_BLOCK_SIZE) count = KEYGEN_BLOCK_SIZE;
+        if (start + count > BIP32_HARDENED) count = (size_t)(BIP32_HARDENED - start);
+        if (count == 0 || !batch) {
+            wallet->exhausted = 1;
+            pthread_cond_broadcast(&server->filled);
+            continue;
+        }
+
+        pthread_mutex_unlock(&server->lock);
+        int result = derive_addresses(server, &wallet->chain, (uint32_t)start, count, batch);
+        pthread_mutex_lock(&server->lock);
+
+        if (result != 0) {
+            wallet->exhausted = 1;
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                size_t slot = (wallet->head + wallet->count) % server->pool_size;
+                memcpy(wallet->addresses[slot], batch[i], MAX_ADDRESS_STRING_SIZE);
+                wallet->count++;
+            }
+        }
+        pthread_cond_broadcast(&server->filled);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    free(batch);
+    return NULL;
+}
+
+static uint8_t register_wallet(server_t *server, const char *xkey, uint32_t start, uint32_t *id) {
+    bip32_node_t root, chain;
+    char key[BIP32_XKEY_STRING_SIZE];
+    uint8_t status = SERVER_STATUS_ERROR;
+
+    if (start >= BIP32_HARDENED || bip32_parse(xkey, &root) != 0) return SERVER_STATUS_ERROR;
+    root.testnet = root.testnet || server->options->testnet;
+
+    if (bip32_neuter(&root, &root) == 0 &&
+        bip32_serialize(&root, 0, key, sizeof(key)) == 0 &&
+        bip32_derive_path(&root, server->chain, server->chain_depth, &chain) == 0) {
+        pthread_mutex_lock(&server->lock);
+        status = SERVER_STATUS_OK;
+        for (size_t i = 0; i < server->wallet_count; i++) {
+            if (strcmp(server->wallets[i]->key, key) == 0) {
+                *id = (uint32_t)i;
+                status = server->wallets[i]->next_index == start ? SERVER_STATUS_OK : SERVER_STATUS_ERROR;
+                pthread_mutex_unlock(&server->lock);
+                bip32_node_wipe(&root);
+                bip32_node_wipe(&chain);
+                return status;
+            }
+        }
+
+        server_wallet_t *wallet = NULL;
+        if (server->wallet_count == SERVER_MAX_WALLETS) {
+            status = SERVER_STATUS_FULL;
+        } else if ((wallet = calloc(1, sizeof(server_wallet_t))) == NULL ||
+                   (wallet->addresses = calloc(server->pool_size, MAX_ADDRESS_STRING_SIZE)) == NULL) {
+            free(wallet);
+            status = SERVER_STATUS_ERROR;
+        } else {
+            wallet->chain = chain;
+            memcpy(wallet->key, key, sizeof(key));
+            wallet->next_index = start;
+            *id = (uint32_t)server->wallet_count;
+            server->wallets[server->wallet_count++] = wallet;
+            pthread_cond_signal(&server->refill);
+        }
+        pthread_mutex_unlock(&server->lock);
+    }
+
+    bip32_node_wipe(&root);
+    bip32_node_wipe(&chain);
+    return status;
+}
+
+static uint8_t next_address(server_t *server, uint32_t id, uint32_t *index, char *address) {
+    uint8_t status = SERVER_STATUS_OK;
+
+    pthread_mutex_lock(&server->lock);
+    if (id >= server->wallet_count) {
+        status = SERVER_STATUS_UNKNOWN_WALLET;
+    } else {
+        server_wallet_t *wallet = server->wallets[id];
+        while (wallet->count == 0 && !wallet->exhausted) {
+            pthread_cond_signal(&server->refill);
+            pthread_cond_wait(&server->filled, &server->lock);
+        }
+        if (wallet->count == 0) {
+            status = SERVER_STATUS_EXHAUSTED;
+        } else {
+            *index = wallet->next_index;
+            memcpy(address, wallet->addresses[wallet->head], MAX_ADDRESS_STRING_SIZE);
+            wallet->head = (wallet->head + 1) % server->pool_size;
+            wallet->count--;
+            wallet->next_index++;
+            pthread_cond_signal(&server->refill);
+        }
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    return status;
+}
+
+static int handle_request(server_t *server, int fd, const uint8_t *body, size_t length) {
+    uint8_t response[SERVER_MAX_FRAME];
+    size_t response_length = 1;
+
+    response[0] = SERVER_STATUS_ERROR;
+    if (body[0] == SERVER_OP_REGISTER && length > 5 && length - 5 < BIP32_XKEY_STRING_SIZE) {
+        char xkey[BIP32_XKEY_STRING_SIZE];
+        uint32_t id = 0;
+
+        memcpy(xkey, body + 5, length - 5);
+        xkey[length - 5] = '\0';
+        response[0] = register_wallet(server, xkey, read_be32(body + 1), &id);
+        if (response[0] == SERVER_STATUS_OK) {
+            write_be32(response + 1, id);
+            response_length = 5;
+        }
+    } else if (body[0] == SERVER_OP_NEXT && length == 5) {
+        char address[MAX_ADDRESS_STRING_SIZE];
+        uint32_t index = 0;
+
+        response[0] = next_address(server, read_be32(body + 1), &index, address);
+        if (response[0] == SERVER_STATUS_OK) {
+            size_t address_length = strlen(address);
+            write_be32(response + 1, index);
+            memcpy(response + 5, address, address_length);
+            response_length = 5 + address_length;
+        }
+    }
+
+    return send_frame(fd, response, response_length);
+}
+
+static int service_client(server_t *server, server_client_t *client) {
+    ssize_t got = recv(client->fd, client->buffer + client->used, sizeof(client->buffer) - client->used, 0);
+    if (got < 0 && (errno == EINTR || errno == EAGAIN)) return 0;
+    if (got <= 0) return -1;
+    client->used += (size_t)got;
+
+    while (client->used >= 4) {
+        uint32_t length = read_be32(client->buffer);
+        if (length == 0 || length > SERVER_MAX_FRAME) return -1;
+        if (client->used < 4 + length) break;
+
+        if (handle_request(server, client->fd, client->buffer + 4, length) != 0) return -1;
+        client->used -= 4 + length;
+        memmove(client->buffer, client->buffer + 4 + length, client->used);
+    }
+
+    return 0;
+}
+
+static int open_listener(const char *path) {
+    struct sockaddr_un addr;
+    struct stat st;
+
+    if (strlen(path) + 4 >= sizeof(addr.sun_path)) return -1;
+    if (lstat(path, &st) == 0 && !S_ISSOCK(st.st_mode)) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) return -1;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s.new", path);
+    if (lstat(addr.sun_path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(addr.sun_path);
+    }
+
+    mode_t mask = umask(0077);
+    int result = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    umask(mask);
+    if (result != 0 || listen(fd, SERVER_MAX_CLIENTS) != 0 || rename(addr.sun_path, path) != 0) {
+        if (result == 0) {
+            unlink(addr.sun_path);
+        }
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int server_run(const keygen_options_t *options, const volatile int *running) {
+    if (!options || !options->serve_path || !running) return -1;
+
+    server_t server;
+    server_client_t clients[SERVER_MAX_CLIENTS];
+    struct pollfd fds[SERVER_MAX_CLIENTS + 1];
+    size_t client_count = 0;
+    pthread_t refill_thread;
+    int result = 0;
+
+    memset(&server, 0, sizeof(server));
+    server.options = options;
+    server.pool_size = options->pool_size > 0 ? (size_t)options->pool_size : SERVER_DEFAULT_POOL_SIZE;
+    server.refill_batch = server.pool_size / 2 < KEYGEN_BLOCK_SIZE ? server.pool_size / 2 : KEYGEN_BLOCK_SIZE;
+    if (server.refill_batch == 0) server.refill_batch = 1;
+    if (bip32_parse_path(options->derive_path ? options->derive_path : SERVER_DEFAULT_CHAIN,
+                         server.chain, BIP32_MAX_PATH_DEPTH, &server.chain_depth) != 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Invalid derivation path: %s\n", options->derive_path);
+        }
+        return -1;
+    }
+
+    int listener = open_listener(options->serve_path);
+    if (listener < 0) {
+        if (!options->quiet) {
+            fprintf(stderr, "Failed to listen on %s\n", options->serve_path);
+        }
+        return -1;
+    }
+
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_cond_init(&server.refill, NULL);
+    pthread_cond_init(&server.filled, NULL);
+    if (pthread_create(&refill_thread, NULL, refill_main, &server) != 0) {
+        close(listener);
+        unlink(options->serve_path);
+        pthread_mutex_destroy(&server.lock);
+        pthread_cond_destroy(&server.refill);
+        pthread_cond_destroy(&server.filled);
+        return -1;
+    }
+
+    while (*running) {
+        fds[0].fd = listener;
+        fds[0].events = POLLIN;
+        for (size_t i = 0; i < client_count; i++) {
+            fds[i + 1].fd = clients[i].fd;
+            fds[i + 1].events = POLLIN;
+        }
+
+        int ready = poll(fds, client_count + 1, SERVER_POLL_TIMEOUT_MS);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            result = -1;
+            break;
+        }
+        if (ready == 0) continue;
+
+        for (size_t i = client_count; i > 0; i--) {
+            if (!fds[i].revents) continue;
+            if (service_client(&server, &clients[i - 1]) != 0) {
+                close(clients[i - 1].fd);
+                clients[i - 1] = clients[--client_count];
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd;
+            while ((fd = accept(listener, NULL, NULL)) >= 0) {
+                if (client_count == SERVER_MAX_CLIENTS ||
+                    fcntl(fd, F_SETFD, FD_CLOEXEC) != 0 || fcntl(fd, F_SETFL, O_NONBLOCK) != 0) {
+                    close(fd);
+                    continue;
+                }
+                clients[client_count].fd = fd;
+                clients[client_count].used = 0;
+                client_count++;
+            }
+        }
+    }
+
+    pthread_mutex_lock(&server.lock);
+    server.stopping = 1;
+    pthread_cond_broadcast(&server.refill);
+    pthread_mutex_unlock(&server.lock);
+    pthread_join(refill_thread, NULL);
+
+    for (size_t i = 0; i < client_count; i++) {
+        close(clients[i].fd);
+    }
+    close(listener);
+    unlink(options->serve_path);
+
+    for (size_t i = 0; i < server.wallet_count; i++) {
+        bip32_node_wipe(&server.wallets[i]->chain);
+        free(server.wallets[i]->addresses);
+        free(server.wallets[i]);
+    }
+    pthread_mutex_destroy(&server.lock);
+    pthread_cond_destroy(&server.refill);
+    pthread_cond_destroy(&server.filled);
+
+    return result;
+}
+
+int server_connect(const char *path) {
+    struct sockaddr_un addr;
+
+    if (!path || strlen(path) >= sizeof(addr.sun_path)) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int server_register(int fd, const char *xkey, uint32_t start, uint32_t *wallet) {
+    if (!xkey || !wallet) return -1;
+
+    uint8_t body[SERVER_MAX_FRAME];
+    size_t key_length = strlen(xkey);
+    size_t length;
+
+    if (key_length == 0 || key_length >= BIP32_XKEY_STRING_SIZE) return -1;
+    body[0] = SERVER_OP_REGISTER;
+    write_be32(body + 1, start);
+    memcpy(body + 5, xkey, key_length);
+
+    if (send_frame(fd, body, 5 + key_length) != 0 ||
+        receive_frame(fd, body, sizeof(body), &length) != 0) {
+        return -1;
+    }
+    if (body[0] != SERVER_STATUS_OK || length != 5) return -1;
+
+    *wallet = read_be32(body + 1);
+    return 0;
+}
+
+int server_next_address(int fd, uint32_t wallet, uint32_t *index, char *address, size_t address_size) {
+    if (!index || !address) return -1;
+
+    uint8_t body[SERVER_MAX_FRAME];
+    size_t length;
+
+    body[0] = SERVER_OP_NEXT;
+    write_be32(body + 1, wallet);
+
+    if (send_frame(fd, body, 5) != 0 ||
+        receive_frame(fd, body, sizeof(body), &length) != 0) {
+        return -1;
+    }
+    if (body[0] != SERVER_STATUS_OK || length <= 5 || length - 5 >= address_size) return -1;
+
+    *index = read_be32(body + 1);
+    memcpy(address, body + 5, length - 5);
+    address[length - 5] = '\0';
+    return 0;
+}
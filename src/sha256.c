@@ -0,0 +1,516 @@
+#include <string.h>
+#include <pthread.h>
+#include "sha256.h"
+#include "cpu.h"
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+typedef void (*sha256_transform_fn)(uint32_t *state, const uint8_t *blocks, size_t count);
+typedef void (*sha256_lanes_fn)(uint32_t *state, const uint8_t *const *blocks);
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static pthread_once_t sha256_once = PTHREAD_ONCE_INIT;
+static sha256_impl_t active_impl = SHA256_IMPL_SCALAR;
+static sha256_transform_fn single_transform = NULL;
+
+static uint32_t load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void transform_scalar(uint32_t *state, const uint8_t *blocks, size_t count) {
+    while (count--) {
+        uint32_t w[64];
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int t = 0; t < 16; t++) {
+            w[t] = load_be32(blocks + t * 4);
+        }
+        for (int t = 16; t < 64; t++) {
+            uint32_t s0 = ROTR32(w[t - 15], 7) ^ ROTR32(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = ROTR32(w[t - 2], 17) ^ ROTR32(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+        for (int t = 0; t < 64; t++) {
+            uint32_t t1 = h + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) + ((e & f) ^ (~e & g)) + sha256_k[t] + w[t];
+            uint32_t t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        blocks += SHA256_BLOCK_SIZE;
+    }
+}
+
+#ifdef CPU_X86
+__attribute__((target("sha,sse4.1,ssse3")))
+static void transform_shani(uint32_t *state, const uint8_t *blocks, size_t count) {
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, msg, tmp, abef_save, cdgh_save;
+    __m128i m[4];
+
+    tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+    state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (count--) {
+        abef_save = state0;
+        cdgh_save = state1;
+
+#pragma GCC unroll 16
+        for (int g = 0; g < 16; g++) {
+            if (g < 4) {
+                m[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + g * 16)), mask);
+            }
+            msg = _mm_add_epi32(m[g & 3], _mm_loadu_si128((const __m128i *)&sha256_k[g * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (g >= 3 && g <= 14) {
+                tmp = _mm_alignr_epi8(m[g & 3], m[(g + 3) & 3], 4);
+                m[(g + 1) & 3] = _mm_add_epi32(m[(g + 1) & 3], tmp);
+                m[(g + 1) & 3] = _mm_sha256msg2_epu32(m[(g + 1) & 3], m[g & 3]);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (g >= 1 && g <= 12) {
+                m[(g + 3) & 3] = _mm_sha256msg1_epu32(m[(g + 3) & 3], m[g & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        blocks += SHA256_BLOCK_SIZE;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+__attribute__((target("avx2")))
+static void load_columns8(__m256i *columns, const uint8_t *const *blocks, size_t offset) {
+    const __m256i swap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                         12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i r[8], t[8], u[8];
+
+    for (int l = 0; l < 8; l++) {
+        r[l] = _mm256_loadu_si256((const __m256i *)(blocks[l] + offset));
+    }
+    for (int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; i++) {
+        columns[i] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u[i], u[i + 4], 0x20), swap);
+        columns[i + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u[i], u[i + 4], 0x31), swap);
+    }
+}
+
+#define AVX2_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+__attribute__((target("avx2")))
+static void lanes8_avx2(uint32_t *state, const uint8_t *const *blocks) {
+    __m256i w[16], s[8], v[8];
+
+    load_columns8(w, blocks, 0);
+    load_columns8(w + 8, blocks, 32);
+    for (int i = 0; i < 8; i++) {
+        s[i] = _mm256_loadu_si256((const __m256i *)(state + i * 8));
+        v[i] = s[i];
+    }
+
+    for (int t = 0; t < 64; t++) {
+        __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+        __m256i wt;
+
+        if (t < 16) {
+            wt = w[t];
+        } else {
+            __m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROTR(w15, 7), AVX2_ROTR(w15, 18)), _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROTR(w2, 17), AVX2_ROTR(w2, 19)), _mm256_srli_epi32(w2, 10));
+            wt = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+            w[t & 15] = wt;
+        }
+
+        __m256i big_s1 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROTR(e, 6), AVX2_ROTR(e, 11)), AVX2_ROTR(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, big_s1), _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32((int)sha256_k[t]), wt)));
+        __m256i big_s0 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROTR(a, 2), AVX2_ROTR(a, 13)), AVX2_ROTR(a, 22));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(a, b), c), _mm256_and_si256(a, b));
+        __m256i t2 = _mm256_add_epi32(big_s0, maj);
+
+        v[7] = g; v[6] = f; v[5] = e; v[4] = _mm256_add_epi32(d, t1);
+        v[3] = c; v[2] = b; v[1] = a; v[0] = _mm256_add_epi32(t1, t2);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i *)(state + i * 8), _mm256_add_epi32(s[i], v[i]));
+    }
+}
+
+__attribute__((target("avx512f,avx2")))
+static void lanes16_avx512(uint32_t *state, const uint8_t *const *blocks) {
+    __m512i w[16], s[8], v[8];
+    __m256i low[16], high[16];
+
+    load_columns8(low, blocks, 0);
+    load_columns8(low + 8, blocks, 32);
+    load_columns8(high, blocks + 8, 0);
+    load_columns8(high + 8, blocks + 8, 32);
+    for (int t = 0; t < 16; t++) {
+        w[t] = _mm512_inserti64x4(_mm512_castsi256_si512(low[t]), high[t], 1);
+    }
+    for (int i = 0; i < 8; i++) {
+        s[i] = _mm512_loadu_si512((const void *)(state + i * 16));
+        v[i] = s[i];
+    }
+
+    for (int t = 0; t < 64; t++) {
+        __m512i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+        __m512i wt;
+
+        if (t < 16) {
+            wt = w[t];
+        } else {
+            __m512i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+            __m512i s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w15, 7), _mm512_ror_epi32(w15, 18), _mm512_srli_epi32(w15, 3), 0x96);
+            __m512i s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w2, 17), _mm512_ror_epi32(w2, 19), _mm512_srli_epi32(w2, 10), 0x96);
+            wt = _mm512_add_epi32(_mm512_add_epi32(w[t & 15], s0), _mm512_add_epi32(w[(t - 7) & 15], s1));
+            w[t & 15] = wt;
+        }
+
+        __m512i big_s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96);
+        __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+        __m512i t1 = _mm512_add_epi32(_mm512_add_epi32(h, big_s1), _mm512_add_epi32(ch, _mm512_add_epi32(_mm512_set1_epi32((int)sha256_k[t]), wt)));
+        __m512i big_s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96);
+        __m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xE8);
+        __m512i t2 = _mm512_add_epi32(big_s0, maj);
+
+        v[7] = g; v[6] = f; v[5] = e; v[4] = _mm512_add_epi32(d, t1);
+        v[3] = c; v[2] = b; v[1] = a; v[0] = _mm512_add_epi32(t1, t2);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        _mm512_storeu_si512((void *)(state + i * 16), _mm512_add_epi32(s[i], v[i]));
+    }
+}
+
+#endif
+
+static sha256_transform_fn select_transform(sha256_impl_t impl) {
+#ifdef CPU_X86
+    if (impl != SHA256_IMPL_SCALAR && sha256_supported(SHA256_IMPL_SHANI)) return transform_shani;
+#else
+    (void)impl;
+#endif
+    return transform_scalar;
+}
+
+static void sha256_detect(void) {
+    if (cpu_has(CPU_FEATURE_AVX512F) && cpu_has(CPU_FEATURE_AVX2)) {
+        active_impl = SHA256_IMPL_AVX512;
+    } else if (sha256_supported(SHA256_IMPL_SHANI)) {
+        active_impl = SHA256_IMPL_SHANI;
+    } else if (cpu_has(CPU_FEATURE_AVX2)) {
+        active_impl = SHA256_IMPL_AVX2;
+    } else {
+        active_impl = SHA256_IMPL_SCALAR;
+    }
+    single_transform = select_transform(active_impl);
+}
+
+static void sha256_ensure(void) {
+    pthread_once(&sha256_once, sha256_detect);
+}
+
+int sha256_supported(sha256_impl_t impl) {
+    switch (impl) {
+        case SHA256_IMPL_AUTO:
+        case SHA256_IMPL_SCALAR:
+            return 1;
+        case SHA256_IMPL_SHANI:
+            return cpu_has(CPU_FEATURE_SHA) && cpu_has(CPU_FEATURE_SSE41) && cpu_has(CPU_FEATURE_SSSE3);
+        case SHA256_IMPL_AVX2:
+            return cpu_has(CPU_FEATURE_AVX2);
+        case SHA256_IMPL_AVX512:
+            return cpu_has(CPU_FEATURE_AVX512F) && cpu_has(CPU_FEATURE_AVX2);
+    }
+    return 0;
+}
+
+int sha256_select(sha256_impl_t impl) {
+    sha256_ensure();
+    if (impl == SHA256_IMPL_AUTO) {
+        sha256_detect();
+        return 0;
+    }
+    if (!sha256_supported(impl)) return -1;
+
+    active_impl = impl;
+    single_transform = select_transform(impl);
+    return 0;
+}
+
+sha256_impl_t sha256_active(void) {
+    sha256_ensure();
+    return active_impl;
+}
+
+const char *sha256_impl_name(sha256_impl_t impl) {
+    switch (impl) {
+        case SHA256_IMPL_AUTO:
+            return "auto";
+        case SHA256_IMPL_SCALAR:
+            return "scalar";
+        case SHA256_IMPL_SHANI:
+            return "sha-ni";
+        case SHA256_IMPL_AVX2:
+            return "avx2";
+        case SHA256_IMPL_AVX512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+void sha256_init(sha256_ctx_t *ctx) {
+    sha256_ensure();
+    memcpy(ctx->state, sha256_iv, sizeof(sha256_iv));
+    ctx->length = 0;
+    ctx->buffered = 0;
+}
+
+void sha256_tagged_init(sha256_ctx_t *ctx, const char *tag) {
+    uint8_t tag_hash[SHA256_DIGEST_SIZE];
+
+    sha256((const uint8_t *)tag, strlen(tag), tag_hash);
+    sha256_init(ctx);
+    sha256_update(ctx, tag_hash, sizeof(tag_hash));
+    sha256_update(ctx, tag_hash, sizeof(tag_hash));
+}
+
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t length) {
+    ctx->length += length;
+
+    if (ctx->buffered > 0) {
+        size_t take = SHA256_BLOCK_SIZE - ctx->buffered;
+        if (take > length) take = length;
+        memcpy(ctx->buffer + ctx->buffered, data, take);
+        ctx->buffered += take;
+        data += take;
+        length -= take;
+        if (ctx->buffered < SHA256_BLOCK_SIZE) return;
+        single_transform(ctx->state, ctx->buffer, 1);
+        ctx->buffered = 0;
+    }
+
+    if (length >= SHA256_BLOCK_SIZE) {
+        size_t blocks = length / SHA256_BLOCK_SIZE;
+        single_transform(ctx->state, data, blocks);
+        data += blocks * SHA256_BLOCK_SIZE;
+        length -= blocks * SHA256_BLOCK_SIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->buffer, data, length);
+        ctx->buffered = length;
+    }
+}
+
+void sha256_final(sha256_ctx_t *ctx, uint8_t *digest) {
+    uint64_t bits = ctx->length * 8;
+    size_t pad = ctx->buffered < 56 ? 56 - ctx->buffered : 120 - ctx->buffered;
+    uint8_t trailer[SHA256_BLOCK_SIZE + 8];
+
+    memset(trailer, 0, sizeof(trailer));
+    trailer[0] = 0x80;
+    for (int i = 0; i < 8; i++) {
+        trailer[pad + i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    sha256_update(ctx, trailer, pad + 8);
+
+    for (int i = 0; i < 8; i++) {
+        store_be32(digest + i * 4, ctx->state[i]);
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void sha256(const uint8_t *data, size_t length, uint8_t *digest) {
+    sha256_ctx_t ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, length);
+    sha256_final(&ctx, digest);
+}
+
+void sha256d(const uint8_t *data, size_t length, uint8_t *digest) {
+    uint8_t first[SHA256_DIGEST_SIZE];
+    sha256(data, length, first);
+    sha256(first, sizeof(first), digest);
+    memset(first, 0, sizeof(first));
+}
+
+void hmac_sha256_init(hmac_sha256_ctx_t *ctx, const uint8_t *key, size_t key_length) {
+    uint8_t pad[SHA256_BLOCK_SIZE];
+    uint8_t hashed[SHA256_DIGEST_SIZE];
+
+    if (key_length > SHA256_BLOCK_SIZE) {
+        sha256(key, key_length, hashed);
+        key = hashed;
+        key_length = sizeof(hashed);
+    }
+
+    memset(pad, 0x36, sizeof(pad));
+    for (size_t i = 0; i < key_length; i++) {
+        pad[i] ^= key[i];
+    }
+    sha256_init(&ctx->inner);
+    sha256_update(&ctx->inner, pad, sizeof(pad));
+
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36 ^ 0x5c;
+    }
+    sha256_init(&ctx->outer);
+    sha256_update(&ctx->outer, pad, sizeof(pad));
+
+    memset(pad, 0, sizeof(pad));
+    memset(hashed, 0, sizeof(hashed));
+}
+
+void hmac_sha256_update(hmac_sha256_ctx_t *ctx, const uint8_t *data, size_t length) {
+    sha256_update(&ctx->inner, data, length);
+}
+
+void hmac_sha256_final(hmac_sha256_ctx_t *ctx, uint8_t *mac) {
+    uint8_t inner[SHA256_DIGEST_SIZE];
+
+    sha256_final(&ctx->inner, inner);
+    sha256_update(&ctx->outer, inner, sizeof(inner));
+    sha256_final(&ctx->outer, mac);
+    memset(inner, 0, sizeof(inner));
+}
+
+void hmac_sha256(const uint8_t *key, size_t key_length, const uint8_t *data, size_t length, uint8_t *mac) {
+    hmac_sha256_ctx_t ctx;
+    hmac_sha256_init(&ctx, key, key_length);
+    hmac_sha256_update(&ctx, data, length);
+    hmac_sha256_final(&ctx, mac);
+}
+
+#ifdef CPU_X86
+static void sha256_lanes(const uint8_t *const *messages, size_t length, uint8_t *digests,
+                         size_t lanes, sha256_lanes_fn kernel) {
+    uint32_t state[8 * SHA256_MAX_LANES];
+    uint8_t tail[SHA256_MAX_LANES][2 * SHA256_BLOCK_SIZE];
+    const uint8_t *blocks[SHA256_MAX_LANES];
+    size_t full = length / SHA256_BLOCK_SIZE;
+    size_t total = (length + 8) / SHA256_BLOCK_SIZE + 1;
+    size_t remainder = length - full * SHA256_BLOCK_SIZE;
+    uint64_t bits = (uint64_t)length * 8;
+
+    for (size_t l = 0; l < lanes; l++) {
+        uint8_t *pad = tail[l];
+        memset(pad, 0, sizeof(tail[l]));
+        memcpy(pad, messages[l] + full * SHA256_BLOCK_SIZE, remainder);
+        pad[remainder] = 0x80;
+        for (int i = 0; i < 8; i++) {
+            pad[(total - full) * SHA256_BLOCK_SIZE - 8 + i] = (uint8_t)(bits >> (56 - 8 * i));
+        }
+        for (int i = 0; i < 8; i++) {
+            state[i * lanes + l] = sha256_iv[i];
+        }
+    }
+
+    for (size_t b = 0; b < total; b++) {
+        for (size_t l = 0; l < lanes; l++) {
+            blocks[l] = b < full ? messages[l] + b * SHA256_BLOCK_SIZE : tail[l] + (b - full) * SHA256_BLOCK_SIZE;
+        }
+        kernel(state, blocks);
+    }
+
+    for (size_t l = 0; l < lanes; l++) {
+        for (int i = 0; i < 8; i++) {
+            store_be32(digests + l * SHA256_DIGEST_SIZE + i * 4, state[i * lanes + l]);
+        }
+    }
+}
+
+#endif
+
+void sha256_batch(const uint8_t *const *messages, size_t length, size_t count, uint8_t *digests) {
+    sha256_ensure();
+
+#ifdef CPU_X86
+    if (active_impl == SHA256_IMPL_AVX512) {
+        while (count >= 16) {
+            sha256_lanes(messages, length, digests, 16, lanes16_avx512);
+            messages += 16;
+            digests += 16 * SHA256_DIGEST_SIZE;
+            count -= 16;
+        }
+    }
+    if (active_impl == SHA256_IMPL_AVX512 || active_impl == SHA256_IMPL_AVX2) {
+        while (count >= 8) {
+            sha256_lanes(messages, length, digests, 8, lanes8_avx2);
+            messages += 8;
+            digests += 8 * SHA256_DIGEST_SIZE;
+            count -= 8;
+        }
+    }
+#endif
+    for (size_t i = 0; i < count; i++) {
+        sha256(messages[i], length, digests + i * SHA256_DIGEST_SIZE);
+    }
+}
+
+void sha256d_batch(const uint8_t *const *messages, size_t length, size_t count, uint8_t *digests) {
+    const uint8_t *firsts[SHA256_MAX_LANES * 4];
+    uint8_t first[SHA256_MAX_LANES * 4 * SHA256_DIGEST_SIZE];
+    size_t chunk = SHA256_MAX_LANES * 4;
+
+    for (size_t base = 0; base < count; base += chunk) {
+        size_t n = count - base < chunk ? count - base : chunk;
+        sha256_batch(messages + base, length, n, first);
+        for (size_t i = 0; i < n; i++) {
+            firsts[i] = first + i * SHA256_DIGEST_SIZE;
+        }
+        sha256_batch(firsts, SHA256_DIGEST_SIZE, n, digests + base * SHA256_DIGEST_SIZE);
+    }
+    memset(first, 0, sizeof(first));
+}
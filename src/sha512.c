@@ -0,0 +1,498 @@
+#include <string.h>
+#include <pthread.h>
+#include "sha512.h"
+#include "cpu.h"
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static const uint64_t sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+static const uint64_t sha512_iv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+static pthread_once_t sha512_once = PTHREAD_ONCE_INIT;
+static sha512_impl_t active_impl = SHA512_IMPL_SCALAR;
+
+typedef void (*pbkdf2_lanes_fn)(const uint64_t *inner, const uint64_t *outer, uint64_t *u, uint64_t *t, uint32_t rounds);
+
+static uint64_t load_be64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static void store_be64(uint8_t *p, uint64_t v) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+static void sha512_transform(uint64_t *state, const uint8_t *blocks, size_t count) {
+    while (count--) {
+        uint64_t w[80];
+        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int t = 0; t < 16; t++) {
+            w[t] = load_be64(blocks + t * 8);
+        }
+        for (int t = 16; t < 80; t++) {
+            uint64_t s0 = ROTR64(w[t - 15], 1) ^ ROTR64(w[t - 15], 8) ^ (w[t - 15] >> 7);
+            uint64_t s1 = ROTR64(w[t - 2], 19) ^ ROTR64(w[t - 2], 61) ^ (w[t - 2] >> 6);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+        for (int t = 0; t < 80; t++) {
+            uint64_t t1 = h + (ROTR64(e, 14) ^ ROTR64(e, 18) ^ ROTR64(e, 41)) + ((e & f) ^ (~e & g)) + sha512_k[t] + w[t];
+            uint64_t t2 = (ROTR64(a, 28) ^ ROTR64(a, 34) ^ ROTR64(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        blocks += SHA512_BLOCK_SIZE;
+    }
+}
+
+void sha512_init(sha512_ctx_t *ctx) {
+    memcpy(ctx->state, sha512_iv, sizeof(sha512_iv));
+    ctx->length = 0;
+    ctx->buffered = 0;
+}
+
+void sha512_update(sha512_ctx_t *ctx, const uint8_t *data, size_t length) {
+    ctx->length += length;
+
+    if (ctx->buffered > 0) {
+        size_t take = SHA512_BLOCK_SIZE - ctx->buffered;
+        if (take > length) take = length;
+        memcpy(ctx->buffer + ctx->buffered, data, take);
+        ctx->buffered += take;
+        data += take;
+        length -= take;
+        if (ctx->buffered < SHA512_BLOCK_SIZE) return;
+        sha512_transform(ctx->state, ctx->buffer, 1);
+        ctx->buffered = 0;
+    }
+
+    if (length >= SHA512_BLOCK_SIZE) {
+        size_t blocks = length / SHA512_BLOCK_SIZE;
+        sha512_transform(ctx->state, data, blocks);
+        data += blocks * SHA512_BLOCK_SIZE;
+        length -= blocks * SHA512_BLOCK_SIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->buffer, data, length);
+        ctx->buffered = length;
+    }
+}
+
+void sha512_final(sha512_ctx_t *ctx, uint8_t *digest) {
+    uint64_t bits = ctx->length * 8;
+    size_t pad = ctx->buffered < 112 ? 112 - ctx->buffered : 240 - ctx->buffered;
+    uint8_t trailer[SHA512_BLOCK_SIZE + 16];
+
+    memset(trailer, 0, sizeof(trailer));
+    trailer[0] = 0x80;
+    store_be64(trailer + pad + 8, bits);
+    sha512_update(ctx, trailer, pad + 16);
+
+    for (int i = 0; i < 8; i++) {
+        store_be64(digest + i * 8, ctx->state[i]);
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void sha512(const uint8_t *data, size_t length, uint8_t *digest) {
+    sha512_ctx_t ctx;
+    sha512_init(&ctx);
+    sha512_update(&ctx, data, length);
+    sha512_final(&ctx, digest);
+}
+
+void hmac_sha512_init(hmac_sha512_ctx_t *ctx, const uint8_t *key, size_t key_length) {
+    uint8_t pad[SHA512_BLOCK_SIZE];
+    uint8_t hashed[SHA512_DIGEST_SIZE];
+
+    if (key_length > SHA512_BLOCK_SIZE) {
+        sha512(key, key_length, hashed);
+        key = hashed;
+        key_length = sizeof(hashed);
+    }
+
+    memset(pad, 0x36, sizeof(pad));
+    for (size_t i = 0; i < key_length; i++) {
+        pad[i] ^= key[i];
+    }
+    sha512_init(&ctx->inner);
+    sha512_update(&ctx->inner, pad, sizeof(pad));
+
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36 ^ 0x5c;
+    }
+    sha512_init(&ctx->outer);
+    sha512_update(&ctx->outer, pad, sizeof(pad));
+
+    memset(pad, 0, sizeof(pad));
+    memset(hashed, 0, sizeof(hashed));
+}
+
+void hmac_sha512_update(hmac_sha512_ctx_t *ctx, const uint8_t *data, size_t length) {
+    sha512_update(&ctx->inner, data, length);
+}
+
+void hmac_sha512_final(hmac_sha512_ctx_t *ctx, uint8_t *mac) {
+    uint8_t inner[SHA512_DIGEST_SIZE];
+
+    sha512_final(&ctx->inner, inner);
+    sha512_update(&ctx->outer, inner, sizeof(inner));
+    sha512_final(&ctx->outer, mac);
+    memset(inner, 0, sizeof(inner));
+}
+
+void hmac_sha512(const uint8_t *key, size_t key_length, const uint8_t *data, size_t length, uint8_t *mac) {
+    hmac_sha512_ctx_t ctx;
+    hmac_sha512_init(&ctx, key, key_length);
+    hmac_sha512_update(&ctx, data, length);
+    hmac_sha512_final(&ctx, mac);
+}
+
+#define SHA512_PAD_BITS ((SHA512_BLOCK_SIZE + SHA512_DIGEST_SIZE) * 8)
+
+#define SHA512_COMPRESS(out, in, w) \
+    do { \
+        V a = in[0], b = in[1], c = in[2], d = in[3], e = in[4], f = in[5], g = in[6], h = in[7]; \
+        _Pragma("GCC unroll 80") \
+        for (int t = 0; t < 80; t++) { \
+            if (t >= 16) { \
+                V w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15]; \
+                w[t & 15] = V_ADD(V_ADD(w[t & 15], V_XOR(V_XOR(V_ROR(w15, 1), V_ROR(w15, 8)), V_SHR(w15, 7))), \
+                                  V_ADD(w[(t - 7) & 15], V_XOR(V_XOR(V_ROR(w2, 19), V_ROR(w2, 61)), V_SHR(w2, 6)))); \
+            } \
+            V t1 = V_ADD(V_ADD(h, V_XOR(V_XOR(V_ROR(e, 14), V_ROR(e, 18)), V_ROR(e, 41))), \
+                         V_ADD(V_XOR(V_AND(e, f), V_ANDNOT(e, g)), V_ADD(V_SET1(sha512_k[t]), w[t & 15]))); \
+            V t2 = V_ADD(V_XOR(V_XOR(V_ROR(a, 28), V_ROR(a, 34)), V_ROR(a, 39)), \
+                         V_XOR(V_XOR(V_AND(a, b), V_AND(a, c)), V_AND(b, c))); \
+            h = g; g = f; f = e; e = V_ADD(d, t1); \
+            d = c; c = b; b = a; a = V_ADD(t1, t2); \
+        } \
+        out[0] = V_ADD(in[0], a); out[1] = V_ADD(in[1], b); out[2] = V_ADD(in[2], c); out[3] = V_ADD(in[3], d); \
+        out[4] = V_ADD(in[4], e); out[5] = V_ADD(in[5], f); out[6] = V_ADD(in[6], g); out[7] = V_ADD(in[7], h); \
+    } while (0)
+
+#define PBKDF2_ROUNDS(lanes) \
+    do { \
+        V istate[8], ostate[8], uw[8], tw[8], hash[8], w[16]; \
+        for (int i = 0; i < 8; i++) { \
+            istate[i] = V_LOAD(inner + i * (lanes)); \
+            ostate[i] = V_LOAD(outer + i * (lanes)); \
+            uw[i] = V_LOAD(u + i * (lanes)); \
+            tw[i] = V_LOAD(t + i * (lanes)); \
+        } \
+        for (uint32_t r = 0; r < rounds; r++) { \
+            for (int i = 0; i < 8; i++) w[i] = uw[i]; \
+            w[8] = V_SET1(0x8000000000000000ULL); \
+            for (int i = 9; i < 15; i++) w[i] = V_SET1(0); \
+            w[15] = V_SET1(SHA512_PAD_BITS); \
+            SHA512_COMPRESS(hash, istate, w); \
+            for (int i = 0; i < 8; i++) w[i] = hash[i]; \
+            w[8] = V_SET1(0x8000000000000000ULL); \
+            for (int i = 9; i < 15; i++) w[i] = V_SET1(0); \
+            w[15] = V_SET1(SHA512_PAD_BITS); \
+            SHA512_COMPRESS(uw, ostate, w); \
+            for (int i = 0; i < 8; i++) tw[i] = V_XOR(tw[i], uw[i]); \
+        } \
+        for (int i = 0; i < 8; i++) { \
+            V_STORE(u + i * (lanes), uw[i]); \
+            V_STORE(t + i * (lanes), tw[i]); \
+        } \
+    } while (0)
+
+#define V uint64_t
+#define V_ADD(a, b) ((a) + (b))
+#define V_XOR(a, b) ((a) ^ (b))
+#define V_AND(a, b) ((a) & (b))
+#define V_ANDNOT(a, b) (~(a) & (b))
+#define V_ROR(a, n) ROTR64(a, n)
+#define V_SHR(a, n) ((a) >> (n))
+#define V_SET1(k) ((uint64_t)(k))
+#define V_LOAD(p) (*(p))
+#define V_STORE(p, v) (*(p) = (v))
+
+static void pbkdf2_lanes1_scalar(const uint64_t *inner, const uint64_t *outer, uint64_t *u, uint64_t *t, uint32_t rounds) {
+    PBKDF2_ROUNDS(1);
+}
+
+#undef V
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_ANDNOT
+#undef V_ROR
+#undef V_SHR
+#undef V_SET1
+#undef V_LOAD
+#undef V_STORE
+
+#ifdef CPU_X86
+#define V __m256i
+#define V_ADD(a, b) _mm256_add_epi64(a, b)
+#define V_XOR(a, b) _mm256_xor_si256(a, b)
+#define V_AND(a, b) _mm256_and_si256(a, b)
+#define V_ANDNOT(a, b) _mm256_andnot_si256(a, b)
+#define V_ROR(a, n) _mm256_or_si256(_mm256_srli_epi64(a, n), _mm256_slli_epi64(a, 64 - (n)))
+#define V_SHR(a, n) _mm256_srli_epi64(a, n)
+#define V_SET1(k) _mm256_set1_epi64x((long long)(k))
+#define V_LOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+#define V_STORE(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+
+__attribute__((target("avx2")))
+static void pbkdf2_lanes4_avx2(const uint64_t *inner, const uint64_t *outer, uint64_t *u, uint64_t *t, uint32_t rounds) {
+    PBKDF2_ROUNDS(4);
+}
+
+#undef V
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_ANDNOT
+#undef V_ROR
+#undef V_SHR
+#undef V_SET1
+#undef V_LOAD
+#undef V_STORE
+
+#define V __m512i
+#define V_ADD(a, b) _mm512_add_epi64(a, b)
+#define V_XOR(a, b) _mm512_xor_si512(a, b)
+#define V_AND(a, b) _mm512_and_si512(a, b)
+#define V_ANDNOT(a, b) _mm512_andnot_si512(a, b)
+#define V_ROR(a, n) _mm512_ror_epi64(a, n)
+#define V_SHR(a, n) _mm512_srli_epi64(a, n)
+#define V_SET1(k) _mm512_set1_epi64((long long)(k))
+#define V_LOAD(p) _mm512_loadu_si512((const void *)(p))
+#define V_STORE(p, v) _mm512_storeu_si512((void *)(p), v)
+
+__attribute__((target("avx512f")))
+static void pbkdf2_lanes8_avx512(const uint64_t *inner, const uint64_t *outer, uint64_t *u, uint64_t *t, uint32_t rounds) {
+    PBKDF2_ROUNDS(8);
+}
+
+#undef V
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_ANDNOT
+#undef V_ROR
+#undef V_SHR
+#undef V_SET1
+#undef V_LOAD
+#undef V_STORE
+#endif
+
+static pbkdf2_lanes_fn select_kernel(size_t lanes) {
+#ifdef CPU_X86
+    if (lanes == 8) return pbkdf2_lanes8_avx512;
+    if (lanes == 4) return pbkdf2_lanes4_avx2;
+#else
+    (void)lanes;
+#endif
+    return pbkdf2_lanes1_scalar;
+}
+
+static void sha512_detect(void) {
+    if (sha512_supported(SHA512_IMPL_AVX512)) {
+        active_impl = SHA512_IMPL_AVX512;
+    } else if (sha512_supported(SHA512_IMPL_AVX2)) {
+        active_impl = SHA512_IMPL_AVX2;
+    } else {
+        active_impl = SHA512_IMPL_SCALAR;
+    }
+}
+
+static void sha512_ensure(void) {
+    pthread_once(&sha512_once, sha512_detect);
+}
+
+int sha512_supported(sha512_impl_t impl) {
+    switch (impl) {
+        case SHA512_IMPL_AUTO:
+        case SHA512_IMPL_SCALAR:
+            return 1;
+        case SHA512_IMPL_AVX2:
+            return cpu_has(CPU_FEATURE_AVX2);
+        case SHA512_IMPL_AVX512:
+            return cpu_has(CPU_FEATURE_AVX512F);
+    }
+    return 0;
+}
+
+int sha512_select(sha512_impl_t impl) {
+    sha512_ensure();
+    if (impl == SHA512_IMPL_AUTO) {
+        sha512_detect();
+        return 0;
+    }
+    if (!sha512_supported(impl)) return -1;
+
+    active_impl = impl;
+    return 0;
+}
+
+sha512_impl_t sha512_active(void) {
+    sha512_ensure();
+    return active_impl;
+}
+
+const char *sha512_impl_name(sha512_impl_t impl) {
+    switch (impl) {
+        case SHA512_IMPL_AUTO:
+            return "auto";
+        case SHA512_IMPL_SCALAR:
+            return "scalar";
+        case SHA512_IMPL_AVX2:
+            return "avx2";
+        case SHA512_IMPL_AVX512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+size_t sha512_lanes(void) {
+    switch (sha512_active()) {
+        case SHA512_IMPL_AVX512:
+            return 8;
+        case SHA512_IMPL_AVX2:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+static void pbkdf2_first_block(hmac_sha512_ctx_t *ctx, const uint8_t *salt, size_t salt_length, uint32_t block,
+                               uint8_t *u) {
+    hmac_sha512_ctx_t round = *ctx;
+    uint8_t counter[4] = { (uint8_t)(block >> 24), (uint8_t)(block >> 16), (uint8_t)(block >> 8), (uint8_t)block };
+
+    hmac_sha512_update(&round, salt, salt_length);
+    hmac_sha512_update(&round, counter, sizeof(counter));
+    hmac_sha512_final(&round, u);
+}
+
+int pbkdf2_hmac_sha512(const uint8_t *password, size_t password_length, const uint8_t *salt, size_t salt_length,
+                       uint32_t iterations, uint8_t *output, size_t output_length) {
+    if ((!password && password_length) || (!salt && salt_length) || !output || iterations == 0) return -1;
+
+    hmac_sha512_ctx_t ctx;
+    uint8_t u[SHA512_DIGEST_SIZE];
+    uint64_t uw[8], tw[8];
+
+    hmac_sha512_init(&ctx, password, password_length);
+    for (uint32_t block = 1; output_length > 0; block++) {
+        size_t take = output_length < SHA512_DIGEST_SIZE ? output_length : SHA512_DIGEST_SIZE;
+
+        pbkdf2_first_block(&ctx, salt, salt_length, block, u);
+        for (int i = 0; i < 8; i++) {
+            uw[i] = tw[i] = load_be64(u + i * 8);
+        }
+        pbkdf2_lanes1_scalar(ctx.inner.state, ctx.outer.state, uw, tw, iterations - 1);
+        for (int i = 0; i < 8; i++) {
+            store_be64(u + i * 8, tw[i]);
+        }
+
+        memcpy(output, u, take);
+        output += take;
+        output_length -= take;
+    }
+
+    memset(&ctx, 0, sizeof(ctx));
+    memset(u, 0, sizeof(u));
+    memset(uw, 0, sizeof(uw));
+    memset(tw, 0, sizeof(tw));
+    return 0;
+}
+
+int pbkdf2_hmac_sha512_batch(const uint8_t *const *passwords, const size_t *password_lengths,
+                             const uint8_t *const *salts, const size_t *salt_lengths,
+                             size_t count, uint32_t iterations, uint8_t *outputs) {
+    if (!passwords || !password_lengths || !salts || !salt_lengths || !outputs || iterations == 0) return -1;
+
+    size_t lanes = sha512_lanes();
+    pbkdf2_lanes_fn kernel = select_kernel(lanes);
+    uint64_t inner[8 * SHA512_MAX_LANES], outer[8 * SHA512_MAX_LANES];
+    uint64_t u[8 * SHA512_MAX_LANES], t[8 * SHA512_MAX_LANES];
+    hmac_sha512_ctx_t ctx;
+    uint8_t first[SHA512_DIGEST_SIZE];
+
+    for (size_t offset = 0; offset < count; offset += lanes) {
+        size_t n = count - offset < lanes ? count - offset : lanes;
+
+        if (n == 1 && lanes > 1) {
+            if (pbkdf2_hmac_sha512(passwords[offset], password_lengths[offset], salts[offset], salt_lengths[offset],
+                                   iterations, outputs + offset * SHA512_DIGEST_SIZE, SHA512_DIGEST_SIZE) != 0) {
+                return -1;
+            }
+            continue;
+        }
+
+        for (size_t l = 0; l < lanes; l++) {
+            size_t source = offset + (l < n ? l : 0);
+
+            if (!passwords[source] && password_lengths[source]) return -1;
+            if (!salts[source] && salt_lengths[source]) return -1;
+            hmac_sha512_init(&ctx, passwords[source], password_lengths[source]);
+            pbkdf2_first_block(&ctx, salts[source], salt_lengths[source], 1, first);
+            for (int i = 0; i < 8; i++) {
+                inner[i * lanes + l] = ctx.inner.state[i];
+                outer[i * lanes + l] = ctx.outer.state[i];
+                u[i * lanes + l] = t[i * lanes + l] = load_be64(first + i * 8);
+            }
+        }
+
+        kernel(inner, outer, u, t, iterations - 1);
+
+        for (size_t l = 0; l < n; l++) {
+            for (int i = 0; i < 8; i++) {
+                store_be64(outputs + (offset + l) * SHA512_DIGEST_SIZE + i * 8, t[i * lanes + l]);
+            }
+        }
+    }
+
+    memset(&ctx, 0, sizeof(ctx));
+    memset(first, 0, sizeof(first));
+    memset(inner, 0, sizeof(inner));
+    memset(outer, 0, sizeof(outer));
+    memset(u, 0, sizeof(u));
+    memset(t, 0, sizeof(t));
+    return 0;
+}
@@ -0,0 +1,362 @@
+#include <stdlib.h>
+#include <string.h>
+#include "signature.h"
+#include "ec.h"
+#include "rng.h"
+#include "scalar.h"
+#include "sha256.h"
+
+#define SCHNORR_RANDOMIZER_SIZE 16
+
+static int point_x(const ec_point_t *point, uint8_t *x, int *odd) {
+    uint8_t encoded[COMPRESSED_PUBLIC_KEY_SIZE];
+    size_t length = 0;
+
+    if (ec_point_serialize(point, encoded, &length, 1) != 0) return -1;
+    memcpy(x, encoded + 1, SCALAR_SIZE);
+    *odd = encoded[0] == 0x03;
+    return 0;
+}
+
+static void rfc6979_nonce(uint8_t *nonce, const uint8_t *key, const uint8_t *hash) {
+    uint8_t v[SHA256_DIGEST_SIZE];
+    uint8_t k[SHA256_DIGEST_SIZE];
+    hmac_sha256_ctx_t ctx;
+
+    memset(v, 0x01, sizeof(v));
+    memset(k, 0x00, sizeof(k));
+    for (uint8_t round = 0; round < 2; round++) {
+        hmac_sha256_init(&ctx, k, sizeof(k));
+        hmac_sha256_update(&ctx, v, sizeof(v));
+        hmac_sha256_update(&ctx, &round, 1);
+        hmac_sha256_update(&ctx, key, PRIVATE_KEY_SIZE);
+        hmac_sha256_update(&ctx, hash, SIGNATURE_HASH_SIZE);
+        hmac_sha256_final(&ctx, k);
+        hmac_sha256(k, sizeof(k), v, sizeof(v), v);
+    }
+
+    for (;;) {
+        hmac_sha256(k, sizeof(k), v, sizeof(v), v);
+        if (scalar_is_valid_b32(v)) break;
+
+        uint8_t zero = 0;
+        hmac_sha256_init(&ctx, k, sizeof(k));
+        hmac_sha256_update(&ctx, v, sizeof(v));
+        hmac_sha256_update(&ctx, &zero, 1);
+        hmac_sha256_final(&ctx, k);
+        hmac_sha256(k, sizeof(k), v, sizeof(v), v);
+    }
+
+    memcpy(nonce, v, SCALAR_SIZE);
+    secure_zero_memory(v, sizeof(v));
+    secure_zero_memory(k, sizeof(k));
+    secure_zero_memory(&ctx, sizeof(ctx));
+}
+
+static void tagged_hash(const sha256_ctx_t *tag, const uint8_t *a, const uint8_t *b, const uint8_t *c,
+                        uint8_t *digest) {
+    sha256_ctx_t ctx = *tag;
+
+    sha256_update(&ctx, a, SCALAR_SIZE);
+    sha256_update(&ctx, b, SCALAR_SIZE);
+    sha256_update(&ctx, c, SIGNATURE_HASH_SIZE);
+    sha256_final(&ctx, digest);
+}
+
+int ecdsa_sign_batch(const private_key_t *keys, const uint8_t *hashes, uint8_t *signatures, size_t count) {
+    uint8_t nonces[SIGNATURE_BATCH_SIZE * SCALAR_SIZE];
+    ec_point_t points[SIGNATURE_BATCH_SIZE];
+    scalar_t k[SIGNATURE_BATCH_SIZE];
+    scalar_t inverses[SIGNATURE_BATCH_SIZE];
+    uint8_t reduced[SIGNATURE_HASH_SIZE];
+    uint8_t x[SCALAR_SIZE];
+    scalar_t d, h, r, s;
+    int odd;
+    int result = 0;
+
+    if (!keys || !hashes || !signatures) return -1;
+
+    for (size_t base = 0; base < count && result == 0; base += SIGNATURE_BATCH_SIZE) {
+        size_t n = count - base < SIGNATURE_BATCH_SIZE ? count - base : SIGNATURE_BATCH_SIZE;
+
+        for (size_t i = 0; i < n; i++) {
+            if (!scalar_is_valid_b32(keys[base + i].data)) {
+                result = -1;
+                break;
+            }
+            scalar_set_b32(&h, hashes + (base + i) * SIGNATURE_HASH_SIZE);
+            scalar_get_b32(reduced, &h);
+            rfc6979_nonce(nonces + i * SCALAR_SIZE, keys[base + i].data, reduced);
+            scalar_set_b32(&k[i], nonces + i * SCALAR_SIZE);
+        }
+        if (result != 0 || ec_mult_gen_batch(points, nonces, n) != 0 || scalar_inverse_batch(inverses, k, n) != 0) {
+            result = -1;
+            break;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            uint8_t *signature = signatures + (base + i) * SIGNATURE_SIZE;
+
+            if (point_x(&points[i], x, &odd) != 0) {
+                result = -1;
+                break;
+            }
+            scalar_set_b32(&r, x);
+            scalar_set_b32(&d, keys[base + i].data);
+            scalar_set_b32(&h, hashes + (base + i) * SIGNATURE_HASH_SIZE);
+            scalar_mul(&s, &r, &d);
+            scalar_add(&s, &s, &h);
+            scalar_mul(&s, &s, &inverses[i]);
+            if (scalar_is_zero(&r) || scalar_is_zero(&s)) {
+                result = -1;
+                break;
+            }
+            if (scalar_is_high(&s)) {
+                scalar_negate(&s, &s);
+            }
+            scalar_get_b32(signature, &r);
+            scalar_get_b32(signature + SCALAR_SIZE, &s);
+        }
+    }
+
+    secure_zero_memory(nonces, sizeof(nonces));
+    secure_zero_memory(points, sizeof(points));
+    secure_zero_memory(k, sizeof(k));
+    secure_zero_memory(inverses, sizeof(inverses));
+    secure_zero_memory(&d, sizeof(d));
+    secure_zero_memory(&s, sizeof(s));
+    return result;
+}
+
+int ecdsa_sign(const private_key_t *key, const uint8_t *hash, uint8_t *signature) {
+    return ecdsa_sign_batch(key, hash, signature, 1);
+}
+
+int ecdsa_verify(const public_key_t *public_key, const uint8_t *hash, const uint8_t *signature) {
+    ec_point_t point, sum;
+    scalar_t r, s, h, w, x;
+    uint8_t u1[SCALAR_SIZE], u2[SCALAR_SIZE], bytes[SCALAR_SIZE];
+    int odd;
+
+    if (!public_key || !hash || !signature) return -1;
+    if (scalar_set_b32(&r, signature) || scalar_is_zero(&r) ||
+        scalar_set_b32(&s, signature + SCALAR_SIZE) || scalar_is_zero(&s) || scalar_is_high(&s)) {
+        return -1;
+    }
+    if (ec_point_parse(&point, public_key->data, public_key->length) != 0) return -1;
+
+    scalar_set_b32(&h, hash);
+    scalar_inverse(&w, &s);
+    scalar_mul(&h, &h, &w);
+    scalar_mul(&w, &r, &w);
+    scalar_get_b32(u1, &h);
+    scalar_get_b32(u2, &w);
+
+    if (ec_mult_multi(&sum, &point, u2, 1, u1) != 0 || point_x(&sum, bytes, &odd) != 0) return -1;
+    scalar_set_b32(&x, bytes);
+    return memcmp(x.d, r.d, sizeof(r.d)) == 0 ? 0 : -1;
+}
+
+int schnorr_public_key(const private_key_t *key, uint8_t *public_key) {
+    ec_point_t point;
+    int odd;
+
+    if (!key || !public_key || !scalar_is_valid_b32(key->data)) return -1;
+    if (ec_mult_gen(&point, key->data) != 0) return -1;
+    return point_x(&point, public_key, &odd);
+}
+
+int schnorr_sign_batch(const private_key_t *keys, const uint8_t *messages, const uint8_t *aux, uint8_t *signatures,
+                       size_t count) {
+    uint8_t scalars[SIGNATURE_BATCH_SIZE * SCALAR_SIZE];
+    uint8_t xs[SIGNATURE_BATCH_SIZE * SCALAR_SIZE];
+    ec_point_t points[SIGNATURE_BATCH_SIZE];
+    scalar_t d[SIGNATURE_BATCH_SIZE];
+    sha256_ctx_t aux_tag, nonce_tag, challenge_tag;
+    uint8_t t[SCALAR_SIZE], rx[SCALAR_SIZE];
+    scalar_t k, e;
+    int odd;
+    int result = 0;
+
+    if (!keys || !messages || !aux || !signatures) return -1;
+
+    sha256_tagged_init(&aux_tag, "BIP0340/aux");
+    sha256_tagged_init(&nonce_tag, "BIP0340/nonce");
+    sha256_tagged_init(&challenge_tag, "BIP0340/challenge");
+
+    for (size_t base = 0; base < count && result == 0; base += SIGNATURE_BATCH_SIZE) {
+        size_t n = count - base < SIGNATURE_BATCH_SIZE ? count - base : SIGNATURE_BATCH_SIZE;
+
+        for (size_t i = 0; i < n; i++) {
+            if (!scalar_is_valid_b32(keys[base + i].data)) {
+                result = -1;
+                break;
+            }
+            memcpy(scalars + i * SCALAR_SIZE, keys[base + i].data, SCALAR_SIZE);
+        }
+        if (result != 0 || ec_mult_gen_batch(points, scalars, n) != 0) {
+            result = -1;
+            break;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            const uint8_t *message = messages + (base + i) * SIGNATURE_HASH_SIZE;
+            sha256_ctx_t ctx = aux_tag;
+
+            if (point_x(&points[i], xs + i * SCALAR_SIZE, &odd) != 0) {
+                result = -1;
+                break;
+            }
+            scalar_set_b32(&d[i], keys[base + i].data);
+            if (odd) {
+                scalar_negate(&d[i], &d[i]);
+            }
+
+            sha256_update(&ctx, aux + (base + i) * SCHNORR_AUX_SIZE, SCHNORR_AUX_SIZE);
+            sha256_final(&ctx, t);
+            scalar_get_b32(rx, &d[i]);
+            for (size_t j = 0; j < SCALAR_SIZE; j++) {
+                t[j] ^= rx[j];
+            }
+            tagged_hash(&nonce_tag, t, xs + i * SCALAR_SIZE, message, scalars + i * SCALAR_SIZE);
+            scalar_set_b32(&k, scalars + i * SCALAR_SIZE);
+            if (scalar_is_zero(&k)) {
+                result = -1;
+                break;
+            }
+            scalar_get_b32(scalars + i * SCALAR_SIZE, &k);
+        }
+        if (result != 0 || ec_mult_gen_batch(points, scalars, n) != 0) {
+            result = -1;
+            break;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            const uint8_t *message = messages + (base + i) * SIGNATURE_HASH_SIZE;
+            uint8_t *signature = signatures + (base + i) * SIGNATURE_SIZE;
+            uint8_t digest[SHA256_DIGEST_SIZE];
+
+            if (point_x(&points[i], rx, &odd) != 0) {
+                result = -1;
+                break;
+            }
+            scalar_set_b32(&k, scalars + i * SCALAR_SIZE);
+            if (odd) {
+                scalar_negate(&k, &k);
+            }
+            tagged_hash(&challenge_tag, rx, xs + i * SCALAR_SIZE, message, digest);
+            scalar_set_b32(&e, digest);
+            scalar_mul(&e, &e, &d[i]);
+            scalar_add(&k, &k, &e);
+            memcpy(signature, rx, SCALAR_SIZE);
+            scalar_get_b32(signature + SCALAR_SIZE, &k);
+        }
+    }
+
+    secure_zero_memory(scalars, sizeof(scalars));
+    secure_zero_memory(points, sizeof(points));
+    secure_zero_memory(d, sizeof(d));
+    secure_zero_memory(t, sizeof(t));
+    secure_zero_memory(rx, sizeof(rx));
+    secure_zero_memory(&k, sizeof(k));
+    secure_zero_memory(&e, sizeof(e));
+    return result;
+}
+
+int schnorr_sign(const private_key_t *key, const uint8_t *message, const uint8_t *aux, uint8_t *signature) {
+    return schnorr_sign_batch(key, message, aux, signature, 1);
+}
+
+int schnorr_verify(const uint8_t *public_key, const uint8_t *message, const uint8_t *signature) {
+    ec_point_t point, sum;
+    sha256_ctx_t challenge_tag;
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    uint8_t x[SCALAR_SIZE];
+    scalar_t s, e;
+    int odd;
+
+    if (!public_key || !message || !signature) return -1;
+    if (scalar_set_b32(&s, signature + SCALAR_SIZE) != 0) return -1;
+    if (ec_point_parse(&point, public_key, SCHNORR_PUBLIC_KEY_SIZE) != 0) return -1;
+
+    sha256_tagged_init(&challenge_tag, "BIP0340/challenge");
+    tagged_hash(&challenge_tag, signature, public_key, message, digest);
+    scalar_set_b32(&e, digest);
+    scalar_negate(&e, &e);
+    scalar_get_b32(digest, &e);
+
+    if (ec_mult_multi(&sum, &point, digest, 1, signature + SCALAR_SIZE) != 0) return -1;
+    if (point_x(&sum, x, &odd) != 0 || odd) return -1;
+    return memcmp(x, signature, SCALAR_SIZE) == 0 ? 0 : -1;
+}
+
+int schnorr_verify_batch(const uint8_t *public_keys, const uint8_t *messages, const uint8_t *signatures, size_t count) {
+    ec_point_t *points;
+    uint8_t *scalars;
+    uint8_t *randomizers;
+    sha256_ctx_t challenge_tag;
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    scalar_t sum, a, s, e;
+    ec_point_t total;
+    int result = 0;
+
+    if (!public_keys || !messages || !signatures) return -1;
+    if (count <= 1) {
+        return count == 0 ? 0 : schnorr_verify(public_keys, messages, signatures);
+    }
+
+    points = malloc(2 * count * sizeof(ec_point_t));
+    scalars = malloc(2 * count * SCALAR_SIZE);
+    randomizers = malloc(count * SCHNORR_RANDOMIZER_SIZE);
+    if (!points || !scalars || !randomizers || rng_bytes(randomizers, count * SCHNORR_RANDOMIZER_SIZE) != 0) {
+        free(points);
+        free(scalars);
+        free(randomizers);
+        return -1;
+    }
+
+    sha256_tagged_init(&challenge_tag, "BIP0340/challenge");
+    memset(&sum, 0, sizeof(sum));
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *public_key = public_keys + i * SCHNORR_PUBLIC_KEY_SIZE;
+        const uint8_t *signature = signatures + i * SIGNATURE_SIZE;
+        uint8_t *a_bytes = scalars + i * SCALAR_SIZE;
+
+        if (scalar_set_b32(&s, signature + SCALAR_SIZE) != 0 ||
+            ec_point_parse(&points[i], signature, SCALAR_SIZE) != 0 ||
+            ec_point_parse(&points[count + i], public_key, SCHNORR_PUBLIC_KEY_SIZE) != 0) {
+            result = -1;
+            break;
+        }
+
+        memset(a_bytes, 0, SCALAR_SIZE);
+        if (i == 0) {
+            a_bytes[SCALAR_SIZE - 1] = 1;
+        } else {
+            memcpy(a_bytes + SCALAR_SIZE - SCHNORR_RANDOMIZER_SIZE, randomizers + i * SCHNORR_RANDOMIZER_SIZE,
+                   SCHNORR_RANDOMIZER_SIZE);
+        }
+        scalar_set_b32(&a, a_bytes);
+
+        tagged_hash(&challenge_tag, signature, public_key, messages + i * SIGNATURE_HASH_SIZE, digest);
+        scalar_set_b32(&e, digest);
+        scalar_mul(&e, &e, &a);
+        scalar_get_b32(scalars + (count + i) * SCALAR_SIZE, &e);
+
+        scalar_mul(&s, &s, &a);
+        scalar_add(&sum, &sum, &s);
+    }
+
+    if (result == 0) {
+        scalar_negate(&sum, &sum);
+        scalar_get_b32(digest, &sum);
+        if (ec_mult_multi(&total, points, scalars, 2 * count, digest) != 0 || !total.infinity) {
+            result = -1;
+        }
+    }
+
+    free(points);
+    free(scalars);
+    free(randomizers);
+    return result;
+}
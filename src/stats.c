@@ -0,0 +1,277 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "stats.h"
+
+int stats_enabled = 0;
+
+static __thread stats_thread_t *stats_local = NULL;
+static stats_thread_t *stats_threads[STATS_MAX_THREADS];
+static size_t stats_thread_count = 0;
+static stats_thread_t stats_overflow;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t progress_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t progress_wake = PTHREAD_COND_INITIALIZER;
+static pthread_t progress_thread;
+static int progress_running = 0;
+static int progress_stop = 0;
+static uint64_t stats_expected = 0;
+static uint64_t stats_started = 0;
+static uint64_t stats_stopped = 0;
+static int perf_fds[2] = {-1, -1};
+
+static const char *const stage_names[STATS_STAGE_COUNT] = {
+    "rng", "derive", "hash", "encode", "write"
+};
+
+uint64_t stats_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static stats_thread_t *stats_thread(void) {
+    if (stats_local) return stats_local;
+
+    stats_thread_t *local = aligned_alloc(64, (sizeof(stats_thread_t) + 63) & ~(size_t)63);
+    pthread_mutex_lock(&stats_lock);
+    if (local && stats_thread_count < STATS_MAX_THREADS) {
+        memset(local, 0, sizeof(*local));
+        stats_threads[stats_thread_count++] = local;
+    } else {
+        free(local);
+        local = &stats_overflow;
+    }
+    pthread_mutex_unlock(&stats_lock);
+
+    stats_local = local;
+    return local;
+}
+
+static void counter_add(uint64_t *counter, uint64_t value) {
+    if (stats_local == &stats_overflow) {
+        __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+    } else {
+        __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+    }
+}
+
+static unsigned int histogram_bucket(uint64_t ns) {
+    unsigned int bucket = ns ? 64 - (unsigned int)__builtin_clzll(ns) : 0;
+    return bucket < STATS_HISTOGRAM_BUCKETS ? bucket : STATS_HISTOGRAM_BUCKETS - 1;
+}
+
+void stats_record(stats_stage_t stage, uint64_t start) {
+    uint64_t elapsed = stats_clock() - start;
+    stats_thread_t *local = stats_thread();
+
+    counter_add(&local->stage_ns[stage], elapsed);
+    counter_add(&local->stage_batches[stage], 1);
+    counter_add(&local->histogram[stage][histogram_bucket(elapsed)], 1);
+}
+
+void stats_add(stats_counter_t counter, uint64_t value) {
+    counter_add(&stats_thread()->counters[counter], value);
+}
+
+static void stats_sum(stats_thread_t *total) {
+    size_t count = __atomic_load_n(&stats_thread_count, __ATOMIC_ACQUIRE);
+    const uint64_t *sources[STATS_MAX_THREADS + 1];
+    uint64_t *target = (uint64_t *)total;
+    size_t words = sizeof(stats_thread_t) / sizeof(uint64_t);
+
+    memset(total, 0, sizeof(*total));
+    for (size_t t = 0; t < count; t++) {
+        sources[t] = (const uint64_t *)stats_threads[t];
+    }
+    sources[count++] = (const uint64_t *)&stats_overflow;
+
+    for (size_t t = 0; t < count; t++) {
+        for (size_t w = 0; w < words; w++) {
+            target[w] += __atomic_load_n(&sources[t][w], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int perf_open(uint64_t config) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+static int perf_read(int fd, uint64_t *value) {
+    return fd >= 0 && read(fd, value, sizeof(*value)) == (ssize_t)sizeof(*value) ? 0 : -1;
+}
+
+static void print_progress(const stats_thread_t *total, uint64_t now, const stats_thread_t *last, uint64_t last_time) {
+    double elapsed = (double)(now - stats_started) / 1e9;
+    double interval = (double)(now - last_time) / 1e9;
+    uint64_t keys = total->counters[STATS_COUNTER_KEYS];
+    double rate = interval > 0 ? (double)(keys - last->counters[STATS_COUNTER_KEYS]) / interval : 0;
+    double bytes = interval > 0 ? (double)(total->counters[STATS_COUNTER_BYTES] - last->counters[STATS_COUNTER_BYTES]) / interval : 0;
+
+    if (stats_expected > 0) {
+        double remaining = rate > 0 && keys < stats_expected ? (double)(stats_expected - keys) / rate : 0;
+        fprintf(stderr, "[%7.1fs] %llu/%llu keys (%.1f%%), %.0f keys/s, %.1f MB/s, eta %.0fs\n",
+                elapsed, (unsigned long long)keys, (unsigned long long)stats_expected,
+                100.0 * (double)keys / (double)stats_expected, rate, bytes / 1e6, remaining);
+    } else {
+        fprintf(stderr, "[%7.1fs] %llu keys, %.0f keys/s, %.1f MB/s\n",
+                elapsed, (unsigned long long)keys, rate, bytes / 1e6);
+    }
+}
+
+static void *progress_main(void *arg) {
+    stats_thread_t *last = calloc(1, sizeof(stats_thread_t));
+    stats_thread_t *total = calloc(1, sizeof(stats_thread_t));
+    uint64_t last_time = stats_started;
+    struct timespec deadline;
+
+    (void)arg;
+    if (!last || !total) {
+        free(last);
+        free(total);
+        return NULL;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    pthread_mutex_lock(&progress_lock);
+    while (!progress_stop) {
+        deadline.tv_nsec += (long)STATS_PROGRESS_INTERVAL_MS * 1000000L;
+        while (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_nsec -= 1000000000L;
+            deadline.tv_sec++;
+        }
+        if (pthread_cond_timedwait(&progress_wake, &progress_lock, &deadline) != ETIMEDOUT) continue;
+
+        uint64_t now = stats_clock();
+        stats_sum(total);
+        print_progress(total, now, last, last_time);
+        memcpy(last, total, sizeof(*total));
+        last_time = now;
+    }
+    pthread_mutex_unlock(&progress_lock);
+
+    free(last);
+    free(total);
+    return NULL;
+}
+
+int stats_start(int progress, uint64_t expected) {
+    stats_expected = expected;
+    stats_started = stats_clock();
+    stats_stopped = 0;
+    perf_fds[0] = perf_open(PERF_COUNT_HW_CPU_CYCLES);
+    perf_fds[1] = perf_open(PERF_COUNT_HW_INSTRUCTIONS);
+    for (int i = 0; i < 2; i++) {
+        if (perf_fds[i] >= 0) {
+            ioctl(perf_fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    __atomic_store_n(&stats_enabled, 1, __ATOMIC_RELEASE);
+
+    if (progress) {
+        progress_stop = 0;
+        if (pthread_create(&progress_thread, NULL, progress_main, NULL) != 0) return -1;
+        progress_running = 1;
+    }
+    return 0;
+}
+
+void stats_stop(void) {
+    if (stats_stopped) return;
+
+    stats_stopped = stats_clock();
+    for (int i = 0; i < 2; i++) {
+        if (perf_fds[i] >= 0) {
+            ioctl(perf_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    if (progress_running) {
+        pthread_mutex_lock(&progress_lock);
+        progress_stop = 1;
+        pthread_cond_signal(&progress_wake);
+        pthread_mutex_unlock(&progress_lock);
+        pthread_join(progress_thread, NULL);
+        progress_running = 0;
+    }
+    __atomic_store_n(&stats_enabled, 0, __ATOMIC_RELEASE);
+}
+
+void stats_report(FILE *stream, int interrupted) {
+    stats_thread_t *total = calloc(1, sizeof(stats_thread_t));
+    uint64_t cycles = 0, instructions = 0;
+    int have_cycles, have_instructions;
+
+    if (!total) return;
+    stats_stop();
+    stats_sum(total);
+
+    double elapsed = (double)(stats_stopped - stats_started) / 1e9;
+    uint64_t keys = total->counters[STATS_COUNTER_KEYS];
+
+    fprintf(stream, "{\n  \"interrupted\": %s,\n  \"elapsed_s\": %.3f,\n  \"keys\": %llu,\n  \"keys_per_sec\": %.0f,\n"
+            "  \"rejected_scalars\": %llu,\n  \"bytes_written\": %llu,\n",
+            interrupted ? "true" : "false", elapsed, (unsigned long long)keys,
+            elapsed > 0 ? (double)keys / elapsed : 0.0,
+            (unsigned long long)total->counters[STATS_COUNTER_REJECTED],
+            (unsigned long long)total->counters[STATS_COUNTER_BYTES]);
+
+    have_cycles = perf_read(perf_fds[0], &cycles) == 0;
+    have_instructions = perf_read(perf_fds[1], &instructions) == 0;
+    if (have_cycles) {
+        fprintf(stream, "  \"cycles\": %llu,\n", (unsigned long long)cycles);
+    } else {
+        fprintf(stream, "  \"cycles\": null,\n");
+    }
+    if (have_instructions) {
+        fprintf(stream, "  \"instructions\": %llu,\n", (unsigned long long)instructions);
+    } else {
+        fprintf(stream, "  \"instructions\": null,\n");
+    }
+    if (have_cycles && have_instructions && keys > 0 && cycles > 0) {
+        fprintf(stream, "  \"cycles_per_key\": %.1f,\n  \"ipc\": %.2f,\n",
+                (double)cycles / (double)keys, (double)instructions / (double)cycles);
+    }
+
+    fprintf(stream, "  \"stages\": [\n");
+    for (int s = 0; s < STATS_STAGE_COUNT; s++) {
+        uint64_t batches = total->stage_batches[s];
+        int first = 1;
+
+        fprintf(stream, "    {\"stage\": \"%s\", \"batches\": %llu, \"total_ms\": %.3f, \"mean_us\": %.3f, \"histogram_ns\": [",
+                stage_names[s], (unsigned long long)batches, (double)total->stage_ns[s] / 1e6,
+                batches ? (double)total->stage_ns[s] / (double)batches / 1e3 : 0.0);
+        for (int b = 0; b < STATS_HISTOGRAM_BUCKETS; b++) {
+            if (total->histogram[s][b] == 0) continue;
+            fprintf(stream, "%s{\"below\": %llu, \"count\": %llu}", first ? "" : ", ",
+                    (unsigned long long)(1ULL << b), (unsigned long long)total->histogram[s][b]);
+            first = 0;
+        }
+        fprintf(stream, "]}%s\n", s + 1 < STATS_STAGE_COUNT ? "," : "");
+    }
+    fprintf(stream, "  ]\n}\n");
+
+    for (int i = 0; i < 2; i++) {
+        if (perf_fds[i] >= 0) {
+            close(perf_fds[i]);
+            perf_fds[i] = -1;
+        }
+    }
+    free(total);
+}
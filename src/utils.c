@@ -4,12 +4,90 @@
 #include <ctype.h>
 #include "utils.h"
 #include "address.h"
+#include "cpu.h"
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
 
 // this way, we get a random number between 0 and limit -1
 int get_random_number(int limit) {
     return rand() % limit;
 }
 
+static const int8_t hex_values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+static int hex_decode_scalar(const char *hex, size_t hex_len, uint8_t *bytes) {
+    int invalid = 0;
+
+    for (size_t i = 0; i < hex_len; i += 2) {
+        int hi = hex_values[(unsigned char)hex[i]];
+        int lo = hex_values[(unsigned char)hex[i + 1]];
+        invalid |= hi | lo;
+        bytes[i / 2] = (uint8_t)((hi << 4) | (lo & 0x0F));
+    }
+
+    return invalid < 0 ? -1 : 0;
+}
+
+#ifdef CPU_X86
+__attribute__((target("avx2")))
+static int hex_decode_avx2(const char *hex, size_t hex_len, uint8_t *bytes) {
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i lower_a = _mm256_set1_epi8('a');
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i five = _mm256_set1_epi8(5);
+    const __m256i ten = _mm256_set1_epi8(10);
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+
+    for (; i + 32 <= hex_len; i += 32) {
+        __m256i c = _mm256_loadu_si256((const __m256i *)(hex + i));
+        __m256i digit = _mm256_sub_epi8(c, zero);
+        __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, case_bit), lower_a);
+        __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, nine), digit);
+        __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, five), alpha);
+
+        if ((uint32_t)_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) != 0xFFFFFFFFu) return -1;
+
+        __m256i value = _mm256_blendv_epi8(_mm256_add_epi8(alpha, ten), digit, is_digit);
+        __m256i pairs = _mm256_maddubs_epi16(value, weights);
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(pairs, pairs), 0x08);
+        _mm_storeu_si128((__m128i *)(bytes + i / 2), _mm256_castsi256_si128(packed));
+    }
+
+    return hex_decode_scalar(hex + i, hex_len - i, bytes + i / 2);
+}
+#endif
+
+int hex_decode(const char *hex, size_t hex_len, uint8_t *bytes) {
+    if (!hex || !bytes || hex_len % 2 != 0) return -1;
+
+#ifdef CPU_X86
+    if (hex_len >= 32 && cpu_has(CPU_FEATURE_AVX2)) {
+        return hex_decode_avx2(hex, hex_len, bytes);
+    }
+#endif
+    return hex_decode_scalar(hex, hex_len, bytes);
+}
+
 int hex_to_bytes(const char *hex, uint8_t *bytes, size_t bytes_size) {
     if (!hex || !bytes || bytes_size == 0) return -1;
     
@@ -19,17 +97,18 @@ int hex_to_bytes(const char *hex, uint8_t *bytes, size_t bytes_size) {
     size_t bytes_len = hex_len / 2;
     if (bytes_len > bytes_size) return -1;
     
-    for (size_t i = 0; i < hex_len; i += 2) {
-        char hex_byte[3] = {hex[i], hex[i + 1], '\0'};
-        char *endptr;
-        unsigned long value = strtoul(hex_byte, &endptr, 16);
-        
-        if (*endptr != '\0') return -1;
-        
-        bytes[i / 2] = (uint8_t)value;
+    return hex_decode(hex, hex_len, bytes);
+}
+
+size_t encode_hex(const uint8_t *bytes, size_t bytes_size, char *hex) {
+    static const char hex_digits[] = "0123456789abcdef";
+    
+    for (size_t i = 0; i < bytes_size; i++) {
+        hex[i * 2] = hex_digits[bytes[i] >> 4];
+        hex[i * 2 + 1] = hex_digits[bytes[i] & 0x0F];
     }
     
-    return 0;
+    return bytes_size * 2;
 }
 
 int bytes_to_hex(const uint8_t *bytes, size_t bytes_size, char *hex, size_t hex_size) {
@@ -39,10 +118,7 @@ int bytes_to_hex(const uint8_t *bytes, size_t bytes_size, char *hex, size_t hex_
         return -1;
     }
     
-    for (size_t i = 0; i < bytes_size; i++) {
-        snprintf(hex + i * 2, 3, "%02x", bytes[i]);
-    }
-    
+    encode_hex(bytes, bytes_size, hex);
     hex[bytes_size * 2] = '\0';
     return 0;
 }